@@ -1,6 +1,8 @@
 #ifndef LOOT_SHIM_H
 #define LOOT_SHIM_H
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -24,10 +26,21 @@ typedef enum {
 // ---------------------------------------------------------
 typedef struct LootGameHandle LootGameHandle;
 
+// List of heap-allocated C strings owned by Rust. Release with
+// loot_free_string_list().
+typedef struct {
+    char** items;
+    size_t count;
+} LootStringList;
+
 // ---------------------------------------------------------
 // Shim API exposed to C/C++
 // ---------------------------------------------------------
 
+// libloot's version, as "major.minor.patch". The string is static: don't free
+// it.
+const char* loot_get_version(void);
+
 LootGameHandle* loot_create_game_handle(
     LootGameType game,
     const char* data_path,
@@ -37,20 +50,65 @@ LootGameHandle* loot_create_game_handle(
 void loot_destroy_game_handle(LootGameHandle* handle);
 
 int loot_sort_plugins(LootGameHandle* handle);
+
+// Sorts the given plugin paths (already discovered by the caller) instead of
+// scanning the data directory. Their order is used as the current load order.
+int loot_sort_plugin_paths(LootGameHandle* handle,
+                           const char* const* plugin_paths,
+                           size_t count);
+
+// Returns the order produced by the last successful sort.
+LootStringList loot_get_sorted_plugins(const LootGameHandle* handle);
+
+void loot_free_string_list(LootStringList list);
+
 int loot_load_masterlist(LootGameHandle* handle,
                         const char* masterlist_path,
                         const char* prelude_path);
 
 int loot_load_userlist(LootGameHandle* handle, const char* userlist_path);
 
+// Persists plugin CRCs to the given file, reading back any already stored.
+int loot_set_crc_cache_path(LootGameHandle* handle, const char* cache_path);
+
+// Calculates the CRCs of the given plugins in the background and returns
+// immediately.
+int loot_prewarm_crc_cache(const LootGameHandle* handle,
+                           const char* const* plugin_paths,
+                           size_t count);
+
 int loot_clear_user_metadata(LootGameHandle* handle);
 
 char* loot_get_plugin_details_json(LootGameHandle* handle, const char* plugin_name);
 
 char* loot_get_general_messages_json(LootGameHandle* handle);
 
+// Timings and graph counts from the last successful sort, as a JSON object
+// with totalMicros, phases, nodes, edges, pathQueries and pathSearches.
+// Returns NULL if there are none. Release with loot_free_json().
+char* loot_get_sort_statistics_json(const LootGameHandle* handle);
+
 void loot_free_json(char* json);
 
+// libloot log levels, as passed to and from the logging callback.
+typedef enum {
+    LootLogLevel_Trace   = 0,
+    LootLogLevel_Debug   = 1,
+    LootLogLevel_Info    = 2,
+    LootLogLevel_Warning = 3,
+    LootLogLevel_Error   = 4
+} LootLogLevel;
+
+// Receives libloot's log messages, possibly from several threads at once.
+// message is only valid for the duration of the call.
+typedef void (*LootLoggingCallback)(int level, const char* message, void* user_data);
+
+// Forwards libloot's log messages at min_level or above to callback. Pass
+// NULL to discard them again.
+void loot_set_logging_callback(LootLoggingCallback callback,
+                               void* user_data,
+                               int min_level);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,13 +1,17 @@
 use std::{
+    collections::{HashMap, HashSet},
     ffi::{CStr, CString},
     fmt::Write as FmtWrite,
-    os::raw::{c_char, c_int},
+    os::raw::{c_char, c_int, c_void},
     path::{Path, PathBuf},
     ptr,
+    sync::{Arc, OnceLock},
+    time::SystemTime,
 };
 
 use libloot::{
-    EvalMode, Game, GameType, MergeMode,
+    EvalMode, Game, GameType, LogLevel, MergeMode, Plugin, SortParallelism, SortPhase,
+    SortStatistics,
     metadata::{
         File, Message, MessageContent, MessageType, PluginCleaningData, PluginMetadata, Tag,
         select_message_content,
@@ -58,6 +62,28 @@ pub struct LootGameHandle {
     data_path: PathBuf,
     /// Last sorted plugin order (UTF-8 plugin names).
     sorted_plugins: Vec<String>,
+    /// Timings and counts from the last successful sort.
+    sort_statistics: Option<SortStatistics>,
+    /// Plugins whose headers are currently loaded into `game`, with the file
+    /// stamp they were loaded at. Lets repeat sorts skip unchanged plugins.
+    loaded_headers: HashMap<PathBuf, FileStamp>,
+}
+
+/// Size and modification time of a plugin file when its header was loaded.
+#[derive(Clone, Copy, PartialEq, Eq)]
+struct FileStamp {
+    size: u64,
+    modified: Option<SystemTime>,
+}
+
+impl FileStamp {
+    fn of(path: &Path) -> Option<FileStamp> {
+        let metadata = std::fs::metadata(path).ok()?;
+        Some(FileStamp {
+            size: metadata.len(),
+            modified: metadata.modified().ok(),
+        })
+    }
 }
 
 /// Simple list-of-strings type that matches the C header.
@@ -84,6 +110,16 @@ unsafe fn cstr_to_string(ptr: *const c_char) -> String {
     CStr::from_ptr(ptr).to_string_lossy().into_owned()
 }
 
+/// libloot's version, as "major.minor.patch". The string is static, so the
+/// caller must not free it.
+#[no_mangle]
+pub extern "C" fn loot_get_version() -> *const c_char {
+    static VERSION: OnceLock<CString> = OnceLock::new();
+    VERSION
+        .get_or_init(|| CString::new(libloot::libloot_version()).unwrap_or_default())
+        .as_ptr()
+}
+
 /// Create a new LOOT game handle.
 ///
 /// `game`         – which game we're working with (SkyrimSE, etc.)
@@ -135,6 +171,8 @@ pub extern "C" fn loot_create_game_handle(
         game: loot_game,
         data_path: PathBuf::from(if data.is_empty() { install } else { data }),
         sorted_plugins: Vec::new(),
+        sort_statistics: None,
+        loaded_headers: HashMap::new(),
     };
 
     Box::into_raw(Box::new(handle))
@@ -171,16 +209,15 @@ pub extern "C" fn loot_sort_plugins(handle: *mut LootGameHandle) -> c_int {
     let handle = unsafe { &mut *handle };
 
     handle.sorted_plugins.clear();
+    handle.sort_statistics = None;
 
-    // 1. Discover plugins under the Reliquary virtual Data folder.
-    let data_path = &handle.data_path;
-    let read_dir = match std::fs::read_dir(data_path) {
+    // Discover plugins under the Reliquary virtual Data folder.
+    let read_dir = match std::fs::read_dir(&handle.data_path) {
         Ok(rd) => rd,
         Err(_) => return -2,
     };
 
     let mut plugin_paths: Vec<PathBuf> = Vec::new();
-    let mut plugin_names: Vec<String> = Vec::new();
 
     for entry in read_dir.flatten() {
         let path = entry.path();
@@ -192,35 +229,174 @@ pub extern "C" fn loot_sort_plugins(handle: *mut LootGameHandle) -> c_int {
             let lower = name.to_ascii_lowercase();
             if lower.ends_with(".esm") || lower.ends_with(".esp") || lower.ends_with(".esl") {
                 plugin_paths.push(path.clone());
-                plugin_names.push(name.to_string());
             }
         }
     }
 
+    sort_plugin_paths(handle, plugin_paths)
+}
+
+/// Sort an explicit list of plugin paths that the caller has already
+/// discovered, and cache the resulting order on the handle. The given order is
+/// used as LOOT's "current" load order. Read the result back with
+/// `loot_get_sorted_plugins`.
+///
+/// Return codes (negative = error, 0 = success):
+///   0  – success
+///  -1  – null handle
+///  -2  – null path array with a non-zero count
+///  -3  – failed to load plugin headers
+///  -4  – LOOT sorting failed
+#[no_mangle]
+pub extern "C" fn loot_sort_plugin_paths(
+    handle: *mut LootGameHandle,
+    plugin_paths: *const *const c_char,
+    count: usize,
+) -> c_int {
+    if handle.is_null() {
+        return -1;
+    }
+
+    // Safety: caller must give us a valid handle created by `loot_create_game_handle`.
+    let handle = unsafe { &mut *handle };
+
+    handle.sorted_plugins.clear();
+    handle.sort_statistics = None;
+
+    if count == 0 {
+        return 0;
+    }
+
+    if plugin_paths.is_null() {
+        return -2;
+    }
+
+    // Safety: caller guarantees `plugin_paths` points to `count` C strings.
+    let raw_paths = unsafe { std::slice::from_raw_parts(plugin_paths, count) };
+    let paths: Vec<PathBuf> = raw_paths
+        .iter()
+        .map(|&p| PathBuf::from(unsafe { cstr_to_string(p) }))
+        .filter(|p| !p.as_os_str().is_empty())
+        .collect();
+
+    sort_plugin_paths(handle, paths)
+}
+
+fn sort_plugin_paths(handle: &mut LootGameHandle, plugin_paths: Vec<PathBuf>) -> c_int {
+    let plugin_names: Vec<String> = plugin_paths
+        .iter()
+        .filter_map(|p| p.file_name().and_then(|n| n.to_str()))
+        .map(|n| n.to_string())
+        .collect();
+
     if plugin_paths.is_empty() {
         // Nothing to sort – treat as success.
         return 0;
     }
 
-    // 2. Ask libloot to load just the plugin headers – enough for dependency / metadata sorting.
-    let path_refs: Vec<&Path> = plugin_paths.iter().map(|p| p.as_path()).collect();
-
-    if let Err(_) = handle.game.load_plugin_headers(&path_refs) {
+    if sync_loaded_headers(handle, &plugin_paths).is_err() {
+        // Start from scratch next time rather than trust a half-updated set.
+        handle.game.clear_loaded_plugins();
+        handle.loaded_headers.clear();
         return -3;
     }
 
-    // 3. Feed LOOT our "current" load order (the order we discovered on disk).
+    // Feed LOOT our "current" load order (the order we were given).
     let name_refs: Vec<&str> = plugin_names.iter().map(|s| s.as_str()).collect();
 
-    match handle.game.sort_plugins(&name_refs) {
-        Ok(sorted) => {
+    match handle
+        .game
+        .sort_plugins_with_statistics(&name_refs, SortParallelism::default())
+    {
+        Ok((sorted, statistics)) => {
             handle.sorted_plugins = sorted;
+            handle.sort_statistics = Some(statistics);
             0
         }
         Err(_) => -4,
     }
 }
 
+/// Bring the headers loaded into libloot in line with `plugin_paths`: drop
+/// plugins that are no longer present, and load only those that are new or
+/// whose size/mtime changed since they were last loaded.
+fn sync_loaded_headers(handle: &mut LootGameHandle, plugin_paths: &[PathBuf]) -> Result<(), ()> {
+    let wanted: HashSet<&PathBuf> = plugin_paths.iter().collect();
+
+    let removed: Vec<PathBuf> = handle
+        .loaded_headers
+        .keys()
+        .filter(|p| !wanted.contains(p))
+        .cloned()
+        .collect();
+
+    if !removed.is_empty() {
+        let removed_names: Vec<&str> = removed
+            .iter()
+            .filter_map(|p| p.file_name().and_then(|n| n.to_str()))
+            .collect();
+        handle.game.unload_plugins(&removed_names).map_err(|_| ())?;
+        for path in &removed {
+            handle.loaded_headers.remove(path);
+        }
+    }
+
+    let mut stale: Vec<(&Path, Option<FileStamp>)> = Vec::new();
+    for path in plugin_paths {
+        let stamp = FileStamp::of(path);
+        let unchanged = stamp.is_some() && handle.loaded_headers.get(path) == stamp.as_ref();
+        if !unchanged {
+            stale.push((path.as_path(), stamp));
+        }
+    }
+
+    if stale.is_empty() {
+        return Ok(());
+    }
+
+    // Ask libloot to load just the plugin headers – enough for dependency / metadata sorting.
+    let stale_paths: Vec<&Path> = stale.iter().map(|(p, _)| *p).collect();
+    let previous: Vec<Option<Arc<Plugin>>> = stale_paths
+        .iter()
+        .map(|p| loaded_plugin(&handle.game, p))
+        .collect();
+    handle.game.load_plugin_headers(&stale_paths).map_err(|_| ())?;
+
+    record_loaded_headers(handle, stale, previous);
+
+    Ok(())
+}
+
+fn loaded_plugin(game: &Game, path: &Path) -> Option<Arc<Plugin>> {
+    game.plugin(path.file_name()?.to_str()?)
+}
+
+/// Remember the stamps of the stale plugins that libloot has just loaded.
+/// libloot logs and skips a plugin it fails to read, keeping any copy it
+/// loaded before, so only a new copy counts. Plugins that weren't loaded are
+/// forgotten and retried on the next sort.
+fn record_loaded_headers(
+    handle: &mut LootGameHandle,
+    stale: Vec<(&Path, Option<FileStamp>)>,
+    previous: Vec<Option<Arc<Plugin>>>,
+) {
+    for ((path, stamp), previous) in stale.into_iter().zip(previous) {
+        let reloaded = loaded_plugin(&handle.game, path).is_some_and(|plugin| {
+            previous
+                .as_ref()
+                .map_or(true, |old| !Arc::ptr_eq(old, &plugin))
+        });
+        match stamp {
+            Some(stamp) if reloaded => {
+                handle.loaded_headers.insert(path.to_path_buf(), stamp);
+            }
+            _ => {
+                handle.loaded_headers.remove(path);
+            }
+        }
+    }
+}
+
 /// Convert the cached Rust `Vec<String>` of sorted plugin names into a C-friendly
 /// `LootStringList { char** items, size_t count }`.
 ///
@@ -656,19 +832,20 @@ pub extern "C" fn loot_load_masterlist(
         Err(_) => return -3,
     };
 
-    let result = if prelude_path.is_null() {
-        database.load_masterlist(Path::new(&masterlist))
+    let prelude = if prelude_path.is_null() {
+        String::new()
     } else {
-        let prelude = unsafe { cstr_to_string(prelude_path) };
-        if prelude.is_empty() {
-            database.load_masterlist(Path::new(&masterlist))
-        } else {
-            database.load_masterlist_with_prelude(
-                Path::new(&masterlist),
-                Path::new(&prelude),
-            )
-        }
+        unsafe { cstr_to_string(prelude_path) }
     };
+    let prelude = if prelude.is_empty() {
+        None
+    } else {
+        Some(Path::new(&prelude))
+    };
+
+    // Goes through the binary snapshot stored next to the masterlist so that
+    // an unchanged masterlist doesn't need its YAML parsed again.
+    let result = database.load_masterlist_snapshot(Path::new(&masterlist), prelude);
 
     match result {
         Ok(_) => 0,
@@ -703,6 +880,69 @@ pub extern "C" fn loot_load_userlist(
     }
 }
 
+/// Persist the CRCs that libloot calculates for plugins to `cache_path`, and
+/// read back any CRCs already stored there. Unchanged plugins then don't need
+/// their content hashed again when conditions check their checksums.
+///
+/// Return codes: 0 – success, -1 – null handle, -2 – empty path.
+#[no_mangle]
+pub extern "C" fn loot_set_crc_cache_path(
+    handle: *mut LootGameHandle,
+    cache_path: *const c_char,
+) -> c_int {
+    if handle.is_null() {
+        return -1;
+    }
+
+    let handle = unsafe { &mut *handle };
+    let cache_path = unsafe { cstr_to_string(cache_path) };
+    if cache_path.is_empty() {
+        return -2;
+    }
+
+    handle.game.set_crc_cache_path(Path::new(&cache_path));
+    0
+}
+
+/// Start calculating the CRCs of the given plugins on libloot's background
+/// thread pool. Returns immediately; the CRCs are written to the cache file
+/// set with `loot_set_crc_cache_path` once they are all calculated.
+///
+/// Return codes: 0 – success, -1 – null handle, -2 – null path array with a
+/// non-zero count.
+#[no_mangle]
+pub extern "C" fn loot_prewarm_crc_cache(
+    handle: *const LootGameHandle,
+    plugin_paths: *const *const c_char,
+    count: usize,
+) -> c_int {
+    if handle.is_null() {
+        return -1;
+    }
+
+    if count == 0 {
+        return 0;
+    }
+
+    if plugin_paths.is_null() {
+        return -2;
+    }
+
+    let handle = unsafe { &*handle };
+
+    // Safety: caller guarantees `plugin_paths` points to `count` C strings.
+    let raw_paths = unsafe { std::slice::from_raw_parts(plugin_paths, count) };
+    let paths: Vec<PathBuf> = raw_paths
+        .iter()
+        .map(|&p| PathBuf::from(unsafe { cstr_to_string(p) }))
+        .filter(|p| !p.as_os_str().is_empty())
+        .collect();
+    let path_refs: Vec<&Path> = paths.iter().map(PathBuf::as_path).collect();
+
+    handle.game.prewarm_crc_cache(&path_refs);
+    0
+}
+
 #[no_mangle]
 pub extern "C" fn loot_clear_user_metadata(handle: *mut LootGameHandle) -> c_int {
     if handle.is_null() {
@@ -792,6 +1032,175 @@ pub extern "C" fn loot_get_general_messages_json(handle: *mut LootGameHandle) ->
     json_string_to_c(message_entries_to_json(&entries))
 }
 
+fn sort_phase_name(phase: SortPhase) -> &'static str {
+    match phase {
+        SortPhase::SpecificEdges => "Specific edges",
+        SortPhase::GroupEdges => "Group edges",
+        SortPhase::OverlapEdges => "Overlap edges",
+        SortPhase::TieBreakEdges => "Tie-break edges",
+        SortPhase::CycleChecks => "Cycle checks",
+        SortPhase::TopologicalSort => "Topological sort",
+        _ => "Other",
+    }
+}
+
+fn append_count_entries(
+    json: &mut String,
+    key: &str,
+    label_key: &str,
+    value_key: &str,
+    items: impl Iterator<Item = (String, u128)>,
+    first: &mut bool,
+) {
+    append_field_prefix(json, first);
+    json.push('"');
+    json.push_str(key);
+    json.push_str("\":[");
+    for (index, (label, value)) in items.enumerate() {
+        if index > 0 {
+            json.push(',');
+        }
+        let _ = write!(
+            json,
+            "{{\"{}\":\"{}\",\"{}\":{}}}",
+            label_key,
+            escape_json(&label),
+            value_key,
+            value
+        );
+    }
+    json.push(']');
+}
+
+fn sort_statistics_to_json(statistics: &SortStatistics) -> String {
+    let mut json = String::from("{");
+    let mut first = true;
+
+    append_field_prefix(&mut json, &mut first);
+    let _ = write!(
+        json,
+        "\"totalMicros\":{}",
+        statistics.total_duration().as_micros()
+    );
+    append_count_entries(
+        &mut json,
+        "phases",
+        "name",
+        "micros",
+        statistics
+            .phase_durations()
+            .map(|(phase, duration)| (sort_phase_name(phase).to_string(), duration.as_micros())),
+        &mut first,
+    );
+    append_field_prefix(&mut json, &mut first);
+    let _ = write!(json, "\"nodes\":{}", statistics.node_count());
+    append_count_entries(
+        &mut json,
+        "edges",
+        "type",
+        "count",
+        statistics
+            .edge_counts()
+            .map(|(edge_type, count)| (edge_type.to_string(), count as u128)),
+        &mut first,
+    );
+    append_field_prefix(&mut json, &mut first);
+    let _ = write!(
+        json,
+        "\"pathQueries\":{},\"pathSearches\":{}",
+        statistics.path_query_count(),
+        statistics.path_search_count()
+    );
+
+    json.push('}');
+    json
+}
+
+/// Timings and graph counts from the last successful sort as JSON, or null if
+/// the last sort failed or had no plugins to sort.
+/// Release the result with `loot_free_json`.
+#[no_mangle]
+pub extern "C" fn loot_get_sort_statistics_json(handle: *const LootGameHandle) -> *mut c_char {
+    if handle.is_null() {
+        return ptr::null_mut();
+    }
+
+    let handle = unsafe { &*handle };
+    match handle.sort_statistics.as_ref() {
+        Some(statistics) => json_string_to_c(sort_statistics_to_json(statistics)),
+        None => ptr::null_mut(),
+    }
+}
+
+/// C callback for libloot's log messages. `level` is 0 (trace) to 4 (error)
+/// and `message` is only valid for the duration of the call.
+pub type LootLoggingCallback =
+    Option<extern "C" fn(level: c_int, message: *const c_char, user_data: *mut c_void)>;
+
+/// The callback and its context pointer, which the caller promises can be
+/// used from any thread.
+struct LoggingTarget {
+    callback: extern "C" fn(c_int, *const c_char, *mut c_void),
+    user_data: *mut c_void,
+}
+
+unsafe impl Send for LoggingTarget {}
+unsafe impl Sync for LoggingTarget {}
+
+impl LoggingTarget {
+    // Closures capture the fields they use separately, and the raw pointer
+    // field alone isn't Send or Sync. Calling through &self captures the
+    // whole target instead.
+    fn log(&self, level: LogLevel, message: &str) {
+        // Interior NULs would truncate the message on the C side anyway.
+        let message = CString::new(message.replace('\0', " ")).unwrap_or_default();
+        (self.callback)(log_level_to_c(level), message.as_ptr(), self.user_data);
+    }
+}
+
+fn log_level_to_c(level: LogLevel) -> c_int {
+    match level {
+        LogLevel::Trace => 0,
+        LogLevel::Debug => 1,
+        LogLevel::Info => 2,
+        LogLevel::Warning => 3,
+        LogLevel::Error => 4,
+    }
+}
+
+fn log_level_from_c(level: c_int) -> LogLevel {
+    match level {
+        i32::MIN..=0 => LogLevel::Trace,
+        1 => LogLevel::Debug,
+        2 => LogLevel::Info,
+        3 => LogLevel::Warning,
+        _ => LogLevel::Error,
+    }
+}
+
+/// Forward libloot's log messages at `min_level` or above to `callback`,
+/// which may be called from any thread. Passing a null callback discards
+/// libloot's logging again.
+#[no_mangle]
+pub extern "C" fn loot_set_logging_callback(
+    callback: LootLoggingCallback,
+    user_data: *mut c_void,
+    min_level: c_int,
+) {
+    let Some(callback) = callback else {
+        libloot::set_logging_callback(|_, _| {});
+        libloot::set_log_level(LogLevel::Error);
+        return;
+    };
+
+    let target = LoggingTarget {
+        callback,
+        user_data,
+    };
+    libloot::set_log_level(log_level_from_c(min_level));
+    libloot::set_logging_callback(move |level, message| target.log(level, message));
+}
+
 #[no_mangle]
 pub extern "C" fn loot_free_json(json: *mut c_char) {
     if json.is_null() {
@@ -802,3 +1211,111 @@ pub extern "C" fn loot_free_json(json: *mut c_char) {
         let _ = CString::from_raw(json);
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// An Oblivion plugin with just a TES4 header record.
+    const BLANK_PLUGIN: &[u8] = &[
+        b'T', b'E', b'S', b'4', 18, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, b'H', b'E', b'D',
+        b'R', 12, 0, 0x66, 0x66, 0x66, 0x3f, 0, 0, 0, 0, 0, 0, 0, 0,
+    ];
+
+    /// A folder of its own for each test, used as both the game and data path.
+    struct TestGame {
+        root: PathBuf,
+        handle: *mut LootGameHandle,
+    }
+
+    impl TestGame {
+        fn new(test_name: &str) -> TestGame {
+            let root = std::env::temp_dir().join(format!(
+                "loot-shim-{}-{}",
+                std::process::id(),
+                test_name
+            ));
+            let _ = std::fs::remove_dir_all(&root);
+            std::fs::create_dir_all(&root).unwrap();
+
+            let path = CString::new(root.to_str().unwrap()).unwrap();
+            let handle =
+                loot_create_game_handle(LootGameType::Oblivion, path.as_ptr(), path.as_ptr());
+            assert!(!handle.is_null());
+
+            TestGame { root, handle }
+        }
+
+        fn handle(&mut self) -> &mut LootGameHandle {
+            unsafe { &mut *self.handle }
+        }
+    }
+
+    impl Drop for TestGame {
+        fn drop(&mut self) {
+            loot_destroy_game_handle(self.handle);
+            let _ = std::fs::remove_dir_all(&self.root);
+        }
+    }
+
+    /// Overwrite the file's content without changing its size or mtime.
+    fn overwrite_in_place(path: &Path, content: &[u8]) {
+        let modified = std::fs::metadata(path).unwrap().modified().unwrap();
+        std::fs::write(path, content).unwrap();
+        std::fs::File::options()
+            .write(true)
+            .open(path)
+            .unwrap()
+            .set_modified(modified)
+            .unwrap();
+    }
+
+    #[test]
+    fn sort_should_pick_up_a_corrupt_plugin_that_is_fixed_without_an_mtime_change() {
+        let mut game = TestGame::new("corrupt-plugin-fixed");
+        let path = game.root.join("Blank.esp");
+        std::fs::write(&path, vec![b'x'; BLANK_PLUGIN.len()]).unwrap();
+        let stamp = FileStamp::of(&path);
+
+        assert_ne!(0, sort_plugin_paths(game.handle(), vec![path.clone()]));
+        assert!(!game.handle().loaded_headers.contains_key(&path));
+
+        overwrite_in_place(&path, BLANK_PLUGIN);
+        assert!(stamp == FileStamp::of(&path));
+
+        assert_eq!(0, sort_plugin_paths(game.handle(), vec![path.clone()]));
+        assert_eq!(vec!["Blank.esp"], game.handle().sorted_plugins);
+        assert!(game.handle().loaded_headers.get(&path) == stamp.as_ref());
+    }
+
+    #[test]
+    fn record_loaded_headers_should_not_keep_the_stamp_of_a_plugin_that_libloot_skipped() {
+        let mut game = TestGame::new("skipped-plugin");
+        let path = game.root.join("Blank.esp");
+        std::fs::write(&path, BLANK_PLUGIN).unwrap();
+        let stamp = FileStamp::of(&path);
+
+        // As if load_plugin_headers() had failed to read the plugin.
+        record_loaded_headers(game.handle(), vec![(path.as_path(), stamp)], vec![None]);
+        assert!(game.handle().loaded_headers.is_empty());
+
+        assert_eq!(0, sort_plugin_paths(game.handle(), vec![path.clone()]));
+        assert!(game.handle().loaded_headers.get(&path) == stamp.as_ref());
+    }
+
+    #[test]
+    fn record_loaded_headers_should_not_keep_the_stamp_of_a_plugin_that_was_not_reloaded() {
+        let mut game = TestGame::new("plugin-not-reloaded");
+        let path = game.root.join("Blank.esp");
+        std::fs::write(&path, BLANK_PLUGIN).unwrap();
+        let stamp = FileStamp::of(&path);
+
+        assert_eq!(0, sort_plugin_paths(game.handle(), vec![path.clone()]));
+        let previous = loaded_plugin(&game.handle().game, &path);
+        assert!(previous.is_some());
+
+        // As if a reload had failed and libloot had kept the earlier copy.
+        record_loaded_headers(game.handle(), vec![(path.as_path(), stamp)], vec![previous]);
+        assert!(!game.handle().loaded_headers.contains_key(&path));
+    }
+}
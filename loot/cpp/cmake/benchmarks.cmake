@@ -0,0 +1,48 @@
+##############################
+# General Settings
+##############################
+
+set(LIBLOOT_SRC_BENCHMARKS_CPP_FILES
+    "${PROJECT_SOURCE_DIR}/src/tests/benchmarks/merge_metadata_benchmark.cpp"
+    "${PROJECT_SOURCE_DIR}/src/tests/benchmarks/sort_plugins_benchmark.cpp")
+
+source_group(TREE "${PROJECT_SOURCE_DIR}/src/tests/benchmarks"
+    PREFIX "Source Files"
+    FILES ${LIBLOOT_SRC_BENCHMARKS_CPP_FILES})
+
+##############################
+# Define Targets
+##############################
+
+# Benchmarks are plain executables that print their timings, so that they don't
+# need any dependencies beyond libloot itself. Build them in release mode.
+# Each source file is its own benchmark, named after the file.
+foreach(BENCHMARK_SOURCE ${LIBLOOT_SRC_BENCHMARKS_CPP_FILES})
+    get_filename_component(BENCHMARK_NAME ${BENCHMARK_SOURCE} NAME_WE)
+    set(BENCHMARK_TARGET "libloot_${BENCHMARK_NAME}")
+
+    add_executable(${BENCHMARK_TARGET} ${BENCHMARK_SOURCE})
+    target_link_libraries(${BENCHMARK_TARGET} PRIVATE loot)
+
+    ##############################
+    # Set Target-Specific Flags
+    ##############################
+
+    target_include_directories(${BENCHMARK_TARGET} PRIVATE
+        ${LIBLOOT_INCLUDE_DIRS})
+
+    set_target_properties(${BENCHMARK_TARGET} PROPERTIES
+        CXX_STANDARD 17
+        CXX_STANDARD_REQUIRED ON)
+
+    if(WIN32)
+        target_compile_definitions(${BENCHMARK_TARGET} PRIVATE
+            UNICODE _UNICODE)
+
+        if((NOT CMAKE_HOST_SYSTEM_NAME STREQUAL "Windows") OR NOT LIBLOOT_BUILD_SHARED)
+            target_compile_definitions(${BENCHMARK_TARGET} PRIVATE LOOT_STATIC)
+        endif()
+
+        target_link_libraries(${BENCHMARK_TARGET} PRIVATE ${LOOT_LIBS})
+    endif()
+endforeach()
@@ -25,6 +25,7 @@
 #define LOOT_DATABASE_INTERFACE
 
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -34,6 +35,7 @@
 #include "loot/metadata/group.h"
 #include "loot/metadata/message.h"
 #include "loot/metadata/plugin_metadata.h"
+#include "loot/metadata/plugin_metadata_view.h"
 
 namespace loot {
 /** @brief The interface provided by API's database handle. */
@@ -73,6 +75,32 @@ public:
       const std::filesystem::path& masterlistPath,
       const std::filesystem::path& masterlistPreludePath) = 0;
 
+  /**
+   * @brief Loads the masterlist and optional masterlist prelude from the paths
+   *        specified, using a binary snapshot of the parsed metadata when
+   *        possible.
+   * @details The snapshot is stored alongside the masterlist, with
+   *          `.snapshot` appended to its filename. If the snapshot was created
+   *          by this version of libloot from the same masterlist and prelude
+   *          content, it is loaded instead of parsing the masterlist.
+   *          Otherwise the masterlist is parsed and the snapshot is rewritten.
+   *          Failing to write the snapshot is not an error.
+   *
+   *          Can be called multiple times, each time replacing the
+   *          previously-loaded data.
+   * @param masterlistPath
+   *        The relative or absolute path to the masterlist file that should be
+   *        loaded.
+   * @param masterlistPreludePath
+   *        The relative or absolute path to the masterlist prelude file that
+   *        should be loaded, or an empty path if no prelude should be used.
+   * @returns True if the metadata was loaded from the snapshot, false if the
+   *          masterlist was parsed.
+   */
+  virtual bool LoadMasterlistSnapshot(
+      const std::filesystem::path& masterlistPath,
+      const std::filesystem::path& masterlistPreludePath = "") = 0;
+
   /**
    * @brief Loads the userlist from the path specified.
    * @details Can be called multiple times, each time replacing the
@@ -211,6 +239,55 @@ public:
       bool includeUserMetadata = true,
       bool evaluateConditions = false) const = 0;
 
+  /**
+   * @brief Get a read-only view of all loaded metadata for the given plugin.
+   * @details Unlike GetPluginMetadata(), this does not copy the metadata out
+   *          of the database up front, so it is much cheaper when only part of
+   *          the metadata is needed. Call PluginMetadataView::ToOwned() to get
+   *          a PluginMetadata object.
+   * @param plugin
+   *        The filename of the plugin to look up metadata for.
+   * @param includeUserMetadata
+   *        If true, any user metadata the plugin has is included in the
+   *        returned metadata, otherwise the metadata returned only includes
+   *        metadata from the masterlist.
+   * @param evaluateConditions
+   *        If true, any metadata conditions are evaluated before the metadata
+   *        is returned, otherwise unevaluated metadata is returned. Evaluating
+   *        plugin metadata conditions does not clear the condition cache.
+   * @returns A view of the plugin's metadata if it has any, otherwise a null
+   *          pointer.
+   */
+  virtual std::unique_ptr<const PluginMetadataView> GetPluginMetadataView(
+      std::string_view plugin,
+      bool includeUserMetadata = true,
+      bool evaluateConditions = false) const = 0;
+
+  /**
+   * @brief Get all loaded metadata for each of the given plugins.
+   * @details This is equivalent to calling GetPluginMetadata() for each
+   *          plugin, but takes the database lock once for the whole batch and
+   *          evaluates conditions in parallel, so it is much faster when
+   *          looking up metadata for a whole load order.
+   * @param plugins
+   *        The filenames of the plugins to look up metadata for.
+   * @param includeUserMetadata
+   *        If true, any user metadata the plugins have is included in the
+   *        returned metadata, otherwise the metadata returned only includes
+   *        metadata from the masterlist.
+   * @param evaluateConditions
+   *        If true, any metadata conditions are evaluated before the metadata
+   *        is returned, otherwise unevaluated metadata is returned. Evaluating
+   *        plugin metadata conditions does not clear the condition cache.
+   * @returns A vector with one element per given plugin, in the same order.
+   *          Each element is an optional containing the plugin's metadata if
+   *          it has any, otherwise an optional containing no value.
+   */
+  virtual std::vector<std::optional<PluginMetadata>> GetPluginsMetadata(
+      const std::vector<std::string>& plugins,
+      bool includeUserMetadata = true,
+      bool evaluateConditions = false) const = 0;
+
   /**
    * @brief Get a plugin's metadata loaded from the given userlist.
    * @param plugin
@@ -0,0 +1,57 @@
+/*  LOOT
+
+A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+Fallout: New Vegas.
+
+Copyright (C) 2012-2016    WrinklyNinja
+
+This file is part of LOOT.
+
+LOOT is free software: you can redistribute
+it and/or modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+LOOT is distributed in the hope that it will
+be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LOOT.  If not, see
+<https://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOOT_SORT_PHASE
+#define LOOT_SORT_PHASE
+
+/**
+ * The namespace used by libloot.
+ */
+namespace loot {
+/**
+ * @brief The phases of sorting a graph of plugins.
+ */
+enum struct SortPhase : unsigned int {
+  /**
+   * Adding edges for masters, requirements, load after metadata and
+   * early-loading plugins.
+   */
+  specificEdges,
+  /** Adding edges for plugin groups. */
+  groupEdges,
+  /** Adding edges between plugins with overlapping records or assets. */
+  overlapEdges,
+  /** Adding edges to make the sorted load order unique. */
+  tieBreakEdges,
+  /**
+   * Checking the graph for cycles, which is done before and after the edges
+   * that avoid cycles are added.
+   */
+  cycleChecks,
+  /** Topologically sorting the graph. */
+  topologicalSort,
+};
+}
+
+#endif
@@ -27,6 +27,8 @@
 #include "loot/database_interface.h"
 #include "loot/enum/game_type.h"
 #include "loot/plugin_interface.h"
+#include "loot/record_overlaps.h"
+#include "loot/sort_statistics.h"
 
 namespace loot {
 /** @brief The interface provided for accessing game-specific functionality. */
@@ -124,6 +126,36 @@ public:
       const std::vector<std::filesystem::path>& pluginPaths,
       bool loadHeadersOnly) = 0;
 
+  /**
+   * @brief Set the file that plugin CRCs are persisted to.
+   * @details Any CRCs cached in the file are read, replacing the CRCs that
+   *          this object has already cached. Fully loading plugins then only
+   *          reads the content of plugins that have changed size or
+   *          modification time since their CRCs were cached, and writes any
+   *          new CRCs back to the file. If the file does not exist or cannot
+   *          be read, it is ignored.
+   * @param cachePath
+   *        The path of the cache file. Its parent directory must exist for
+   *        the cache to be written.
+   */
+  virtual void SetCrcCachePath(const std::filesystem::path& cachePath) = 0;
+
+  /**
+   * @brief Calculate and cache the CRCs of the given plugins in the
+   *        background.
+   * @details This returns immediately. The CRCs are calculated in parallel on
+   *          a background thread, skipping plugins that already have
+   *          up-to-date cached CRCs, so that a later call to `LoadPlugins()`
+   *          does not need to calculate them. Errors are logged but otherwise
+   *          ignored.
+   * @param pluginPaths
+   *        The plugin paths to calculate CRCs for. Relative paths are resolved
+   *        relative to the game's plugins directory, while absolute paths are
+   *        used as given.
+   */
+  virtual void PrewarmCrcCache(
+      const std::vector<std::filesystem::path>& pluginPaths) = 0;
+
   /**
    * @brief Clears the plugins loaded by previous calls to `LoadPlugins()`.
    * @details This invalidates any PluginInterface pointers retrieved using
@@ -155,6 +187,20 @@ public:
   virtual std::vector<std::shared_ptr<const PluginInterface>> GetLoadedPlugins()
       const = 0;
 
+  /**
+   * @brief Find every pair of loaded plugins that contain records with the
+   *        same IDs.
+   * @details This gives the same result as calling
+   *          `PluginInterface::DoRecordsOverlap()` for every pair of loaded
+   *          plugins, but checks all the pairs in one call and in parallel,
+   *          so it is much faster for building a conflict view of a large
+   *          load order. Plugins that have only had their headers loaded do
+   *          not overlap with any other plugins.
+   * @returns The overlapping pairs of plugins, and the number of other
+   *          plugins that each loaded plugin overlaps with.
+   */
+  virtual RecordOverlaps GetRecordOverlapPairs() const = 0;
+
   /**
    *  @}
    *  @name Sorting
@@ -177,6 +223,51 @@ public:
   virtual std::vector<std::string> SortPlugins(
       const std::vector<std::string>& pluginFilenames) = 0;
 
+  /**
+   *  @brief Calculates a new load order for the game's installed plugins
+   *         (including inactive plugins) and outputs the sorted order,
+   *         controlling whether or not sorting uses multiple threads.
+   *  @details This behaves like `SortPlugins(pluginFilenames)`, which sorts
+   *           in parallel. Masters, non-masters and blueprint masters are
+   *           sorted independently of each other, so they can be sorted
+   *           concurrently. The sorted order is the same either way.
+   *  @param pluginFilenames
+   *         The plugins to sort, in their current load order. All given plugins
+   *         must have been loaded using `LoadPlugins()`.
+   *  @param sortInParallel
+   *         If true, masters, non-masters and blueprint masters are sorted in
+   *         parallel, otherwise all plugins are sorted on the calling thread.
+   *  @returns A vector of the given plugin filenames in their sorted load
+   *           order.
+   */
+  virtual std::vector<std::string> SortPlugins(
+      const std::vector<std::string>& pluginFilenames,
+      bool sortInParallel) = 0;
+
+  /**
+   *  @brief Calculates a new load order for the game's installed plugins
+   *         (including inactive plugins) and outputs the sorted order, along
+   *         with timings and counts for the phases of the sort.
+   *  @details This behaves like `SortPlugins(pluginFilenames,
+   *           sortInParallel)`, and can be used to find out where the time
+   *           goes when a sort is slow.
+   *  @param pluginFilenames
+   *         The plugins to sort, in their current load order. All given plugins
+   *         must have been loaded using `LoadPlugins()`.
+   *  @param sortInParallel
+   *         If true, masters, non-masters and blueprint masters are sorted in
+   *         parallel, otherwise all plugins are sorted on the calling thread.
+   *  @param statistics
+   *         Set to the statistics collected while sorting. It is left
+   *         unchanged if sorting fails.
+   *  @returns A vector of the given plugin filenames in their sorted load
+   *           order.
+   */
+  virtual std::vector<std::string> SortPlugins(
+      const std::vector<std::string>& pluginFilenames,
+      bool sortInParallel,
+      SortStatistics& statistics) = 0;
+
   /**
    *  @}
    *  @name Load Order Interaction
@@ -24,6 +24,8 @@
 #ifndef LOOT_METADATA_FILENAME
 #define LOOT_METADATA_FILENAME
 
+#include <cstddef>
+#include <functional>
 #include <string>
 #include <string_view>
 
@@ -38,7 +40,7 @@ public:
   /**
    * Construct a Filename using an empty string.
    */
-  LOOT_API Filename() = default;
+  LOOT_API Filename();
 
   /**
    * Construct a Filename using the given string.
@@ -52,10 +54,16 @@ public:
 
 private:
   std::string filename_;
+  // A hash of the case-folded filename, computed once so that lookups and
+  // inequality checks don't need to fold the string again.
+  std::size_t foldedHash_;
+  bool isAscii_;
 
   LOOT_API friend bool operator==(const Filename& lhs, const Filename& rhs);
 
   LOOT_API friend bool operator<(const Filename& lhs, const Filename& rhs);
+
+  friend struct std::hash<Filename>;
 };
 
 /**
@@ -104,4 +112,18 @@ LOOT_API bool operator<=(const Filename& lhs, const Filename& rhs);
 LOOT_API bool operator>=(const Filename& lhs, const Filename& rhs);
 }
 
+namespace std {
+/**
+ * A hash function for Filename objects that is consistent with their
+ * case-insensitive equality, so that they can be used as keys in unordered
+ * containers.
+ */
+template<>
+struct hash<loot::Filename> {
+  size_t operator()(const loot::Filename& filename) const noexcept {
+    return filename.foldedHash_;
+  }
+};
+}
+
 #endif
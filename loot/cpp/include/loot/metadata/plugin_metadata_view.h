@@ -0,0 +1,146 @@
+/*  LOOT
+
+    A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+    Fallout: New Vegas.
+
+    Copyright (C) 2012-2016    WrinklyNinja
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+#ifndef LOOT_METADATA_PLUGIN_METADATA_VIEW
+#define LOOT_METADATA_PLUGIN_METADATA_VIEW
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "loot/metadata/file.h"
+#include "loot/metadata/location.h"
+#include "loot/metadata/message.h"
+#include "loot/metadata/plugin_cleaning_data.h"
+#include "loot/metadata/plugin_metadata.h"
+#include "loot/metadata/tag.h"
+
+namespace loot {
+/**
+ * A read-only view of a plugin's metadata that borrows its data from the
+ * database instead of copying it.
+ *
+ * Strings returned by a view remain valid for as long as the view exists.
+ * Vectors of metadata objects are only built the first time they are
+ * requested, so a caller that only needs a plugin's group or the names of the
+ * plugins it loads after does not pay to copy its messages, tags or cleaning
+ * data. A view is safe to read from multiple threads at once.
+ */
+class PluginMetadataView {
+public:
+  virtual ~PluginMetadataView() = default;
+
+  /**
+   * Get the plugin name.
+   * @return The plugin name.
+   */
+  virtual std::string_view GetName() const = 0;
+
+  /**
+   * Get the plugin's group.
+   * @return An optional containing the name of the group this plugin belongs to
+   *         if it was explicitly set, otherwise an optional containing no
+   *         value.
+   */
+  virtual std::optional<std::string_view> GetGroup() const = 0;
+
+  /**
+   * Get the filenames of the plugins that the plugin must load after.
+   * @details Unlike GetLoadAfterFiles(), this does not copy any of the
+   *          files' other data.
+   * @return The filenames of the plugins that the plugin must load after.
+   */
+  virtual std::vector<std::string_view> GetLoadAfterFileNames() const = 0;
+
+  /**
+   * Get the plugins that the plugin must load after.
+   * @return The plugins that the plugin must load after.
+   */
+  virtual const std::vector<File>& GetLoadAfterFiles() const = 0;
+
+  /**
+   * Get the files that the plugin requires to be installed.
+   * @return The files that the plugin requires to be installed.
+   */
+  virtual const std::vector<File>& GetRequirements() const = 0;
+
+  /**
+   * Get the files that the plugin is incompatible with.
+   * @return The files that the plugin is incompatible with.
+   */
+  virtual const std::vector<File>& GetIncompatibilities() const = 0;
+
+  /**
+   * Get the plugin's messages.
+   * @return The plugin's messages.
+   */
+  virtual const std::vector<Message>& GetMessages() const = 0;
+
+  /**
+   * Get the plugin's Bash Tag suggestions.
+   * @return The plugin's Bash Tag suggestions.
+   */
+  virtual const std::vector<Tag>& GetTags() const = 0;
+
+  /**
+   * Get the plugin's dirty plugin information.
+   * @return The PluginCleaningData objects that identify the plugin as dirty.
+   */
+  virtual const std::vector<PluginCleaningData>& GetDirtyInfo() const = 0;
+
+  /**
+   * Get the plugin's clean plugin information.
+   * @return The PluginCleaningData objects that identify the plugin as clean.
+   */
+  virtual const std::vector<PluginCleaningData>& GetCleanInfo() const = 0;
+
+  /**
+   * Get the locations at which this plugin can be found.
+   * @return The locations at which this plugin can be found.
+   */
+  virtual const std::vector<Location>& GetLocations() const = 0;
+
+  /**
+   * Check if no plugin metadata is set.
+   * @return True if the group is implicit and the metadata containers are all
+   *         empty, false otherwise.
+   */
+  virtual bool HasNameOnly() const = 0;
+
+  /**
+   * Check if the plugin name is a regular expression.
+   * @return True if the plugin name contains any of the characters `:\*?|`,
+   *         false otherwise.
+   */
+  virtual bool IsRegexPlugin() const = 0;
+
+  /**
+   * Copy the viewed metadata into a PluginMetadata object that does not
+   * depend on the view.
+   * @return A PluginMetadata object holding the same metadata as the view.
+   */
+  virtual PluginMetadata ToOwned() const = 0;
+};
+}
+
+#endif
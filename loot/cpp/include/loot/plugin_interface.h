@@ -85,7 +85,9 @@ public:
   /**
    * Get the plugin's CRC-32 checksum.
    * @return An optional containing the plugin's CRC-32 checksum if the plugin
-   *         has been fully loaded, otherwise an optional containing no value.
+   *         has been fully loaded or its CRC was cached by
+   *         `GameInterface::PrewarmCrcCache()` or an earlier load, otherwise
+   *         an optional containing no value.
    */
   virtual std::optional<uint32_t> GetCRC() const = 0;
 
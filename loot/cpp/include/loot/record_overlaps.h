@@ -0,0 +1,87 @@
+/*  LOOT
+
+    A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+    Fallout: New Vegas.
+
+    Copyright (C) 2018    WrinklyNinja
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+#ifndef LOOT_RECORD_OVERLAPS
+#define LOOT_RECORD_OVERLAPS
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "loot/api_decorator.h"
+
+namespace loot {
+/**
+ * @brief A class holding every pair of loaded plugins that contain records
+ *        with the same IDs.
+ */
+class RecordOverlaps {
+public:
+  /**
+   * @brief Construct a RecordOverlaps object with no plugins.
+   */
+  LOOT_API RecordOverlaps() = default;
+
+  /**
+   * @brief Construct a RecordOverlaps object with the given data.
+   * @param plugins The names of the plugins that were checked.
+   * @param pairs The pairs of overlapping plugins, as indices into
+   *              `plugins`.
+   * @param overlapCounts The number of other plugins that each plugin
+   *                      overlaps with, in the same order as `plugins`.
+   */
+  LOOT_API explicit RecordOverlaps(
+      std::vector<std::string> plugins,
+      std::vector<std::pair<size_t, size_t>> pairs,
+      std::vector<size_t> overlapCounts);
+
+  /**
+   * @brief Get the names of the plugins that were checked.
+   * @return The plugin names, in ascending order.
+   */
+  LOOT_API const std::vector<std::string>& GetPlugins() const;
+
+  /**
+   * @brief Get the pairs of plugins that overlap.
+   * @details Each pair is only listed once, as indices into the vector
+   *          returned by GetPlugins(), with the lower index first. The pairs
+   *          are sorted.
+   * @return The pairs of overlapping plugins.
+   */
+  LOOT_API const std::vector<std::pair<size_t, size_t>>& GetPairs() const;
+
+  /**
+   * @brief Get the number of other plugins that each plugin overlaps with.
+   * @return The overlap counts, in the same order as GetPlugins().
+   */
+  LOOT_API const std::vector<size_t>& GetOverlapCounts() const;
+
+private:
+  std::vector<std::string> plugins_;
+  std::vector<std::pair<size_t, size_t>> pairs_;
+  std::vector<size_t> overlapCounts_;
+};
+}
+
+#endif
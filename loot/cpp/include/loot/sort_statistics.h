@@ -0,0 +1,129 @@
+/*  LOOT
+
+    A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+    Fallout: New Vegas.
+
+    Copyright (C) 2012-2016    WrinklyNinja
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+#ifndef LOOT_SORT_STATISTICS
+#define LOOT_SORT_STATISTICS
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+
+#include "loot/api_decorator.h"
+#include "loot/enum/edge_type.h"
+#include "loot/enum/sort_phase.h"
+
+namespace loot {
+/**
+ * @brief A class holding timings and counts collected while sorting plugins.
+ * @details Masters, non-masters and blueprint masters are sorted in separate
+ *          graphs, and the statistics for each graph are summed. As the graphs
+ *          may be sorted in parallel, the sum of the phase durations may be
+ *          greater than the total duration.
+ */
+class SortStatistics {
+public:
+  /**
+   * @brief Construct a SortStatistics object with no timings or counts.
+   */
+  LOOT_API SortStatistics() = default;
+
+  /**
+   * @brief Construct a SortStatistics object with the given data.
+   * @param totalDuration The time taken to sort.
+   * @param phaseDurations The time spent in each phase of sorting.
+   * @param nodeCount The number of plugins that were sorted.
+   * @param edgeCounts The number of edges of each type that were added.
+   * @param pathQueryCount The number of times that sorting checked if there
+   *                       was a path between two plugins.
+   * @param pathSearchCount The number of path checks that needed to search
+   *                        the graph.
+   */
+  LOOT_API explicit SortStatistics(
+      std::chrono::nanoseconds totalDuration,
+      std::map<SortPhase, std::chrono::nanoseconds> phaseDurations,
+      size_t nodeCount,
+      std::map<EdgeType, size_t> edgeCounts,
+      size_t pathQueryCount,
+      size_t pathSearchCount);
+
+  /**
+   * @brief Get the time taken to sort, from the start of validating the input
+   *        to getting the sorted load order.
+   * @return The total duration.
+   */
+  LOOT_API std::chrono::nanoseconds GetTotalDuration() const;
+
+  /**
+   * @brief Get the total time spent in the given phase.
+   * @return The duration, which is zero if the phase was not reached.
+   */
+  LOOT_API std::chrono::nanoseconds GetPhaseDuration(SortPhase phase) const;
+
+  /**
+   * @brief Get the number of plugins that were sorted.
+   * @return The node count.
+   */
+  LOOT_API size_t GetNodeCount() const;
+
+  /**
+   * @brief Get the number of edges of the given type that were added.
+   * @return The edge count.
+   */
+  LOOT_API size_t GetEdgeCount(EdgeType edgeType) const;
+
+  /**
+   * @brief Get the number of edges that were added, across all edge types.
+   * @return The edge count.
+   */
+  LOOT_API size_t GetTotalEdgeCount() const;
+
+  /**
+   * @brief Get the number of times that sorting checked if there was a path
+   *        between two plugins.
+   * @details These checks are answered by a reachability index that is kept
+   *          up to date as edges are added.
+   * @return The path query count.
+   */
+  LOOT_API size_t GetPathQueryCount() const;
+
+  /**
+   * @brief Get the number of path checks that also needed the path itself,
+   *        which involves searching the graph.
+   * @details The remaining checks were answered by the reachability index
+   *          alone, so the index's hit rate is
+   *          `1 - GetPathSearchCount() / GetPathQueryCount()`.
+   * @return The path search count.
+   */
+  LOOT_API size_t GetPathSearchCount() const;
+
+private:
+  std::chrono::nanoseconds totalDuration_{0};
+  std::map<SortPhase, std::chrono::nanoseconds> phaseDurations_;
+  size_t nodeCount_{0};
+  std::map<EdgeType, size_t> edgeCounts_;
+  size_t pathQueryCount_{0};
+  size_t pathSearchCount_{0};
+};
+}
+
+#endif
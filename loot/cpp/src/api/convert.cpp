@@ -133,6 +133,10 @@ loot::PluginMetadata convert(const loot::rust::PluginMetadata& metadata) {
   return output;
 }
 
+std::optional<loot::EdgeType> convert(loot::rust::EdgeType edgeType) {
+  return ::convert(edgeType);
+}
+
 loot::Vertex convert(const loot::rust::Vertex& vertex) {
   try {
     const auto outEdgeType = ::convert(vertex.out_edge_type());
@@ -34,6 +34,8 @@ loot::PluginMetadata convert(const loot::rust::PluginMetadata& metadata);
 
 std::optional<loot::EdgeType> convert(uint8_t edgeType);
 
+std::optional<loot::EdgeType> convert(loot::rust::EdgeType edgeType);
+
 loot::Vertex convert(const loot::rust::Vertex& vertex);
 
 // From public types
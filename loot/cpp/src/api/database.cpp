@@ -3,6 +3,7 @@
 
 #include "api/convert.h"
 #include "api/exception/exception.h"
+#include "api/plugin_metadata_view.h"
 
 namespace loot {
 Database::Database(::rust::Box<loot::rust::Database>&& database) :
@@ -27,6 +28,17 @@ void Database::LoadMasterlistWithPrelude(
   }
 }
 
+bool Database::LoadMasterlistSnapshot(
+    const std::filesystem::path& masterlistPath,
+    const std::filesystem::path& masterlistPreludePath) {
+  try {
+    return database_->load_masterlist_snapshot(
+        masterlistPath.u8string(), masterlistPreludePath.u8string());
+  } catch (const ::rust::Error& e) {
+    std::rethrow_exception(mapError(e));
+  }
+}
+
 void Database::LoadUserlist(const std::filesystem::path& userlistPath) {
   try {
     database_->load_userlist(userlistPath.u8string());
@@ -122,6 +134,55 @@ std::optional<PluginMetadata> Database::GetPluginMetadata(
   }
 }
 
+std::unique_ptr<const PluginMetadataView> Database::GetPluginMetadataView(
+    std::string_view plugin,
+    bool includeUserMetadata,
+    bool evaluateConditions) const {
+  try {
+    auto metadata = database_->plugin_metadata(
+        convert(plugin), includeUserMetadata, evaluateConditions);
+    if (metadata->is_some()) {
+      return std::make_unique<BorrowedPluginMetadata>(std::move(metadata));
+    } else {
+      return nullptr;
+    }
+  } catch (const ::rust::Error& e) {
+    std::rethrow_exception(mapError(e));
+  }
+}
+
+std::vector<std::optional<PluginMetadata>> Database::GetPluginsMetadata(
+    const std::vector<std::string>& plugins,
+    bool includeUserMetadata,
+    bool evaluateConditions) const {
+  std::vector<::rust::Str> pluginStrs;
+  pluginStrs.reserve(plugins.size());
+  for (const auto& plugin : plugins) {
+    pluginStrs.push_back(plugin);
+  }
+
+  try {
+    const auto results = database_->plugins_metadata(
+        ::rust::Slice<const ::rust::Str>(pluginStrs),
+        includeUserMetadata,
+        evaluateConditions);
+
+    std::vector<std::optional<PluginMetadata>> metadata;
+    metadata.reserve(results.size());
+    for (const auto& result : results) {
+      if (result.is_some()) {
+        metadata.push_back(convert(result.as_ref()));
+      } else {
+        metadata.push_back(std::nullopt);
+      }
+    }
+
+    return metadata;
+  } catch (const ::rust::Error& e) {
+    std::rethrow_exception(mapError(e));
+  }
+}
+
 std::optional<PluginMetadata> Database::GetPluginUserMetadata(
     std::string_view plugin,
     bool evaluateConditions) const {
@@ -16,6 +16,10 @@ public:
       const std::filesystem::path& masterlist_path,
       const std::filesystem::path& masterlist_prelude_path) override;
 
+  bool LoadMasterlistSnapshot(
+      const std::filesystem::path& masterlist_path,
+      const std::filesystem::path& masterlist_prelude_path) override;
+
   void LoadUserlist(const std::filesystem::path& userlist_path) override;
 
   void WriteUserMetadata(const std::filesystem::path& outputFile,
@@ -43,6 +47,16 @@ public:
       bool includeUserMetadata = true,
       bool evaluateConditions = false) const override;
 
+  std::unique_ptr<const PluginMetadataView> GetPluginMetadataView(
+      std::string_view plugin,
+      bool includeUserMetadata = true,
+      bool evaluateConditions = false) const override;
+
+  std::vector<std::optional<PluginMetadata>> GetPluginsMetadata(
+      const std::vector<std::string>& plugins,
+      bool includeUserMetadata = true,
+      bool evaluateConditions = false) const override;
+
   std::optional<PluginMetadata> GetPluginUserMetadata(
       std::string_view plugin,
       bool evaluateConditions = false) const override;
@@ -1,6 +1,10 @@
 
 #include "api/game.h"
 
+#include <atomic>
+#include <map>
+#include <unordered_set>
+
 #include "api/convert.h"
 #include "api/exception/exception.h"
 
@@ -87,6 +91,49 @@ rust::Box<loot::rust::Game> constructGame(
   }
 }
 
+loot::SortPhase convert(loot::rust::SortPhase phase) {
+  switch (phase) {
+    case loot::rust::SortPhase::SpecificEdges:
+      return loot::SortPhase::specificEdges;
+    case loot::rust::SortPhase::GroupEdges:
+      return loot::SortPhase::groupEdges;
+    case loot::rust::SortPhase::OverlapEdges:
+      return loot::SortPhase::overlapEdges;
+    case loot::rust::SortPhase::TieBreakEdges:
+      return loot::SortPhase::tieBreakEdges;
+    case loot::rust::SortPhase::CycleChecks:
+      return loot::SortPhase::cycleChecks;
+    case loot::rust::SortPhase::TopologicalSort:
+      return loot::SortPhase::topologicalSort;
+    default:
+      throw std::logic_error("Unsupported SortPhase value");
+  }
+}
+
+loot::SortStatistics convert(const loot::rust::SortResult& result) {
+  std::map<loot::SortPhase, std::chrono::nanoseconds> phaseDurations;
+  for (const auto& phaseDuration : result.phase_durations()) {
+    phaseDurations.emplace(convert(phaseDuration.phase),
+                           std::chrono::nanoseconds(phaseDuration.nanoseconds));
+  }
+
+  std::map<loot::EdgeType, size_t> edgeCounts;
+  for (const auto& edgeCount : result.edge_counts()) {
+    const auto edgeType = loot::convert(edgeCount.edge_type);
+    if (edgeType.has_value()) {
+      edgeCounts.emplace(edgeType.value(), edgeCount.count);
+    }
+  }
+
+  return loot::SortStatistics(
+      std::chrono::nanoseconds(result.total_duration_nanos()),
+      std::move(phaseDurations),
+      result.node_count(),
+      std::move(edgeCounts),
+      result.path_query_count(),
+      result.path_search_count());
+}
+
 std::vector<::rust::Str> asStrRefs(const std::vector<std::string>& vector) {
   std::vector<::rust::Str> strings;
   for (const auto& str : vector) {
@@ -102,7 +149,8 @@ Game::Game(const GameType gameType,
            const std::filesystem::path& gamePath,
            const std::filesystem::path& localDataPath) :
     game_(constructGame(gameType, gamePath, localDataPath)),
-    database_(game_->database()) {}
+    database_(game_->database()),
+    pluginsSnapshot_(std::make_shared<const PluginsSnapshot>()) {}
 
 GameType Game::GetType() const {
   try {
@@ -151,6 +199,8 @@ bool Game::IsValidPlugin(const std::filesystem::path& pluginPath) const {
 
 void Game::LoadPlugins(const std::vector<std::filesystem::path>& pluginPaths,
                        bool loadHeadersOnly) {
+  std::lock_guard<std::mutex> guard(pluginsWriteMutex_);
+
   std::vector<::rust::String> path_strings;
   std::vector<::rust::Str> path_strs;
   for (const auto& path : pluginPaths) {
@@ -168,76 +218,107 @@ void Game::LoadPlugins(const std::vector<std::filesystem::path>& pluginPaths,
     std::rethrow_exception(mapError(e));
   }
 
-  std::lock_guard<std::mutex> guard(pluginsMutex_);
-
-  for (const auto& path : pluginPaths) {
-    auto key = Filename(path.filename().u8string());
-    auto it = plugins_.find(key);
-    if (it != plugins_.end()) {
-      plugins_.erase(it);
-    }
-  }
+  PublishPluginsSnapshot(BuildPluginsSnapshot(pluginPaths));
 }
 
 void Game::ClearLoadedPlugins() {
+  std::lock_guard<std::mutex> guard(pluginsWriteMutex_);
+
   game_->clear_loaded_plugins();
 
-  std::lock_guard<std::mutex> guard(pluginsMutex_);
-  plugins_.clear();
+  PublishPluginsSnapshot(std::make_shared<const PluginsSnapshot>());
+}
+
+void Game::SetCrcCachePath(const std::filesystem::path& cachePath) {
+  std::lock_guard<std::mutex> guard(pluginsWriteMutex_);
+
+  game_->set_crc_cache_path(cachePath.u8string());
+}
+
+void Game::PrewarmCrcCache(
+    const std::vector<std::filesystem::path>& pluginPaths) {
+  std::vector<::rust::String> path_strings;
+  std::vector<::rust::Str> path_strs;
+  path_strings.reserve(pluginPaths.size());
+  for (const auto& path : pluginPaths) {
+    path_strings.push_back(path.u8string());
+    path_strs.push_back(path_strings.back());
+  }
+
+  game_->prewarm_crc_cache(::rust::Slice<const ::rust::Str>(path_strs));
 }
 
 std::shared_ptr<const PluginInterface> Game::GetPlugin(
     std::string_view pluginName) const {
-  std::lock_guard<std::mutex> guard(pluginsMutex_);
+  const auto snapshot = LoadPluginsSnapshot();
 
-  auto key = Filename(pluginName);
-  const auto it = plugins_.find(key);
-  if (it != plugins_.end()) {
+  const auto it = snapshot->byName.find(Filename(pluginName));
+  if (it != snapshot->byName.end()) {
     return it->second;
   }
 
-  const auto pluginOpt = game_->plugin(convert(pluginName));
-  if (!pluginOpt->is_some()) {
-    return nullptr;
-  }
+  return nullptr;
+}
 
+std::vector<std::shared_ptr<const PluginInterface>> Game::GetLoadedPlugins()
+    const {
+  return LoadPluginsSnapshot()->plugins;
+}
+
+RecordOverlaps Game::GetRecordOverlapPairs() const {
   try {
-    std::shared_ptr<const PluginInterface> plugin =
-        std::make_shared<Plugin>(std::move(pluginOpt->as_ref().boxed_clone()));
+    const auto overlaps = game_->record_overlaps();
+
+    std::vector<std::pair<size_t, size_t>> pairs;
+    pairs.reserve(overlaps->pairs().size());
+    for (const auto& pair : overlaps->pairs()) {
+      pairs.emplace_back(pair.first, pair.second);
+    }
 
-    return plugins_.emplace(key, plugin).first->second;
+    return RecordOverlaps(
+        convert<std::string>(overlaps->plugin_names()),
+        std::move(pairs),
+        std::vector<size_t>(overlaps->overlap_counts().begin(),
+                            overlaps->overlap_counts().end()));
   } catch (const ::rust::Error& e) {
     std::rethrow_exception(mapError(e));
   }
 }
 
-std::vector<std::shared_ptr<const PluginInterface>> Game::GetLoadedPlugins()
-    const {
-  std::lock_guard<std::mutex> guard(pluginsMutex_);
+std::vector<std::string> Game::SortPlugins(
+    const std::vector<std::string>& pluginFilenames) {
+  return SortPlugins(pluginFilenames, true);
+}
 
-  std::vector<std::shared_ptr<const PluginInterface>> plugins;
-  for (const auto& pluginRef : game_->loaded_plugins()) {
-    auto key = Filename(convert(pluginRef.name()));
-    auto it = plugins_.find(key);
-    if (it == plugins_.end()) {
-      std::shared_ptr<const PluginInterface> plugin =
-          std::make_shared<Plugin>(std::move(pluginRef.boxed_clone()));
-      it = plugins_.emplace(key, plugin).first;
-    }
-    plugins.push_back(it->second);
-  }
+std::vector<std::string> Game::SortPlugins(
+    const std::vector<std::string>& pluginFilenames,
+    bool sortInParallel) {
+  const auto strs = asStrRefs(pluginFilenames);
 
-  return plugins;
+  try {
+    const auto results = game_->sort_plugins_with_parallelism(
+        ::rust::Slice(strs), sortInParallel);
+
+    return convert<std::string>(results);
+  } catch (const ::rust::Error& e) {
+    std::rethrow_exception(mapError(e));
+  }
 }
 
 std::vector<std::string> Game::SortPlugins(
-    const std::vector<std::string>& pluginFilenames) {
+    const std::vector<std::string>& pluginFilenames,
+    bool sortInParallel,
+    SortStatistics& statistics) {
   const auto strs = asStrRefs(pluginFilenames);
 
   try {
-    const auto results = game_->sort_plugins(::rust::Slice(strs));
+    const auto result = game_->sort_plugins_with_statistics(
+        ::rust::Slice(strs), sortInParallel);
 
-    return convert<std::string>(results);
+    auto loadOrder = convert<std::string>(result->load_order());
+    statistics = ::convert(*result);
+
+    return loadOrder;
   } catch (const ::rust::Error& e) {
     std::rethrow_exception(mapError(e));
   }
@@ -284,4 +365,59 @@ void Game::SetLoadOrder(const std::vector<std::string>& loadOrder) {
     std::rethrow_exception(mapError(e));
   }
 }
+std::shared_ptr<const Game::PluginsSnapshot> Game::LoadPluginsSnapshot()
+    const {
+  // C++17 has no std::atomic<std::shared_ptr>, so use the atomic free
+  // function overloads for shared_ptr.
+  return std::atomic_load_explicit(&pluginsSnapshot_,
+                                   std::memory_order_acquire);
+}
+
+void Game::PublishPluginsSnapshot(
+    std::shared_ptr<const PluginsSnapshot> snapshot) {
+  std::atomic_store_explicit(
+      &pluginsSnapshot_, std::move(snapshot), std::memory_order_release);
+}
+
+std::shared_ptr<const Game::PluginsSnapshot> Game::BuildPluginsSnapshot(
+    const std::vector<std::filesystem::path>& reloadedPaths) const {
+  std::unordered_set<Filename> reloaded;
+  for (const auto& path : reloadedPaths) {
+    // Ghosted plugins are loaded under their unghosted names.
+    if (Filename(path.extension().u8string()) == Filename(".ghost")) {
+      reloaded.insert(Filename(path.stem().u8string()));
+    } else {
+      reloaded.insert(Filename(path.filename().u8string()));
+    }
+  }
+
+  const auto previous = LoadPluginsSnapshot();
+  auto snapshot = std::make_shared<PluginsSnapshot>();
+
+  const auto loadedPlugins = game_->loaded_plugins();
+  snapshot->byName.reserve(loadedPlugins.size());
+  snapshot->plugins.reserve(loadedPlugins.size());
+
+  for (const auto& pluginRef : loadedPlugins) {
+    auto key = Filename(convert(pluginRef.name()));
+
+    std::shared_ptr<const PluginInterface> plugin;
+    if (reloaded.count(key) == 0) {
+      // Unchanged plugins keep their existing wrapper objects.
+      const auto it = previous->byName.find(key);
+      if (it != previous->byName.end()) {
+        plugin = it->second;
+      }
+    }
+
+    if (!plugin) {
+      plugin = std::make_shared<Plugin>(std::move(pluginRef.boxed_clone()));
+    }
+
+    snapshot->plugins.push_back(plugin);
+    snapshot->byName.emplace(std::move(key), std::move(plugin));
+  }
+
+  return snapshot;
+}
 }
@@ -1,8 +1,10 @@
 #ifndef LOOT_API_GAME
 #define LOOT_API_GAME
 
-#include <map>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include "api/database.h"
 #include "api/plugin.h"
@@ -35,15 +37,31 @@ public:
 
   void ClearLoadedPlugins() override;
 
+  void SetCrcCachePath(const std::filesystem::path& cachePath) override;
+
+  void PrewarmCrcCache(
+      const std::vector<std::filesystem::path>& pluginPaths) override;
+
   std::shared_ptr<const PluginInterface> GetPlugin(
       std::string_view pluginName) const override;
 
   std::vector<std::shared_ptr<const PluginInterface>> GetLoadedPlugins()
       const override;
 
+  RecordOverlaps GetRecordOverlapPairs() const override;
+
   std::vector<std::string> SortPlugins(
       const std::vector<std::string>& pluginFilenames) override;
 
+  std::vector<std::string> SortPlugins(
+      const std::vector<std::string>& pluginFilenames,
+      bool sortInParallel) override;
+
+  std::vector<std::string> SortPlugins(
+      const std::vector<std::string>& pluginFilenames,
+      bool sortInParallel,
+      SortStatistics& statistics) override;
+
   void LoadCurrentLoadOrderState() override;
 
   bool IsLoadOrderAmbiguous() const override;
@@ -60,8 +78,23 @@ private:
   ::rust::Box<loot::rust::Game> game_;
   Database database_;
 
-  mutable std::map<Filename, std::shared_ptr<const PluginInterface>> plugins_;
-  mutable std::mutex pluginsMutex_;
+  // An immutable view of the loaded plugins. A new snapshot is built and
+  // published whenever the loaded plugins change, so readers only need to
+  // atomically load the current pointer and never wait on a writer.
+  struct PluginsSnapshot {
+    std::unordered_map<Filename, std::shared_ptr<const PluginInterface>>
+        byName;
+    std::vector<std::shared_ptr<const PluginInterface>> plugins;
+  };
+
+  std::shared_ptr<const PluginsSnapshot> LoadPluginsSnapshot() const;
+  void PublishPluginsSnapshot(std::shared_ptr<const PluginsSnapshot> snapshot);
+  std::shared_ptr<const PluginsSnapshot> BuildPluginsSnapshot(
+      const std::vector<std::filesystem::path>& reloadedPaths) const;
+
+  std::shared_ptr<const PluginsSnapshot> pluginsSnapshot_;
+  // Serialises changes to the loaded plugins. Readers don't take it.
+  std::mutex pluginsWriteMutex_;
 };
 }
 
@@ -24,18 +24,176 @@
 
 #include "loot/metadata/filename.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <stdexcept>
 
 #include "libloot-cpp/src/lib.rs.h"
 
+namespace {
+// Filenames are compared eight bytes at a time using SWAR (SIMD within a
+// register) tricks, which is portable and covers the common case of ASCII
+// plugin names. Anything else is compared by libloot so that the results
+// match its Unicode case folding exactly.
+constexpr uint64_t ONES = 0x0101010101010101;
+constexpr uint64_t HIGH_BITS = 0x8080808080808080;
+
+uint64_t LoadWord(const char* bytes) {
+  uint64_t word;
+  std::memcpy(&word, bytes, sizeof(word));
+  return word;
+}
+
+bool IsAscii(std::string_view string) {
+  const char* bytes = string.data();
+  size_t remaining = string.size();
+
+  while (remaining >= sizeof(uint64_t)) {
+    if ((LoadWord(bytes) & HIGH_BITS) != 0) {
+      return false;
+    }
+    bytes += sizeof(uint64_t);
+    remaining -= sizeof(uint64_t);
+  }
+
+  for (; remaining > 0; --remaining, ++bytes) {
+    if ((static_cast<unsigned char>(*bytes) & 0x80) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Lowercases every ASCII uppercase letter in a word that contains only ASCII
+// bytes. Neither addition can carry between bytes because each byte is below
+// 0x80.
+uint64_t FoldAsciiWord(uint64_t word) {
+  const uint64_t atLeastA = word + ONES * (0x80 - 'A');
+  const uint64_t aboveZ = word + ONES * (0x7F - 'Z');
+  const uint64_t upper = atLeastA & ~aboveZ & HIGH_BITS;
+
+  return word | (upper >> 2);
+}
+
+unsigned char FoldAsciiByte(char byte) {
+  const auto value = static_cast<unsigned char>(byte);
+  return value >= 'A' && value <= 'Z' ? value + ('a' - 'A') : value;
+}
+
+bool AsciiEqual(std::string_view lhs, std::string_view rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= lhs.size(); i += sizeof(uint64_t)) {
+    const uint64_t left = LoadWord(lhs.data() + i);
+    const uint64_t right = LoadWord(rhs.data() + i);
+    if (left != right && FoldAsciiWord(left) != FoldAsciiWord(right)) {
+      return false;
+    }
+  }
+
+  for (; i < lhs.size(); ++i) {
+    if (FoldAsciiByte(lhs[i]) != FoldAsciiByte(rhs[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool AsciiLess(std::string_view lhs, std::string_view rhs) {
+  const size_t length = std::min(lhs.size(), rhs.size());
+
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    const uint64_t left = LoadWord(lhs.data() + i);
+    const uint64_t right = LoadWord(rhs.data() + i);
+    if (left != right && FoldAsciiWord(left) != FoldAsciiWord(right)) {
+      // Let the bytewise loop below find the first byte that differs.
+      break;
+    }
+  }
+
+  for (; i < length; ++i) {
+    const auto left = FoldAsciiByte(lhs[i]);
+    const auto right = FoldAsciiByte(rhs[i]);
+    if (left != right) {
+      return left < right;
+    }
+  }
+
+  return lhs.size() < rhs.size();
+}
+
+// FNV-1a over the folded bytes.
+size_t HashFoldedBytes(std::string_view string, bool foldAscii) {
+  if constexpr (sizeof(size_t) >= sizeof(uint64_t)) {
+    uint64_t hash = 0xcbf29ce484222325;
+    for (const char byte : string) {
+      hash ^= foldAscii ? FoldAsciiByte(byte)
+                        : static_cast<unsigned char>(byte);
+      hash *= 0x100000001b3;
+    }
+    return static_cast<size_t>(hash);
+  } else {
+    uint32_t hash = 0x811c9dc5;
+    for (const char byte : string) {
+      hash ^= foldAscii ? FoldAsciiByte(byte)
+                        : static_cast<unsigned char>(byte);
+      hash *= 0x01000193;
+    }
+    return static_cast<size_t>(hash);
+  }
+}
+
+size_t HashFilename(std::string_view filename, bool isAscii) {
+  if (isAscii) {
+    return HashFoldedBytes(filename, true);
+  }
+
+  try {
+    const auto folded = loot::rust::filename_folded_case(
+        ::rust::Str(filename.data(), filename.size()));
+    return HashFoldedBytes(std::string_view(folded.data(), folded.size()),
+                           false);
+  } catch (const std::invalid_argument&) {
+    // The filename isn't valid UTF-8, so comparisons involving it will throw
+    // anyway: any hash will do.
+    return HashFoldedBytes(filename, true);
+  }
+}
+
+::rust::Str AsStr(const std::string& string) {
+  return ::rust::Str(string.data(), string.size());
+}
+}
+
 namespace loot {
-Filename::Filename(std::string_view filename) : filename_(filename) {}
+Filename::Filename() : Filename(std::string_view()) {}
+
+Filename::Filename(std::string_view filename) :
+    filename_(filename),
+    foldedHash_(0),
+    isAscii_(IsAscii(filename)) {
+  foldedHash_ = HashFilename(filename_, isAscii_);
+}
 
 Filename::operator std::string() const { return filename_; }
 
 bool operator==(const Filename& lhs, const Filename& rhs) {
-  return loot::rust::new_filename(lhs.filename_)
-      ->eq(*loot::rust::new_filename(rhs.filename_));
+  if (lhs.foldedHash_ != rhs.foldedHash_) {
+    return false;
+  }
+
+  if (lhs.isAscii_ && rhs.isAscii_) {
+    return AsciiEqual(lhs.filename_, rhs.filename_);
+  }
+
+  return loot::rust::filename_eq(AsStr(lhs.filename_), AsStr(rhs.filename_));
 }
 
 bool operator!=(const Filename& lhs, const Filename& rhs) {
@@ -43,8 +201,11 @@ bool operator!=(const Filename& lhs, const Filename& rhs) {
 }
 
 bool operator<(const Filename& lhs, const Filename& rhs) {
-  return loot::rust::new_filename(lhs.filename_)
-             ->lt(*loot::rust::new_filename(rhs.filename_));
+  if (lhs.isAscii_ && rhs.isAscii_) {
+    return AsciiLess(lhs.filename_, rhs.filename_);
+  }
+
+  return loot::rust::filename_lt(AsStr(lhs.filename_), AsStr(rhs.filename_));
 }
 
 bool operator>(const Filename& lhs, const Filename& rhs) { return rhs < lhs; }
@@ -27,28 +27,89 @@
 #include <cstring>
 #include <regex>
 #include <stdexcept>
+#include <unordered_set>
 
 #include "api/convert.h"
 #include "api/exception/exception.h"
 #include "libloot-cpp/src/lib.rs.h"
 
 namespace {
-// Append second to first, skipping any elements that are already present in
-// first. Although this is O(U * M), both input vectors are expected to be
-// small (with tens of elements being an unusually large number).
+// Below this many element comparisons, a linear scan is faster than building
+// a hash set, and most metadata lists are well below it.
+constexpr size_t HASHED_MERGE_THRESHOLD = 256;
+
+void hashCombine(size_t& seed, size_t value) {
+  seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+// These hashes only cover the cheap-to-hash fields that operator== compares,
+// which is enough to keep collisions rare.
+struct MetadataHash {
+  size_t operator()(const loot::File& file) const {
+    size_t seed = std::hash<loot::Filename>()(file.GetName());
+    hashCombine(seed, std::hash<std::string>()(file.GetCondition()));
+    return seed;
+  }
+
+  size_t operator()(const loot::Tag& tag) const {
+    size_t seed = std::hash<std::string>()(tag.GetName());
+    hashCombine(seed, std::hash<std::string>()(tag.GetCondition()));
+    hashCombine(seed, tag.IsAddition() ? 1 : 0);
+    return seed;
+  }
+
+  size_t operator()(const loot::PluginCleaningData& data) const {
+    size_t seed = std::hash<uint32_t>()(data.GetCRC());
+    hashCombine(seed, std::hash<std::string>()(data.GetCleaningUtility()));
+    return seed;
+  }
+
+  size_t operator()(const loot::Location& location) const {
+    return std::hash<std::string>()(location.GetURL());
+  }
+};
+
+// Append second to first, skipping any elements that were already present in
+// first before any were appended. Most inputs are small (with tens of elements
+// being an unusually large number), so they are compared linearly, but large
+// inputs (e.g. generated userlist rules) are deduplicated using a hash set.
+// Either way the order of both inputs is preserved.
 template<typename T>
-std::vector<T> mergeVectors(std::vector<T> first,
-                            const std::vector<T>& second) {
-  const auto initialSizeOfFirst = first.end() - first.begin();
-  for (const auto& element : second) {
-    const auto end = first.cbegin() + initialSizeOfFirst;
+void mergeVectors(std::vector<T>& first, const std::vector<T>& second) {
+  if (&first == &second) {
+    return;
+  }
 
-    if (std::find(first.cbegin(), end, element) == end) {
-      first.push_back(element);
+  const size_t initialSizeOfFirst = first.size();
+  if (initialSizeOfFirst * second.size() < HASHED_MERGE_THRESHOLD) {
+    for (const auto& element : second) {
+      const auto end = first.cbegin() + initialSizeOfFirst;
+
+      if (std::find(first.cbegin(), end, element) == end) {
+        first.push_back(element);
+      }
     }
+
+    return;
+  }
+
+  // Reserving up front means that the set's pointers into first stay valid
+  // while elements are appended.
+  first.reserve(initialSizeOfFirst + second.size());
+
+  const auto hash = [](const T* element) { return MetadataHash()(*element); };
+  const auto equal = [](const T* lhs, const T* rhs) { return *lhs == *rhs; };
+  std::unordered_set<const T*, decltype(hash), decltype(equal)> existing(
+      initialSizeOfFirst, hash, equal);
+  for (const auto& element : first) {
+    existing.insert(&element);
   }
 
-  return first;
+  for (const auto& element : second) {
+    if (existing.count(&element) == 0) {
+      first.push_back(element);
+    }
+  }
 }
 
 std::string trimDotGhostExtension(std::string&& filename) {
@@ -91,20 +152,19 @@ void PluginMetadata::MergeMetadata(const PluginMetadata& plugin) {
     group_ = plugin.GetGroup();
   }
 
-  loadAfter_ = mergeVectors(loadAfter_, plugin.loadAfter_);
-  requirements_ = mergeVectors(requirements_, plugin.requirements_);
-  incompatibilities_ =
-      mergeVectors(incompatibilities_, plugin.incompatibilities_);
+  mergeVectors(loadAfter_, plugin.loadAfter_);
+  mergeVectors(requirements_, plugin.requirements_);
+  mergeVectors(incompatibilities_, plugin.incompatibilities_);
 
-  tags_ = mergeVectors(tags_, plugin.tags_);
+  mergeVectors(tags_, plugin.tags_);
 
   // Messages are in an ordered list, and should be fully merged.
   messages_.insert(
       end(messages_), begin(plugin.messages_), end(plugin.messages_));
 
-  dirtyInfo_ = mergeVectors(dirtyInfo_, plugin.dirtyInfo_);
-  cleanInfo_ = mergeVectors(cleanInfo_, plugin.cleanInfo_);
-  locations_ = mergeVectors(locations_, plugin.locations_);
+  mergeVectors(dirtyInfo_, plugin.dirtyInfo_);
+  mergeVectors(cleanInfo_, plugin.cleanInfo_);
+  mergeVectors(locations_, plugin.locations_);
 
   return;
 }
@@ -0,0 +1,92 @@
+#include "api/plugin_metadata_view.h"
+
+#include "api/exception/exception.h"
+
+namespace {
+const loot::rust::PluginMetadata& unwrap(
+    const loot::rust::OptionalPluginMetadata& metadata) {
+  try {
+    return metadata.as_ref();
+  } catch (const ::rust::Error& e) {
+    std::rethrow_exception(loot::mapError(e));
+  }
+}
+}
+
+namespace loot {
+BorrowedPluginMetadata::BorrowedPluginMetadata(
+    ::rust::Box<loot::rust::OptionalPluginMetadata> metadata) :
+    owner_(std::move(metadata)), metadata_(unwrap(*owner_)) {}
+
+std::string_view BorrowedPluginMetadata::GetName() const {
+  return convert(metadata_.name());
+}
+
+std::optional<std::string_view> BorrowedPluginMetadata::GetGroup() const {
+  const auto group = metadata_.group();
+  if (group.empty()) {
+    return std::nullopt;
+  } else {
+    return convert(group);
+  }
+}
+
+std::vector<std::string_view> BorrowedPluginMetadata::GetLoadAfterFileNames()
+    const {
+  const auto files = metadata_.load_after_files();
+
+  std::vector<std::string_view> names;
+  names.reserve(files.size());
+  for (const auto& file : files) {
+    names.push_back(convert(file.filename().as_str()));
+  }
+
+  return names;
+}
+
+const std::vector<File>& BorrowedPluginMetadata::GetLoadAfterFiles() const {
+  return Materialize(loadAfterFiles_, metadata_.load_after_files());
+}
+
+const std::vector<File>& BorrowedPluginMetadata::GetRequirements() const {
+  return Materialize(requirements_, metadata_.requirements());
+}
+
+const std::vector<File>& BorrowedPluginMetadata::GetIncompatibilities() const {
+  return Materialize(incompatibilities_, metadata_.incompatibilities());
+}
+
+const std::vector<Message>& BorrowedPluginMetadata::GetMessages() const {
+  return Materialize(messages_, metadata_.messages());
+}
+
+const std::vector<Tag>& BorrowedPluginMetadata::GetTags() const {
+  return Materialize(tags_, metadata_.tags());
+}
+
+const std::vector<PluginCleaningData>& BorrowedPluginMetadata::GetDirtyInfo()
+    const {
+  return Materialize(dirtyInfo_, metadata_.dirty_info());
+}
+
+const std::vector<PluginCleaningData>& BorrowedPluginMetadata::GetCleanInfo()
+    const {
+  return Materialize(cleanInfo_, metadata_.clean_info());
+}
+
+const std::vector<Location>& BorrowedPluginMetadata::GetLocations() const {
+  return Materialize(locations_, metadata_.locations());
+}
+
+bool BorrowedPluginMetadata::HasNameOnly() const {
+  return metadata_.has_name_only();
+}
+
+bool BorrowedPluginMetadata::IsRegexPlugin() const {
+  return metadata_.is_regex_plugin();
+}
+
+PluginMetadata BorrowedPluginMetadata::ToOwned() const {
+  return convert(metadata_);
+}
+}
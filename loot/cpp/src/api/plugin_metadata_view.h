@@ -0,0 +1,63 @@
+#ifndef LOOT_API_PLUGIN_METADATA_VIEW
+#define LOOT_API_PLUGIN_METADATA_VIEW
+
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "api/convert.h"
+#include "libloot-cpp/src/lib.rs.h"
+#include "loot/metadata/plugin_metadata_view.h"
+
+namespace loot {
+template<typename T>
+struct LazyVector {
+  std::once_flag flag;
+  std::vector<T> value;
+};
+
+class BorrowedPluginMetadata final : public PluginMetadataView {
+public:
+  explicit BorrowedPluginMetadata(
+      ::rust::Box<loot::rust::OptionalPluginMetadata> metadata);
+
+  std::string_view GetName() const override;
+  std::optional<std::string_view> GetGroup() const override;
+  std::vector<std::string_view> GetLoadAfterFileNames() const override;
+  const std::vector<File>& GetLoadAfterFiles() const override;
+  const std::vector<File>& GetRequirements() const override;
+  const std::vector<File>& GetIncompatibilities() const override;
+  const std::vector<Message>& GetMessages() const override;
+  const std::vector<Tag>& GetTags() const override;
+  const std::vector<PluginCleaningData>& GetDirtyInfo() const override;
+  const std::vector<PluginCleaningData>& GetCleanInfo() const override;
+  const std::vector<Location>& GetLocations() const override;
+  bool HasNameOnly() const override;
+  bool IsRegexPlugin() const override;
+
+  PluginMetadata ToOwned() const override;
+
+private:
+  template<typename T, typename U>
+  static const std::vector<T>& Materialize(LazyVector<T>& lazy,
+                                           ::rust::Slice<const U> slice) {
+    std::call_once(lazy.flag, [&]() { lazy.value = convert<T>(slice); });
+    return lazy.value;
+  }
+
+  ::rust::Box<loot::rust::OptionalPluginMetadata> owner_;
+  const loot::rust::PluginMetadata& metadata_;
+
+  mutable LazyVector<File> loadAfterFiles_;
+  mutable LazyVector<File> requirements_;
+  mutable LazyVector<File> incompatibilities_;
+  mutable LazyVector<Message> messages_;
+  mutable LazyVector<Tag> tags_;
+  mutable LazyVector<PluginCleaningData> dirtyInfo_;
+  mutable LazyVector<PluginCleaningData> cleanInfo_;
+  mutable LazyVector<Location> locations_;
+};
+}
+
+#endif
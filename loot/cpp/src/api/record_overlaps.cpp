@@ -0,0 +1,45 @@
+/*  LOOT
+
+    A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+    Fallout: New Vegas.
+
+    Copyright (C) 2018    WrinklyNinja
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+#include "loot/record_overlaps.h"
+
+namespace loot {
+RecordOverlaps::RecordOverlaps(std::vector<std::string> plugins,
+                               std::vector<std::pair<size_t, size_t>> pairs,
+                               std::vector<size_t> overlapCounts) :
+    plugins_(std::move(plugins)),
+    pairs_(std::move(pairs)),
+    overlapCounts_(std::move(overlapCounts)) {}
+
+const std::vector<std::string>& RecordOverlaps::GetPlugins() const {
+  return plugins_;
+}
+
+const std::vector<std::pair<size_t, size_t>>& RecordOverlaps::GetPairs() const {
+  return pairs_;
+}
+
+const std::vector<size_t>& RecordOverlaps::GetOverlapCounts() const {
+  return overlapCounts_;
+}
+}
@@ -0,0 +1,80 @@
+/*  LOOT
+
+    A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+    Fallout: New Vegas.
+
+    Copyright (C) 2012-2016    WrinklyNinja
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+#include "loot/sort_statistics.h"
+
+#include <utility>
+
+namespace loot {
+SortStatistics::SortStatistics(
+    std::chrono::nanoseconds totalDuration,
+    std::map<SortPhase, std::chrono::nanoseconds> phaseDurations,
+    size_t nodeCount,
+    std::map<EdgeType, size_t> edgeCounts,
+    size_t pathQueryCount,
+    size_t pathSearchCount) :
+    totalDuration_(totalDuration),
+    phaseDurations_(std::move(phaseDurations)),
+    nodeCount_(nodeCount),
+    edgeCounts_(std::move(edgeCounts)),
+    pathQueryCount_(pathQueryCount),
+    pathSearchCount_(pathSearchCount) {}
+
+std::chrono::nanoseconds SortStatistics::GetTotalDuration() const {
+  return totalDuration_;
+}
+
+std::chrono::nanoseconds SortStatistics::GetPhaseDuration(
+    SortPhase phase) const {
+  const auto it = phaseDurations_.find(phase);
+  if (it == phaseDurations_.end()) {
+    return std::chrono::nanoseconds(0);
+  }
+
+  return it->second;
+}
+
+size_t SortStatistics::GetNodeCount() const { return nodeCount_; }
+
+size_t SortStatistics::GetEdgeCount(EdgeType edgeType) const {
+  const auto it = edgeCounts_.find(edgeType);
+  if (it == edgeCounts_.end()) {
+    return 0;
+  }
+
+  return it->second;
+}
+
+size_t SortStatistics::GetTotalEdgeCount() const {
+  size_t total = 0;
+  for (const auto& [edgeType, count] : edgeCounts_) {
+    total += count;
+  }
+
+  return total;
+}
+
+size_t SortStatistics::GetPathQueryCount() const { return pathQueryCount_; }
+
+size_t SortStatistics::GetPathSearchCount() const { return pathSearchCount_; }
+}
@@ -42,6 +42,24 @@ impl Database {
             .map_err(Into::into)
     }
 
+    pub fn load_masterlist_snapshot(
+        &self,
+        masterlist_path: &str,
+        prelude_path: &str,
+    ) -> Result<bool, VerboseError> {
+        let prelude_path = if prelude_path.is_empty() {
+            None
+        } else {
+            Some(Path::new(prelude_path))
+        };
+
+        self.0
+            .write()
+            .map_err(DatabaseLockPoisonError::from)?
+            .load_masterlist_snapshot(Path::new(masterlist_path), prelude_path)
+            .map_err(Into::into)
+    }
+
     pub fn load_userlist(&self, path: &str) -> Result<(), VerboseError> {
         self.0
             .write()
@@ -179,6 +197,24 @@ impl Database {
             .map_err(Into::into)
     }
 
+    pub fn plugins_metadata(
+        &self,
+        plugin_names: &[&str],
+        include_user_metadata: bool,
+        evaluate_conditions: bool,
+    ) -> Result<Vec<OptionalPluginMetadata>, VerboseError> {
+        self.0
+            .read()
+            .map_err(DatabaseLockPoisonError::from)?
+            .plugins_metadata(
+                plugin_names,
+                to_merge_mode(include_user_metadata),
+                to_eval_mode(evaluate_conditions),
+            )
+            .map(|v| v.into_iter().map(|p| p.map(Into::into).into()).collect())
+            .map_err(Into::into)
+    }
+
     pub fn plugin_user_metadata(
         &self,
         plugin_name: &str,
@@ -1,9 +1,14 @@
-use std::path::Path;
+use std::{path::Path, time::Duration};
 
 use delegate::delegate;
+use libloot::{SortParallelism, SortStatistics};
 use libloot_ffi_errors::UnsupportedEnumValueError;
 
-use crate::{OptionalPlugin, Plugin, VerboseError, database::Database, ffi::GameType};
+use crate::{
+    OptionalPlugin, Plugin, VerboseError,
+    database::Database,
+    ffi::{EdgeType, EdgeTypeCount, GameType, RecordOverlapPair, SortPhase, SortPhaseDuration},
+};
 
 impl TryFrom<libloot::GameType> for GameType {
     type Error = UnsupportedEnumValueError;
@@ -97,6 +102,116 @@ pub fn new_game_with_local_path(
     .map_err(Into::into)
 }
 
+#[derive(Debug)]
+pub struct RecordOverlaps {
+    plugin_names: Vec<String>,
+    pairs: Vec<RecordOverlapPair>,
+    overlap_counts: Vec<usize>,
+}
+
+impl RecordOverlaps {
+    pub fn plugin_names(&self) -> &[String] {
+        &self.plugin_names
+    }
+
+    pub fn pairs(&self) -> &[RecordOverlapPair] {
+        &self.pairs
+    }
+
+    pub fn overlap_counts(&self) -> &[usize] {
+        &self.overlap_counts
+    }
+}
+
+impl From<libloot::RecordOverlaps> for RecordOverlaps {
+    fn from(value: libloot::RecordOverlaps) -> Self {
+        Self {
+            plugin_names: value.plugin_names().to_vec(),
+            pairs: value
+                .pairs()
+                .iter()
+                .map(|(first, second)| RecordOverlapPair {
+                    first: *first,
+                    second: *second,
+                })
+                .collect(),
+            overlap_counts: value.overlap_counts().to_vec(),
+        }
+    }
+}
+
+impl TryFrom<libloot::SortPhase> for SortPhase {
+    type Error = UnsupportedEnumValueError;
+
+    fn try_from(value: libloot::SortPhase) -> Result<Self, Self::Error> {
+        match value {
+            libloot::SortPhase::SpecificEdges => Ok(SortPhase::SpecificEdges),
+            libloot::SortPhase::GroupEdges => Ok(SortPhase::GroupEdges),
+            libloot::SortPhase::OverlapEdges => Ok(SortPhase::OverlapEdges),
+            libloot::SortPhase::TieBreakEdges => Ok(SortPhase::TieBreakEdges),
+            libloot::SortPhase::CycleChecks => Ok(SortPhase::CycleChecks),
+            libloot::SortPhase::TopologicalSort => Ok(SortPhase::TopologicalSort),
+            _ => Err(UnsupportedEnumValueError),
+        }
+    }
+}
+
+fn to_nanoseconds(duration: Duration) -> u64 {
+    u64::try_from(duration.as_nanos()).unwrap_or(u64::MAX)
+}
+
+#[derive(Debug)]
+pub struct SortResult {
+    load_order: Vec<String>,
+    statistics: SortStatistics,
+}
+
+impl SortResult {
+    pub fn load_order(&self) -> &[String] {
+        &self.load_order
+    }
+
+    pub fn total_duration_nanos(&self) -> u64 {
+        to_nanoseconds(self.statistics.total_duration())
+    }
+
+    pub fn phase_durations(&self) -> Result<Vec<SortPhaseDuration>, VerboseError> {
+        self.statistics
+            .phase_durations()
+            .map(|(phase, duration)| {
+                Ok(SortPhaseDuration {
+                    phase: phase.try_into()?,
+                    nanoseconds: to_nanoseconds(duration),
+                })
+            })
+            .collect()
+    }
+
+    pub fn node_count(&self) -> usize {
+        self.statistics.node_count()
+    }
+
+    pub fn edge_counts(&self) -> Result<Vec<EdgeTypeCount>, VerboseError> {
+        self.statistics
+            .edge_counts()
+            .map(|(edge_type, count)| {
+                Ok(EdgeTypeCount {
+                    edge_type: EdgeType::try_from(edge_type)?,
+                    count,
+                })
+            })
+            .collect()
+    }
+
+    pub fn path_query_count(&self) -> usize {
+        self.statistics.path_query_count()
+    }
+
+    pub fn path_search_count(&self) -> usize {
+        self.statistics.path_search_count()
+    }
+}
+
 fn path_to_string(path: &Path) -> Result<String, VerboseError> {
     path.to_str()
         .map(str::to_owned)
@@ -108,6 +223,14 @@ fn strings_to_paths<'a>(paths: &'a [&'a str]) -> Vec<&'a Path> {
     paths.iter().map(Path::new).collect()
 }
 
+fn to_sort_parallelism(value: bool) -> SortParallelism {
+    if value {
+        SortParallelism::Parallel
+    } else {
+        SortParallelism::Sequential
+    }
+}
+
 impl Game {
     pub fn game_type(&self) -> Result<GameType, VerboseError> {
         self.0.game_type().try_into().map_err(Into::into)
@@ -149,6 +272,14 @@ impl Game {
             .map_err(Into::into)
     }
 
+    pub fn set_crc_cache_path(&mut self, path: &str) {
+        self.0.set_crc_cache_path(Path::new(path));
+    }
+
+    pub fn prewarm_crc_cache(&self, plugin_paths: &[&str]) {
+        self.0.prewarm_crc_cache(&strings_to_paths(plugin_paths));
+    }
+
     pub fn plugin(&self, plugin_name: &str) -> Box<OptionalPlugin> {
         Box::new(self.0.plugin(plugin_name).map(Into::into).into())
     }
@@ -165,6 +296,39 @@ impl Game {
         self.0.sort_plugins(plugin_names).map_err(Into::into)
     }
 
+    pub fn sort_plugins_with_parallelism(
+        &self,
+        plugin_names: &[&str],
+        sort_in_parallel: bool,
+    ) -> Result<Vec<String>, VerboseError> {
+        self.0
+            .sort_plugins_with_parallelism(plugin_names, to_sort_parallelism(sort_in_parallel))
+            .map_err(Into::into)
+    }
+
+    pub fn sort_plugins_with_statistics(
+        &self,
+        plugin_names: &[&str],
+        sort_in_parallel: bool,
+    ) -> Result<Box<SortResult>, VerboseError> {
+        self.0
+            .sort_plugins_with_statistics(plugin_names, to_sort_parallelism(sort_in_parallel))
+            .map(|(load_order, statistics)| {
+                Box::new(SortResult {
+                    load_order,
+                    statistics,
+                })
+            })
+            .map_err(Into::into)
+    }
+
+    pub fn record_overlaps(&self) -> Result<Box<RecordOverlaps>, VerboseError> {
+        self.0
+            .record_overlaps()
+            .map(|o| Box::new(o.into()))
+            .map_err(Into::into)
+    }
+
     pub fn load_current_load_order_state(&mut self) -> Result<(), VerboseError> {
         self.0.load_current_load_order_state().map_err(Into::into)
     }
@@ -18,13 +18,14 @@ mod plugin;
 use database::{Database, Vertex, new_vertex};
 use error::{EmptyOptionalError, VerboseError};
 use ffi::OptionalMessageContentRef;
-use game::{Game, new_game, new_game_with_local_path};
+use game::{Game, RecordOverlaps, SortResult, new_game, new_game_with_local_path};
 use libloot_ffi_errors::UnsupportedEnumValueError;
 use metadata::{
     File, Filename, Group, Location, Message, MessageContent, PluginCleaningData, PluginMetadata,
-    Tag, group_default_name, message_content_default_language, multilingual_message, new_file,
-    new_filename, new_group, new_location, new_message, new_message_content,
-    new_plugin_cleaning_data, new_plugin_metadata, new_tag, select_message_content,
+    Tag, filename_eq, filename_folded_case, filename_lt, group_default_name,
+    message_content_default_language, multilingual_message, new_file, new_filename, new_group,
+    new_location, new_message, new_message_content, new_plugin_cleaning_data, new_plugin_metadata,
+    new_tag, select_message_content,
 };
 use plugin::Plugin;
 use std::{
@@ -175,6 +176,33 @@ mod ffi {
         Error,
     }
 
+    #[derive(Clone, Copy, Debug)]
+    struct RecordOverlapPair {
+        first: usize,
+        second: usize,
+    }
+
+    pub enum SortPhase {
+        SpecificEdges,
+        GroupEdges,
+        OverlapEdges,
+        TieBreakEdges,
+        CycleChecks,
+        TopologicalSort,
+    }
+
+    #[derive(Clone, Copy, Debug)]
+    struct SortPhaseDuration {
+        phase: SortPhase,
+        nanoseconds: u64,
+    }
+
+    #[derive(Clone, Copy, Debug)]
+    struct EdgeTypeCount {
+        edge_type: EdgeType,
+        count: usize,
+    }
+
     #[derive(Debug)]
     struct OptionalMessageContentRef {
         pointer: *const MessageContent,
@@ -227,12 +255,30 @@ mod ffi {
 
         pub fn clear_loaded_plugins(&mut self);
 
+        pub fn set_crc_cache_path(&mut self, path: &str);
+
+        pub fn prewarm_crc_cache(&self, plugin_paths: &[&str]);
+
         pub fn plugin(&self, plugin_name: &str) -> Box<OptionalPlugin>;
 
         pub fn loaded_plugins(&self) -> Vec<Plugin>;
 
         pub fn sort_plugins(&self, plugin_names: &[&str]) -> Result<Vec<String>>;
 
+        pub fn sort_plugins_with_parallelism(
+            &self,
+            plugin_names: &[&str],
+            sort_in_parallel: bool,
+        ) -> Result<Vec<String>>;
+
+        pub fn sort_plugins_with_statistics(
+            &self,
+            plugin_names: &[&str],
+            sort_in_parallel: bool,
+        ) -> Result<Box<SortResult>>;
+
+        pub fn record_overlaps(&self) -> Result<Box<RecordOverlaps>>;
+
         pub fn load_current_load_order_state(&mut self) -> Result<()>;
 
         pub fn is_load_order_ambiguous(&self) -> Result<bool>;
@@ -246,6 +292,35 @@ mod ffi {
         pub fn set_load_order(&mut self, load_order: &[&str]) -> Result<()>;
     }
 
+    extern "Rust" {
+        type RecordOverlaps;
+
+        pub fn plugin_names(&self) -> &[String];
+
+        /// Each pair holds indices into the plugin names.
+        pub fn pairs(&self) -> &[RecordOverlapPair];
+
+        pub fn overlap_counts(&self) -> &[usize];
+    }
+
+    extern "Rust" {
+        type SortResult;
+
+        pub fn load_order(&self) -> &[String];
+
+        pub fn total_duration_nanos(&self) -> u64;
+
+        pub fn phase_durations(&self) -> Result<Vec<SortPhaseDuration>>;
+
+        pub fn node_count(&self) -> usize;
+
+        pub fn edge_counts(&self) -> Result<Vec<EdgeTypeCount>>;
+
+        pub fn path_query_count(&self) -> usize;
+
+        pub fn path_search_count(&self) -> usize;
+    }
+
     extern "Rust" {
         type Database;
 
@@ -257,6 +332,12 @@ mod ffi {
             prelude_path: &str,
         ) -> Result<()>;
 
+        pub fn load_masterlist_snapshot(
+            &self,
+            masterlist_path: &str,
+            prelude_path: &str,
+        ) -> Result<bool>;
+
         pub fn load_userlist(&self, path: &str) -> Result<()>;
 
         pub fn write_user_metadata(&self, output_path: &str, overwrite: bool) -> Result<()>;
@@ -288,6 +369,13 @@ mod ffi {
             evaluate_conditions: bool,
         ) -> Result<Box<OptionalPluginMetadata>>;
 
+        pub fn plugins_metadata(
+            &self,
+            plugin_names: &[&str],
+            include_user_metadata: bool,
+            evaluate_conditions: bool,
+        ) -> Result<Vec<OptionalPluginMetadata>>;
+
         pub fn plugin_user_metadata(
             &self,
             plugin_name: &str,
@@ -539,6 +627,12 @@ mod ffi {
         pub fn gt(&self, other: &Filename) -> bool;
 
         pub fn ge(&self, other: &Filename) -> bool;
+
+        pub fn filename_eq(lhs: &str, rhs: &str) -> bool;
+
+        pub fn filename_lt(lhs: &str, rhs: &str) -> bool;
+
+        pub fn filename_folded_case(name: &str) -> String;
     }
 
     extern "Rust" {
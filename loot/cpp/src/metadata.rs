@@ -1,4 +1,5 @@
 use delegate::delegate;
+use unicase::UniCase;
 
 use crate::{
     UnsupportedEnumValueError, VerboseError,
@@ -466,6 +467,21 @@ impl Filename {
     }
 }
 
+/// Case-insensitively compare two filenames without boxing them, for use by
+/// the C++ Filename class when either name is not ASCII.
+pub fn filename_eq(lhs: &str, rhs: &str) -> bool {
+    unicase::eq(lhs, rhs)
+}
+
+pub fn filename_lt(lhs: &str, rhs: &str) -> bool {
+    UniCase::new(lhs) < UniCase::new(rhs)
+}
+
+/// Get the case-folded form of a filename, consistent with [`filename_eq`].
+pub fn filename_folded_case(name: &str) -> String {
+    UniCase::new(name).to_folded_case()
+}
+
 // SAFETY: Filename has #[repr(transparent)]
 unsafe impl TransparentWrapper for Filename {
     type Wrapped = libloot::metadata::Filename;
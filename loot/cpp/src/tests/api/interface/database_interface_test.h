@@ -181,6 +181,31 @@ TEST_P(
   EXPECT_EQ("Loaded from prelude", messages[0].GetContent()[0].GetText());
 }
 
+TEST_P(DatabaseInterfaceTest,
+       loadMasterlistSnapshotShouldThrowIfNoMasterlistIsPresent) {
+  EXPECT_THROW(handle_->GetDatabase().LoadMasterlistSnapshot(masterlistPath),
+               std::runtime_error);
+}
+
+TEST_P(DatabaseInterfaceTest,
+       loadMasterlistSnapshotShouldUseTheSnapshotOnlyIfTheMasterlistIsUnchanged) {
+  ASSERT_NO_THROW(GenerateMasterlist());
+
+  EXPECT_FALSE(handle_->GetDatabase().LoadMasterlistSnapshot(masterlistPath));
+  const auto generalMessages = handle_->GetDatabase().GetGeneralMessages();
+
+  EXPECT_TRUE(handle_->GetDatabase().LoadMasterlistSnapshot(masterlistPath));
+  EXPECT_EQ(generalMessages, handle_->GetDatabase().GetGeneralMessages());
+
+  std::ofstream out(masterlistPath);
+  out << "bash_tags: [Relev]";
+  out.close();
+
+  EXPECT_FALSE(handle_->GetDatabase().LoadMasterlistSnapshot(masterlistPath));
+  EXPECT_EQ(std::vector<std::string>({"Relev"}),
+            handle_->GetDatabase().GetKnownBashTags());
+}
+
 TEST_P(DatabaseInterfaceTest,
        loadUserlistShouldThrowIfAUserlistDoesNotExistAtTheGivenPath) {
   ASSERT_NO_THROW(GenerateMasterlist());
@@ -572,6 +597,97 @@ TEST_P(
   EXPECT_TRUE(metadata.GetMessages().empty());
 }
 
+TEST_P(DatabaseInterfaceTest,
+       getPluginMetadataViewShouldReturnNullIfThePluginHasNoMetadata) {
+  EXPECT_FALSE(handle_->GetDatabase().GetPluginMetadataView(blankEsm));
+}
+
+TEST_P(DatabaseInterfaceTest,
+       getPluginMetadataViewShouldMatchGetPluginMetadataForTheSamePlugin) {
+  ASSERT_NO_THROW(GenerateMasterlist());
+  ASSERT_NO_THROW(GenerateUserlist());
+  ASSERT_NO_THROW(handle_->GetDatabase().LoadMasterlist(masterlistPath));
+  ASSERT_NO_THROW(handle_->GetDatabase().LoadUserlist(userlistPath_));
+
+  const auto expected =
+      handle_->GetDatabase().GetPluginMetadata(blankEsm, true).value();
+  const auto view =
+      handle_->GetDatabase().GetPluginMetadataView(blankEsm, true);
+  ASSERT_NE(nullptr, view);
+
+  EXPECT_EQ(expected.GetName(), view->GetName());
+  EXPECT_EQ(expected.GetGroup(), view->GetGroup());
+  EXPECT_EQ(expected.GetLoadAfterFiles(), view->GetLoadAfterFiles());
+  EXPECT_EQ(expected.GetRequirements(), view->GetRequirements());
+  EXPECT_EQ(expected.GetIncompatibilities(), view->GetIncompatibilities());
+  EXPECT_EQ(expected.GetMessages(), view->GetMessages());
+  EXPECT_EQ(expected.GetTags(), view->GetTags());
+  EXPECT_EQ(expected.GetDirtyInfo(), view->GetDirtyInfo());
+  EXPECT_EQ(expected.GetCleanInfo(), view->GetCleanInfo());
+  EXPECT_EQ(expected.GetLocations(), view->GetLocations());
+  EXPECT_EQ(expected.HasNameOnly(), view->HasNameOnly());
+  EXPECT_EQ(expected.IsRegexPlugin(), view->IsRegexPlugin());
+
+  const auto owned = view->ToOwned();
+  EXPECT_EQ(expected.GetName(), owned.GetName());
+  EXPECT_EQ(expected.GetLoadAfterFiles(), owned.GetLoadAfterFiles());
+  EXPECT_EQ(expected.GetTags(), owned.GetTags());
+}
+
+TEST_P(DatabaseInterfaceTest,
+       getPluginMetadataViewLoadAfterFileNamesShouldMatchTheLoadAfterFiles) {
+  ASSERT_NO_THROW(GenerateMasterlist());
+  ASSERT_NO_THROW(GenerateUserlist());
+  ASSERT_NO_THROW(handle_->GetDatabase().LoadMasterlist(masterlistPath));
+  ASSERT_NO_THROW(handle_->GetDatabase().LoadUserlist(userlistPath_));
+
+  const auto view =
+      handle_->GetDatabase().GetPluginMetadataView(blankEsm, true);
+  ASSERT_NE(nullptr, view);
+
+  const std::vector<std::string_view> expected{blankDifferentEsm, masterFile};
+  EXPECT_EQ(expected, view->GetLoadAfterFileNames());
+  EXPECT_EQ(&view->GetLoadAfterFiles(), &view->GetLoadAfterFiles());
+}
+
+TEST_P(DatabaseInterfaceTest,
+       getPluginsMetadataShouldReturnAnEmptyVectorIfGivenNoPlugins) {
+  EXPECT_TRUE(handle_->GetDatabase().GetPluginsMetadata({}).empty());
+}
+
+TEST_P(DatabaseInterfaceTest,
+       getPluginsMetadataShouldMatchGetPluginMetadataForEachPluginInOrder) {
+  ASSERT_NO_THROW(GenerateMasterlist());
+  ASSERT_NO_THROW(GenerateUserlist());
+  ASSERT_NO_THROW(handle_->GetDatabase().LoadMasterlist(masterlistPath));
+  ASSERT_NO_THROW(handle_->GetDatabase().LoadUserlist(userlistPath_));
+
+  const std::vector<std::string> plugins{
+      blankDifferentEsm, missingEsp, blankEsm, blankDifferentEsp};
+
+  for (const bool includeUserMetadata : {true, false}) {
+    for (const bool evaluateConditions : {true, false}) {
+      const auto metadata = handle_->GetDatabase().GetPluginsMetadata(
+          plugins, includeUserMetadata, evaluateConditions);
+
+      ASSERT_EQ(plugins.size(), metadata.size());
+      for (size_t i = 0; i < plugins.size(); ++i) {
+        const auto expected = handle_->GetDatabase().GetPluginMetadata(
+            plugins[i], includeUserMetadata, evaluateConditions);
+
+        ASSERT_EQ(expected.has_value(), metadata[i].has_value());
+        if (expected.has_value()) {
+          EXPECT_EQ(expected->GetName(), metadata[i]->GetName());
+          EXPECT_EQ(expected->GetLoadAfterFiles(),
+                    metadata[i]->GetLoadAfterFiles());
+          EXPECT_EQ(expected->GetMessages(), metadata[i]->GetMessages());
+          EXPECT_EQ(expected->GetTags(), metadata[i]->GetTags());
+        }
+      }
+    }
+  }
+}
+
 TEST_P(
     DatabaseInterfaceTest,
     getPluginUserMetadataShouldReturnAnEmptyPluginMetadataObjectIfThePluginHasNoUserMetadata) {
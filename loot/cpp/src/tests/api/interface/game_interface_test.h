@@ -274,6 +274,34 @@ TEST_P(GameInterfaceTest, loadPluginsWithANonAsciiPluginShouldLoadIt) {
   EXPECT_EQ(blankEsmCrc, plugin->GetCRC().value());
 }
 
+TEST_P(GameInterfaceTest, loadPluginsShouldWriteCrcsToTheCrcCacheFile) {
+  const auto cachePath = localPath / "plugin-crcs.bin";
+  handle_->SetCrcCachePath(cachePath);
+
+  handle_->LoadPlugins({masterFile}, false);
+
+  EXPECT_TRUE(std::filesystem::exists(cachePath));
+}
+
+TEST_P(GameInterfaceTest, loadPluginsShouldNotWriteTheCrcCacheForHeaders) {
+  const auto cachePath = localPath / "plugin-crcs.bin";
+  handle_->SetCrcCachePath(cachePath);
+
+  handle_->LoadPlugins({masterFile}, true);
+
+  EXPECT_FALSE(std::filesystem::exists(cachePath));
+}
+
+TEST_P(GameInterfaceTest,
+       loadPluginsShouldGetTheCorrectCrcAfterPrewarmingTheCrcCache) {
+  handle_->SetCrcCachePath(localPath / "plugin-crcs.bin");
+  handle_->PrewarmCrcCache({masterFile, blankEsp});
+
+  handle_->LoadPlugins({masterFile}, false);
+
+  EXPECT_EQ(blankEsmCrc, handle_->GetPlugin(masterFile)->GetCRC().value());
+}
+
 TEST_P(
     GameInterfaceTest,
     loadPluginsShouldNotThrowIfAFilenameHasNonWindows1252EncodableCharacters) {
@@ -336,6 +364,30 @@ TEST_P(GameInterfaceTest,
   EXPECT_NE(pointer, newPointer);
 }
 
+TEST_P(GameInterfaceTest,
+       loadPluginsShouldNotReplaceCacheEntriesForOtherPlugins) {
+  handle_->LoadPlugins({std::filesystem::u8path(blankEsm)}, true);
+  const auto pointer = handle_->GetPlugin(blankEsm);
+  ASSERT_NE(nullptr, pointer);
+
+  handle_->LoadPlugins({std::filesystem::u8path(blankEsp)}, true);
+
+  EXPECT_EQ(pointer, handle_->GetPlugin(blankEsm));
+}
+
+TEST_P(GameInterfaceTest,
+       clearLoadedPluginsShouldNotAffectPreviouslyReturnedPlugins) {
+  handle_->LoadPlugins({std::filesystem::u8path(blankEsm)}, true);
+  const auto plugins = handle_->GetLoadedPlugins();
+  ASSERT_EQ(1, plugins.size());
+
+  handle_->ClearLoadedPlugins();
+
+  EXPECT_TRUE(handle_->GetLoadedPlugins().empty());
+  EXPECT_EQ(nullptr, handle_->GetPlugin(blankEsm));
+  EXPECT_EQ(blankEsm, plugins[0]->GetName());
+}
+
 TEST_P(GameInterfaceTest,
        loadPluginsShouldThrowIfGivenVectorElementsWithTheSameFilename) {
   const auto dataPluginPath = dataPath / std::filesystem::u8path(blankEsm);
@@ -526,6 +578,42 @@ TEST_P(GameInterfaceTest,
   EXPECT_TRUE(handle_->GetLoadedPlugins().empty());
 }
 
+TEST_P(GameInterfaceTest,
+       getRecordOverlapPairsShouldReturnNoPluginsIfNoneHaveBeenLoaded) {
+  const auto overlaps = handle_->GetRecordOverlapPairs();
+
+  EXPECT_TRUE(overlaps.GetPlugins().empty());
+  EXPECT_TRUE(overlaps.GetPairs().empty());
+  EXPECT_TRUE(overlaps.GetOverlapCounts().empty());
+}
+
+TEST_P(GameInterfaceTest,
+       getRecordOverlapPairsShouldMatchDoRecordsOverlapForEveryPair) {
+  handle_->LoadPlugins(pluginsToLoad, false);
+
+  const auto overlaps = handle_->GetRecordOverlapPairs();
+  const auto& plugins = overlaps.GetPlugins();
+  ASSERT_EQ(handle_->GetLoadedPlugins().size(), plugins.size());
+  ASSERT_EQ(plugins.size(), overlaps.GetOverlapCounts().size());
+
+  std::vector<std::pair<size_t, size_t>> expectedPairs;
+  std::vector<size_t> expectedCounts(plugins.size(), 0);
+  for (size_t i = 0; i < plugins.size(); ++i) {
+    for (size_t j = i + 1; j < plugins.size(); ++j) {
+      const auto first = handle_->GetPlugin(plugins[i]);
+      const auto second = handle_->GetPlugin(plugins[j]);
+      if (first->DoRecordsOverlap(*second)) {
+        expectedPairs.emplace_back(i, j);
+        ++expectedCounts[i];
+        ++expectedCounts[j];
+      }
+    }
+  }
+
+  EXPECT_EQ(expectedPairs, overlaps.GetPairs());
+  EXPECT_EQ(expectedCounts, overlaps.GetOverlapCounts());
+}
+
 TEST_P(GameInterfaceTest, sortPluginsShouldSucceedIfPassedValidArguments) {
   std::vector<std::string> expectedOrder;
   if (GetParam() == GameType::starfield) {
@@ -577,6 +665,72 @@ TEST_P(GameInterfaceTest, sortPluginsShouldSucceedIfPassedValidArguments) {
   EXPECT_EQ(expectedOrder, actualOrder);
 }
 
+TEST_P(GameInterfaceTest,
+       sortPluginsShouldGiveTheSameResultSequentiallyAndInParallel) {
+  ASSERT_NO_THROW(GenerateMasterlist());
+  ASSERT_NO_THROW(handle_->GetDatabase().LoadMasterlist(masterlistPath));
+
+  handle_->LoadCurrentLoadOrderState();
+  handle_->LoadPlugins(pluginsToLoad, false);
+
+  std::vector<std::string> pluginsToSort;
+  for (const auto& plugin : pluginsToLoad) {
+    pluginsToSort.push_back(plugin.filename().u8string());
+  }
+
+  const auto sequentialOrder = handle_->SortPlugins(pluginsToSort, false);
+  const auto parallelOrder = handle_->SortPlugins(pluginsToSort, true);
+
+  EXPECT_EQ(handle_->SortPlugins(pluginsToSort), parallelOrder);
+  EXPECT_EQ(sequentialOrder, parallelOrder);
+}
+
+TEST_P(GameInterfaceTest,
+       sortPluginsWithStatisticsShouldCountTheSortedPluginsAndTheirEdges) {
+  ASSERT_NO_THROW(GenerateMasterlist());
+  ASSERT_NO_THROW(handle_->GetDatabase().LoadMasterlist(masterlistPath));
+
+  handle_->LoadCurrentLoadOrderState();
+  handle_->LoadPlugins(pluginsToLoad, false);
+
+  std::vector<std::string> pluginsToSort;
+  for (const auto& plugin : pluginsToLoad) {
+    pluginsToSort.push_back(plugin.filename().u8string());
+  }
+
+  SortStatistics statistics;
+  const auto sorted = handle_->SortPlugins(pluginsToSort, false, statistics);
+
+  EXPECT_EQ(handle_->SortPlugins(pluginsToSort, false), sorted);
+  EXPECT_EQ(pluginsToSort.size(), statistics.GetNodeCount());
+  EXPECT_NE(0, statistics.GetEdgeCount(EdgeType::tieBreak));
+  EXPECT_NE(0, statistics.GetTotalEdgeCount());
+  EXPECT_LE(statistics.GetPathSearchCount(), statistics.GetPathQueryCount());
+
+  std::chrono::nanoseconds phasesDuration(0);
+  for (const auto phase : {SortPhase::specificEdges,
+                           SortPhase::groupEdges,
+                           SortPhase::overlapEdges,
+                           SortPhase::tieBreakEdges,
+                           SortPhase::cycleChecks,
+                           SortPhase::topologicalSort}) {
+    phasesDuration += statistics.GetPhaseDuration(phase);
+  }
+  EXPECT_GE(statistics.GetTotalDuration(), phasesDuration);
+}
+
+TEST_P(GameInterfaceTest,
+       sortPluginsWithStatisticsShouldNotChangeTheStatisticsIfSortingFails) {
+  handle_->LoadCurrentLoadOrderState();
+
+  SortStatistics statistics;
+  EXPECT_THROW(handle_->SortPlugins({blankEsp}, false, statistics),
+               PluginNotLoadedError);
+
+  EXPECT_EQ(0, statistics.GetNodeCount());
+  EXPECT_EQ(std::chrono::nanoseconds(0), statistics.GetTotalDuration());
+}
+
 TEST_P(GameInterfaceTest,
        isPluginActiveShouldReturnTrueIfTheGivenPluginIsActive) {
   handle_->LoadCurrentLoadOrderState();
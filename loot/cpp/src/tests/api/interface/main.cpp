@@ -28,6 +28,7 @@
 
 #include "loot/api.h"
 #include "tests/api/interface/metadata/file_test.h"
+#include "tests/api/interface/metadata/filename_test.h"
 #include "tests/api/interface/metadata/group_test.h"
 #include "tests/api/interface/metadata/location_test.h"
 #include "tests/api/interface/metadata/message_content_test.h"
@@ -0,0 +1,97 @@
+/*  LOOT
+
+A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+Fallout: New Vegas.
+
+Copyright (C) 2014-2016    WrinklyNinja
+
+This file is part of LOOT.
+
+LOOT is free software: you can redistribute
+it and/or modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation, either version 3 of
+the License, or (at your option) any later version.
+
+LOOT is distributed in the hope that it will
+be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with LOOT.  If not, see
+<https://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOOT_TESTS_API_INTERFACE_METADATA_FILENAME_TEST
+#define LOOT_TESTS_API_INTERFACE_METADATA_FILENAME_TEST
+
+#include <gtest/gtest.h>
+
+#include <unordered_set>
+
+#include "loot/metadata/filename.h"
+
+namespace loot::test {
+TEST(Filename, equalityShouldBeCaseInsensitive) {
+  EXPECT_EQ(Filename("Blank.esm"), Filename("blank.ESM"));
+  EXPECT_NE(Filename("Blank.esm"), Filename("Blank.esp"));
+  EXPECT_NE(Filename("Blank.esm"), Filename("Blank.es"));
+}
+
+TEST(Filename, equalityShouldCompareLongNamesCaseInsensitively) {
+  EXPECT_EQ(Filename("Blank - Different Master Dependent.esp"),
+            Filename("BLANK - DIFFERENT MASTER DEPENDENT.ESP"));
+  EXPECT_NE(Filename("Blank - Different Master Dependent.esp"),
+            Filename("Blank - Different Master Dependent.esm"));
+}
+
+TEST(Filename, equalityShouldNotTreatAsciiPunctuationAsLetters) {
+  // '@' and '[' are next to 'A' and 'Z', and '`' and '{' are next to 'a' and
+  // 'z'.
+  EXPECT_NE(Filename("@"), Filename("`"));
+  EXPECT_NE(Filename("["), Filename("{"));
+}
+
+TEST(Filename, equalityShouldUseUnicodeCaseFoldingForNonAsciiNames) {
+  EXPECT_EQ(Filename(u8"\u00C9.esp"), Filename(u8"\u00E9.esp"));
+  // KELVIN SIGN folds to an ASCII 'k'.
+  EXPECT_EQ(Filename(u8"\u212A.esp"), Filename("k.esp"));
+  EXPECT_NE(Filename("i.esp"), Filename(u8"\u0130.esp"));
+}
+
+TEST(Filename, lessThanShouldBeCaseInsensitive) {
+  EXPECT_FALSE(Filename("a.esp") < Filename("A.esp"));
+  EXPECT_FALSE(Filename("A.esp") < Filename("a.esp"));
+  EXPECT_TRUE(Filename("a.esp") < Filename("B.esp"));
+  EXPECT_TRUE(Filename("A.esp") < Filename("b.esp"));
+  EXPECT_TRUE(Filename("Blank.esm") < Filename("blank.esm.ghost"));
+  EXPECT_TRUE(Filename("Blank - Different.esm") <
+              Filename("BLANK - MASTER.esm"));
+}
+
+TEST(Filename, lessThanShouldUseUnicodeCaseFoldingForNonAsciiNames) {
+  EXPECT_FALSE(Filename(u8"\u00C9.esp") < Filename(u8"\u00E9.esp"));
+  EXPECT_FALSE(Filename(u8"\u00E9.esp") < Filename(u8"\u00C9.esp"));
+  EXPECT_TRUE(Filename("Z.esp") < Filename(u8"\u00E9.esp"));
+}
+
+TEST(Filename, hashShouldBeEqualForCaseInsensitivelyEqualNames) {
+  const std::hash<Filename> hash;
+
+  EXPECT_EQ(hash(Filename("Blank.esm")), hash(Filename("BLANK.ESM")));
+  EXPECT_EQ(hash(Filename(u8"\u00C9.esp")), hash(Filename(u8"\u00E9.esp")));
+  EXPECT_EQ(hash(Filename(u8"\u212A.esp")), hash(Filename("k.esp")));
+  EXPECT_EQ(hash(Filename()), hash(Filename("")));
+}
+
+TEST(Filename, shouldBeUsableAsAnUnorderedSetKey) {
+  std::unordered_set<Filename> filenames{Filename("Blank.esm"),
+                                         Filename("Blank.esp")};
+
+  EXPECT_EQ(1, filenames.count(Filename("BLANK.ESM")));
+  EXPECT_EQ(0, filenames.count(Filename("Blank.esl")));
+  EXPECT_FALSE(filenames.insert(Filename("blank.esp")).second);
+}
+}
+
+#endif
@@ -243,6 +243,55 @@ TEST_F(PluginMetadataTest, mergeMetadataShouldMergeLocationData) {
             plugin1.GetLocations());
 }
 
+TEST_F(PluginMetadataTest,
+       mergeMetadataShouldDeduplicateLargeListsAndPreserveTheirOrder) {
+  PluginMetadata plugin1;
+  PluginMetadata plugin2;
+
+  std::vector<File> files1;
+  std::vector<File> files2;
+  std::vector<File> expected;
+  for (int i = 0; i < 100; ++i) {
+    files1.push_back(File("Plugin" + std::to_string(i) + ".esp"));
+    expected.push_back(files1.back());
+  }
+  for (int i = 150; i >= 50; --i) {
+    // Filenames compare case-insensitively, so these upper-case duplicates
+    // should be skipped too.
+    files2.push_back(File("PLUGIN" + std::to_string(i) + ".ESP"));
+    if (i >= 100) {
+      expected.push_back(files2.back());
+    }
+  }
+
+  plugin1.SetLoadAfterFiles(files1);
+  plugin2.SetLoadAfterFiles(files2);
+  plugin1.MergeMetadata(plugin2);
+
+  EXPECT_EQ(expected, plugin1.GetLoadAfterFiles());
+}
+
+TEST_F(PluginMetadataTest,
+       mergeMetadataShouldNotDeduplicateElementsOfALargeListBeingMergedIn) {
+  PluginMetadata plugin1;
+  PluginMetadata plugin2;
+  Tag tag("Relev");
+
+  std::vector<Tag> tags1;
+  for (int i = 0; i < 100; ++i) {
+    tags1.push_back(Tag("Tag" + std::to_string(i)));
+  }
+  const std::vector<Tag> tags2(10, tag);
+
+  plugin1.SetTags(tags1);
+  plugin2.SetTags(tags2);
+  plugin1.MergeMetadata(plugin2);
+
+  auto expected = tags1;
+  expected.insert(expected.end(), tags2.begin(), tags2.end());
+  EXPECT_EQ(expected, plugin1.GetTags());
+}
+
 TEST_F(PluginMetadataTest, unsetGroupShouldLeaveNoGroupValueSet) {
   PluginMetadata plugin;
   EXPECT_FALSE(plugin.GetGroup().has_value());
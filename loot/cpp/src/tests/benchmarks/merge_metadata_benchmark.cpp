@@ -0,0 +1,98 @@
+/*  LOOT
+
+    A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+    Fallout: New Vegas.
+
+    Copyright (C) 2012-2016    WrinklyNinja
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "loot/metadata/plugin_metadata.h"
+
+namespace {
+using loot::File;
+using loot::PluginMetadata;
+using loot::Tag;
+
+// Builds masterlist-like and userlist-like metadata for the same plugin, each
+// with the given number of load after files, requirements and tags, where half
+// of the userlist's entries duplicate masterlist entries.
+std::pair<PluginMetadata, PluginMetadata> buildInputs(size_t entries) {
+  PluginMetadata masterlist("Blank.esp");
+  PluginMetadata userlist("Blank.esp");
+
+  std::vector<File> masterlistFiles;
+  std::vector<File> userlistFiles;
+  std::vector<Tag> masterlistTags;
+  std::vector<Tag> userlistTags;
+  for (size_t i = 0; i < entries; ++i) {
+    const auto masterlistName = "Plugin" + std::to_string(i) + ".esp";
+    const auto userlistName =
+        "Plugin" + std::to_string(i + entries / 2) + ".esp";
+
+    masterlistFiles.push_back(File(masterlistName));
+    userlistFiles.push_back(File(userlistName));
+    masterlistTags.push_back(Tag("Tag" + std::to_string(i)));
+    userlistTags.push_back(Tag("Tag" + std::to_string(i + entries / 2)));
+  }
+
+  masterlist.SetLoadAfterFiles(masterlistFiles);
+  masterlist.SetRequirements(masterlistFiles);
+  masterlist.SetTags(masterlistTags);
+  userlist.SetLoadAfterFiles(userlistFiles);
+  userlist.SetRequirements(userlistFiles);
+  userlist.SetTags(userlistTags);
+
+  return {masterlist, userlist};
+}
+
+void benchmarkMergeMetadata(size_t entries, size_t iterations) {
+  const auto [masterlist, userlist] = buildInputs(entries);
+
+  size_t mergedEntries = 0;
+  std::chrono::nanoseconds elapsed(0);
+  for (size_t i = 0; i < iterations; ++i) {
+    auto merged = masterlist;
+
+    const auto start = std::chrono::steady_clock::now();
+    merged.MergeMetadata(userlist);
+    elapsed += std::chrono::steady_clock::now() - start;
+
+    mergedEntries += merged.GetLoadAfterFiles().size();
+  }
+
+  const auto perMerge = elapsed.count() / static_cast<long long>(iterations);
+  std::printf("MergeMetadata/%zu entries: %lld ns per merge (%zu merged)\n",
+              entries,
+              static_cast<long long>(perMerge),
+              mergedEntries / iterations);
+}
+}
+
+int main() {
+  benchmarkMergeMetadata(10, 10000);
+  benchmarkMergeMetadata(100, 1000);
+  benchmarkMergeMetadata(1000, 100);
+
+  return 0;
+}
@@ -0,0 +1,196 @@
+/*  LOOT
+
+    A load order optimisation tool for Oblivion, Skyrim, Fallout 3 and
+    Fallout: New Vegas.
+
+    Copyright (C) 2012-2016    WrinklyNinja
+
+    This file is part of LOOT.
+
+    LOOT is free software: you can redistribute
+    it and/or modify it under the terms of the GNU General Public License
+    as published by the Free Software Foundation, either version 3 of
+    the License, or (at your option) any later version.
+
+    LOOT is distributed in the hope that it will
+    be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with LOOT.  If not, see
+    <https://www.gnu.org/licenses/>.
+    */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "loot/api.h"
+
+namespace {
+constexpr uint32_t BASE_RECORD_COUNT = 512;
+constexpr uint32_t FIRST_FORM_ID = 0x800;
+
+void appendUInt16(std::string& buffer, uint16_t value) {
+  buffer.push_back(static_cast<char>(value & 0xFF));
+  buffer.push_back(static_cast<char>((value >> 8) & 0xFF));
+}
+
+void appendUInt32(std::string& buffer, uint32_t value) {
+  for (int shift = 0; shift < 32; shift += 8) {
+    buffer.push_back(static_cast<char>((value >> shift) & 0xFF));
+  }
+}
+
+void appendSubrecord(std::string& buffer,
+                     const char* type,
+                     const std::string& data) {
+  buffer.append(type, 4);
+  appendUInt16(buffer, static_cast<uint16_t>(data.size()));
+  buffer.append(data);
+}
+
+// Oblivion record and group headers are 20 bytes long.
+void appendRecord(std::string& buffer,
+                  const char* type,
+                  uint32_t flags,
+                  uint32_t formId,
+                  const std::string& data) {
+  buffer.append(type, 4);
+  appendUInt32(buffer, static_cast<uint32_t>(data.size()));
+  appendUInt32(buffer, flags);
+  appendUInt32(buffer, formId);
+  appendUInt32(buffer, 0);
+  buffer.append(data);
+}
+
+// Writes an Oblivion plugin that contains a GLOB record for each of the given
+// FormIDs. FormIDs with a mod index of zero override records in the first
+// master, if there is one.
+void writePlugin(const std::filesystem::path& path,
+                 bool isMaster,
+                 const std::vector<std::string>& masters,
+                 const std::vector<uint32_t>& formIds) {
+  std::string header;
+  std::string hedr;
+  appendUInt32(hedr, 0x3F800000);  // Version 1.0
+  appendUInt32(hedr, static_cast<uint32_t>(formIds.size()));
+  appendUInt32(hedr, FIRST_FORM_ID);
+  appendSubrecord(header, "HEDR", hedr);
+  for (const auto& master : masters) {
+    appendSubrecord(header, "MAST", master + '\0');
+    appendSubrecord(header, "DATA", std::string(8, '\0'));
+  }
+
+  std::string records;
+  for (const auto formId : formIds) {
+    appendRecord(records, "GLOB", 0, formId, "");
+  }
+
+  std::string plugin;
+  appendRecord(plugin, "TES4", isMaster ? 1 : 0, 0, header);
+  plugin.append("GRUP", 4);
+  appendUInt32(plugin, static_cast<uint32_t>(20 + records.size()));
+  plugin.append("GLOB", 4);
+  appendUInt32(plugin, 0);
+  appendUInt32(plugin, 0);
+  plugin.append(records);
+
+  std::ofstream out(path, std::ios::binary);
+  out.write(plugin.data(), static_cast<std::streamsize>(plugin.size()));
+}
+
+// Each plugin overrides a different number of the master's records, starting
+// at different offsets, so that most plugins overlap with many others and
+// sorting needs to add a lot of record overlap edges. Plugins are given
+// timestamps in reverse name order so that the sort needs to reorder them.
+std::vector<std::filesystem::path> createPlugins(
+    const std::filesystem::path& dataPath,
+    size_t pluginCount) {
+  std::vector<uint32_t> baseFormIds;
+  for (uint32_t i = 0; i < BASE_RECORD_COUNT; ++i) {
+    baseFormIds.push_back(FIRST_FORM_ID + i);
+  }
+
+  std::vector<std::filesystem::path> paths{dataPath / "Base.esm"};
+  writePlugin(paths.front(), true, {}, baseFormIds);
+
+  for (size_t i = 0; i < pluginCount; ++i) {
+    const auto overrideCount = 1 + (i * 7) % 32;
+    const auto firstOverride = (i * 13) % BASE_RECORD_COUNT;
+
+    std::vector<uint32_t> formIds;
+    for (size_t j = 0; j < overrideCount; ++j) {
+      formIds.push_back(baseFormIds.at((firstOverride + j) %
+                                       BASE_RECORD_COUNT));
+    }
+
+    const auto name = "Plugin" + std::to_string(i) + ".esp";
+    paths.push_back(dataPath / name);
+    writePlugin(paths.back(), false, {"Base.esm"}, formIds);
+  }
+
+  auto modificationTime = std::filesystem::file_time_type::clock::now();
+  for (auto it = paths.rbegin(); it != paths.rend(); ++it) {
+    std::filesystem::last_write_time(*it, modificationTime);
+    modificationTime += std::chrono::seconds(60);
+  }
+  std::filesystem::last_write_time(paths.front(),
+                                   modificationTime - std::chrono::hours(1000));
+
+  return paths;
+}
+
+void benchmarkSortPlugins(size_t pluginCount, bool sortInParallel) {
+  const auto rootPath = std::filesystem::temp_directory_path() /
+                        "libloot-sort-plugins-benchmark";
+  const auto gamePath = rootPath / "game";
+  const auto localPath = rootPath / "local";
+  const auto dataPath = gamePath / "Data";
+
+  std::filesystem::remove_all(rootPath);
+  std::filesystem::create_directories(dataPath);
+  std::filesystem::create_directories(localPath);
+
+  const auto pluginPaths = createPlugins(dataPath, pluginCount);
+
+  const auto game =
+      loot::CreateGameHandle(loot::GameType::tes4, gamePath, localPath);
+  game->LoadPlugins(pluginPaths, false);
+  game->LoadCurrentLoadOrderState();
+
+  std::vector<std::string> pluginNames;
+  for (const auto& path : pluginPaths) {
+    pluginNames.push_back(path.filename().u8string());
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto sorted = game->SortPlugins(pluginNames, sortInParallel);
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  std::printf("SortPlugins/%zu plugins (%s): %lld ms (%zu sorted)\n",
+              pluginCount,
+              sortInParallel ? "parallel" : "sequential",
+              static_cast<long long>(elapsed.count()),
+              sorted.size());
+
+  std::filesystem::remove_all(rootPath);
+}
+}
+
+int main() {
+  loot::SetLoggingCallback([](loot::LogLevel, std::string_view) {});
+
+  for (const auto pluginCount : {1000, 3000}) {
+    benchmarkSortPlugins(pluginCount, false);
+    benchmarkSortPlugins(pluginCount, true);
+  }
+
+  return 0;
+}
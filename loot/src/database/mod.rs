@@ -4,6 +4,7 @@ mod error;
 use std::{collections::HashMap, path::Path};
 
 use conditions::{evaluate_all_conditions, evaluate_condition, filter_map_on_condition};
+use rayon::iter::{IntoParallelRefIterator, ParallelIterator};
 
 use crate::{
     logging,
@@ -103,6 +104,26 @@ impl Database {
             .load_with_prelude(masterlist_path, prelude_path)
     }
 
+    /// Loads the masterlist from the given path, optionally using the prelude
+    /// at the given path, via a binary snapshot of the parsed metadata.
+    ///
+    /// The snapshot is stored next to the masterlist with a `.snapshot` suffix.
+    /// If it exists and was created by this version of libloot from the same
+    /// masterlist and prelude content, it is loaded instead of parsing the
+    /// masterlist. Otherwise the masterlist is parsed as normal and the
+    /// snapshot is rewritten.
+    ///
+    /// Replaces any existing data that was previously loaded from a masterlist
+    /// and prelude. Returns `true` if the snapshot was used.
+    pub fn load_masterlist_snapshot(
+        &mut self,
+        masterlist_path: &Path,
+        prelude_path: Option<&Path>,
+    ) -> Result<bool, LoadMetadataError> {
+        self.masterlist
+            .load_with_snapshot(masterlist_path, prelude_path)
+    }
+
     /// Loads the userlist from the given path.
     ///
     /// Replaces any existing data that was previously loaded from a userlist.
@@ -266,6 +287,29 @@ impl Database {
         }
     }
 
+    /// Get all loaded metadata for each of the given plugins.
+    ///
+    /// This is equivalent to calling [`Database::plugin_metadata`] for each
+    /// plugin, and the returned vector has the same order as `plugin_names`,
+    /// but plugins are looked up and have their conditions evaluated in
+    /// parallel.
+    ///
+    /// Evaluating plugin metadata conditions does **not** clear the condition
+    /// cache.
+    pub fn plugins_metadata(
+        &self,
+        plugin_names: &[&str],
+        include_user_metadata: MergeMode,
+        evaluate_conditions: EvalMode,
+    ) -> Result<Vec<Option<PluginMetadata>>, MetadataRetrievalError> {
+        plugin_names
+            .par_iter()
+            .map(|plugin_name| {
+                self.plugin_metadata(plugin_name, include_user_metadata, evaluate_conditions)
+            })
+            .collect()
+    }
+
     /// Get a plugin's metadata loaded from the given userlist.
     ///
     /// Evaluating plugin metadata conditions does **not** clear the condition
@@ -475,6 +519,109 @@ plugins:
         assert_eq!(&["Actors.ACBS"], database.known_bash_tags().as_slice());
     }
 
+    mod load_masterlist_snapshot {
+        use super::*;
+
+        #[test]
+        fn should_parse_the_masterlist_and_write_a_snapshot_if_none_exists() {
+            let fixture = Fixture::new(GameType::Oblivion);
+            let mut database = fixture.database();
+
+            let used_snapshot = database
+                .load_masterlist_snapshot(&fixture.metadata_path, Some(&fixture.prelude_path))
+                .unwrap();
+
+            assert!(!used_snapshot);
+            assert!(
+                fixture
+                    .inner
+                    .local_path
+                    .join("metadata.yaml.snapshot")
+                    .exists()
+            );
+            assert_eq!(&["Actors.ACBS"], database.known_bash_tags().as_slice());
+        }
+
+        #[test]
+        fn should_use_the_snapshot_if_the_content_is_unchanged() {
+            let fixture = Fixture::new(GameType::Oblivion);
+            let mut parsed = fixture.database();
+            parsed
+                .load_masterlist_snapshot(&fixture.metadata_path, Some(&fixture.prelude_path))
+                .unwrap();
+
+            let mut database = fixture.database();
+            let used_snapshot = database
+                .load_masterlist_snapshot(&fixture.metadata_path, Some(&fixture.prelude_path))
+                .unwrap();
+
+            assert!(used_snapshot);
+            assert_eq!(parsed.masterlist, database.masterlist);
+        }
+
+        #[test]
+        fn should_not_use_the_snapshot_if_the_prelude_changes() {
+            let fixture = Fixture::new(GameType::Oblivion);
+            let mut database = fixture.database();
+            database
+                .load_masterlist_snapshot(&fixture.metadata_path, Some(&fixture.prelude_path))
+                .unwrap();
+
+            let used_snapshot = database
+                .load_masterlist_snapshot(&fixture.metadata_path, None)
+                .unwrap();
+
+            assert!(!used_snapshot);
+            assert_eq!(&["C.Climate"], database.known_bash_tags().as_slice());
+        }
+
+        #[test]
+        fn should_not_use_the_snapshot_if_the_masterlist_changes() {
+            let fixture = Fixture::new(GameType::Oblivion);
+            let mut database = fixture.database();
+            database
+                .load_masterlist_snapshot(&fixture.metadata_path, None)
+                .unwrap();
+
+            std::fs::write(&fixture.metadata_path, "bash_tags: [Relev]").unwrap();
+
+            let used_snapshot = database
+                .load_masterlist_snapshot(&fixture.metadata_path, None)
+                .unwrap();
+
+            assert!(!used_snapshot);
+            assert_eq!(&["Relev"], database.known_bash_tags().as_slice());
+        }
+
+        #[test]
+        fn should_ignore_a_corrupt_snapshot() {
+            let fixture = Fixture::new(GameType::Oblivion);
+            let mut database = fixture.database();
+
+            let snapshot_path = fixture.inner.local_path.join("metadata.yaml.snapshot");
+            std::fs::write(&snapshot_path, b"LOOTSNAP\xff").unwrap();
+
+            let used_snapshot = database
+                .load_masterlist_snapshot(&fixture.metadata_path, None)
+                .unwrap();
+
+            assert!(!used_snapshot);
+            assert_eq!(&["C.Climate"], database.known_bash_tags().as_slice());
+        }
+
+        #[test]
+        fn should_error_if_the_masterlist_does_not_exist() {
+            let fixture = Fixture::new(GameType::Oblivion);
+            let mut database = fixture.database();
+
+            assert!(
+                database
+                    .load_masterlist_snapshot(&fixture.inner.local_path.join("missing.yaml"), None)
+                    .is_err()
+            );
+        }
+    }
+
     #[test]
     fn load_userlist_should_succeed_if_given_a_valid_path() {
         let fixture = Fixture::new(GameType::Oblivion);
@@ -1093,6 +1240,60 @@ plugins:
         }
     }
 
+    mod plugins_metadata {
+        use super::*;
+
+        #[test]
+        fn should_return_metadata_for_each_plugin_in_the_given_order() {
+            let fixture = Fixture::new(GameType::Oblivion);
+            let mut database = fixture.database();
+
+            database.load_masterlist(&fixture.metadata_path).unwrap();
+
+            let plugin_names = [
+                BLANK_DIFFERENT_ESM,
+                "missing.esp",
+                BLANK_ESM,
+                BLANK_MASTER_DEPENDENT_ESM,
+            ];
+            let metadata = database
+                .plugins_metadata(
+                    &plugin_names,
+                    MergeMode::WithUserMetadata,
+                    EvalMode::DoNotEvaluate,
+                )
+                .unwrap();
+
+            assert_eq!(plugin_names.len(), metadata.len());
+            for (name, metadata) in plugin_names.iter().zip(metadata) {
+                assert_eq!(
+                    database
+                        .plugin_metadata(name, MergeMode::WithUserMetadata, EvalMode::DoNotEvaluate)
+                        .unwrap(),
+                    metadata
+                );
+            }
+        }
+
+        #[test]
+        fn should_evaluate_conditions_if_requested() {
+            let fixture = Fixture::new(GameType::Oblivion);
+            let mut database = fixture.database();
+
+            database.load_masterlist(&fixture.metadata_path).unwrap();
+
+            let metadata = database
+                .plugins_metadata(
+                    &[BLANK_ESM],
+                    MergeMode::WithUserMetadata,
+                    EvalMode::Evaluate,
+                )
+                .unwrap();
+
+            assert!(metadata[0].as_ref().unwrap().messages().is_empty());
+        }
+    }
+
     mod plugin_user_metadata {
         use super::*;
 
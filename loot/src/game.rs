@@ -13,7 +13,7 @@ use crate::{
     database::Database,
     error::{
         DatabaseLockPoisonError, GameHandleCreationError, LoadOrderError, LoadOrderStateError,
-        LoadPluginsError, SortPluginsError,
+        LoadPluginsError, PluginDataError, SortPluginsError,
     },
     escape_ascii,
     logging::{self, format_details, is_log_enabled},
@@ -22,13 +22,14 @@ use crate::{
         plugin_metadata::{GHOST_FILE_EXTENSION, iends_with_ascii},
     },
     plugin::{
-        LoadScope, Plugin,
+        CrcCache, LoadScope, Plugin, RecordOverlaps,
         error::{InvalidFilenameReason, PluginValidationError},
-        plugins_metadata, validate_plugin_path_and_header,
+        find_record_overlaps, plugins_metadata, validate_plugin_path_and_header,
     },
     sorting::{
         groups::build_groups_graph,
-        plugins::{PluginSortingData, sort_plugins},
+        plugins::{PluginSortingData, SortParallelism, sort_plugins_with_statistics},
+        statistics::SortStatistics,
     },
 };
 
@@ -355,6 +356,8 @@ impl Game {
 
         self.store_plugins(plugins)?;
 
+        self.cache.crcs().save_if_dirty();
+
         Ok(())
     }
 
@@ -415,12 +418,60 @@ impl Game {
         Ok(())
     }
 
+    /// Set the file that plugin CRCs are persisted to.
+    ///
+    /// Any CRCs cached in the file are read, replacing the game's currently
+    /// cached CRCs. Loading plugins then only calculates the CRCs of plugins
+    /// that have changed size or modification time since their CRC was cached,
+    /// and writes any new CRCs back to the file. If the file doesn't exist or
+    /// can't be read, it is ignored.
+    pub fn set_crc_cache_path(&mut self, path: &Path) {
+        self.cache.crcs().set_path(path);
+    }
+
+    /// Calculate and cache the CRCs of the plugins at the given paths on a
+    /// background thread, so that a later call to [`Game::load_plugins`] does
+    /// not need to read their content to calculate their CRCs.
+    ///
+    /// Relative paths in `plugin_paths` are resolved relative to the game's
+    /// plugins directory, while absolute paths are used as given. Plugins with
+    /// up-to-date cached CRCs are skipped, and errors are logged but otherwise
+    /// ignored. This function returns immediately.
+    pub fn prewarm_crc_cache(&self, plugin_paths: &[&Path]) {
+        let data_path = data_path(self.base_type, &self.install_path);
+
+        let paths = plugin_paths
+            .iter()
+            .map(|p| resolve_plugin_path(self.base_type, &data_path, p))
+            .collect();
+
+        self.cache.crcs().warm_in_background(paths);
+    }
+
     /// Clears the plugins loaded by previous calls to [`Game::load_plugins`] or
     /// [`Game::load_plugin_headers`].
     pub fn clear_loaded_plugins(&mut self) {
         self.cache.clear_plugins();
     }
 
+    /// Discards the loaded data of the plugins with the given filenames, leaving
+    /// other loaded plugins untouched. Filenames that have not been loaded are
+    /// ignored.
+    ///
+    /// Unloading plugins clears the condition cache in this game's database
+    /// object.
+    pub fn unload_plugins(&mut self, plugin_names: &[&str]) -> Result<(), DatabaseLockPoisonError> {
+        self.cache.remove_plugins(plugin_names);
+
+        let mut database = self.database.write()?;
+        update_loaded_plugin_state(
+            database.condition_evaluator_state_mut(),
+            self.cache.plugins_iter(),
+        );
+
+        Ok(())
+    }
+
     /// Get data for a loaded plugin.
     pub fn plugin(&self, plugin_name: &str) -> Option<Arc<Plugin>> {
         self.cache.plugin(plugin_name).cloned()
@@ -431,6 +482,17 @@ impl Game {
         self.cache.plugins_iter().cloned().collect()
     }
 
+    /// Find every pair of loaded plugins that contain records with the same
+    /// ID.
+    ///
+    /// This gives the same result as calling [`Plugin::do_records_overlap`]
+    /// for every pair of loaded plugins, but checks the pairs in parallel.
+    /// Plugins that have only had their headers loaded don't overlap with any
+    /// other plugins.
+    pub fn record_overlaps(&self) -> Result<RecordOverlaps, PluginDataError> {
+        find_record_overlaps(&self.loaded_plugins())
+    }
+
     /// Calculates a new load order for the game's installed plugins (including
     /// inactive plugins) and returns the sorted order.
     ///
@@ -442,7 +504,35 @@ impl Game {
     /// The order in which plugins are listed in `plugin_filenames` is used as
     /// their current load order. All given plugins must have been already been
     /// loaded using [`Game::load_plugins`] or [`Game::load_plugin_headers`].
+    ///
+    /// The master, non-master and blueprint master partitions of the plugins
+    /// are sorted in parallel: use [`Game::sort_plugins_with_parallelism`] to
+    /// control this.
     pub fn sort_plugins(&self, plugin_names: &[&str]) -> Result<Vec<String>, SortPluginsError> {
+        self.sort_plugins_with_parallelism(plugin_names, SortParallelism::default())
+    }
+
+    /// Calculates a new load order for the game's installed plugins, as
+    /// [`Game::sort_plugins`] does, using the given parallelism.
+    ///
+    /// The sorted order does not depend on the parallelism.
+    pub fn sort_plugins_with_parallelism(
+        &self,
+        plugin_names: &[&str],
+        parallelism: SortParallelism,
+    ) -> Result<Vec<String>, SortPluginsError> {
+        self.sort_plugins_with_statistics(plugin_names, parallelism)
+            .map(|(load_order, _)| load_order)
+    }
+
+    /// Calculates a new load order for the game's installed plugins, as
+    /// [`Game::sort_plugins_with_parallelism`] does, and also returns timings
+    /// and counts for the phases of the sort.
+    pub fn sort_plugins_with_statistics(
+        &self,
+        plugin_names: &[&str],
+        parallelism: SortParallelism,
+    ) -> Result<(Vec<String>, SortStatistics), SortPluginsError> {
         let plugins = plugin_names
             .iter()
             .map(|n| {
@@ -472,10 +562,11 @@ impl Game {
             database.user_groups(),
         )?;
 
-        let new_load_order = sort_plugins(
+        let (new_load_order, statistics) = sort_plugins_with_statistics(
             plugins_sorting_data,
             &groups_graph,
             self.load_order.game_settings().early_loading_plugins(),
+            parallelism,
         )?;
 
         if is_log_enabled(LogLevel::Debug) {
@@ -485,7 +576,7 @@ impl Game {
             }
         }
 
-        Ok(new_load_order)
+        Ok((new_load_order, statistics))
     }
 
     /// Load the current load order state, discarding any previously held state.
@@ -785,13 +876,19 @@ fn to_plugin_sorting_data<'a>(
     .map_err(Into::into)
 }
 
-#[derive(Clone, Debug, Default, Eq, PartialEq)]
+#[derive(Clone, Debug, Default)]
 pub(crate) struct GameCache {
     plugins: HashMap<Filename, Arc<Plugin>>,
     archive_paths: HashSet<PathBuf>,
+    // Shared so that the cache can be warmed on a background thread.
+    crcs: Arc<CrcCache>,
 }
 
 impl GameCache {
+    pub(crate) fn crcs(&self) -> &Arc<CrcCache> {
+        &self.crcs
+    }
+
     pub(crate) fn set_archive_paths(&mut self, archive_paths: Vec<PathBuf>) {
         self.archive_paths.clear();
         self.archive_paths.extend(archive_paths);
@@ -804,6 +901,13 @@ impl GameCache {
         }
     }
 
+    fn remove_plugins(&mut self, plugin_names: &[&str]) {
+        for plugin_name in plugin_names {
+            self.plugins
+                .remove(&Filename::new((*plugin_name).to_owned()));
+        }
+    }
+
     fn clear_plugins(&mut self) {
         self.plugins.clear();
     }
@@ -1918,6 +2022,188 @@ mod tests {
             assert!(game.cache.plugins.is_empty());
         }
 
+        #[test]
+        fn unload_plugins_should_only_remove_the_given_plugins() {
+            let fixture = Fixture::new(GameType::Oblivion);
+
+            let mut game =
+                Game::with_local_path(fixture.game_type, &fixture.game_path, &fixture.local_path)
+                    .unwrap();
+
+            game.load_plugin_headers(&[Path::new(BLANK_ESM), Path::new(BLANK_ESP)])
+                .unwrap();
+
+            game.unload_plugins(&[&BLANK_ESP.to_lowercase(), "missing.esp"])
+                .unwrap();
+
+            assert!(game.plugin(BLANK_ESM).is_some());
+            assert!(game.plugin(BLANK_ESP).is_none());
+        }
+
+        mod crc_cache {
+            use super::*;
+
+            #[test]
+            fn load_plugins_should_write_crcs_to_the_cache_path() {
+                let fixture = Fixture::new(GameType::Oblivion);
+                let cache_path = fixture.local_path.join("crcs.bin");
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+                game.set_crc_cache_path(&cache_path);
+
+                game.load_plugins(&[Path::new(BLANK_ESM)]).unwrap();
+
+                assert!(cache_path.exists());
+
+                let mut other_game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+                other_game.set_crc_cache_path(&cache_path);
+
+                let plugin_path = data_path(game.base_type, &game.install_path).join(BLANK_ESM);
+                assert_eq!(
+                    game.plugin(BLANK_ESM).unwrap().crc(),
+                    other_game.cache.crcs().cached_crc(&plugin_path)
+                );
+            }
+
+            #[test]
+            fn load_plugin_headers_should_use_an_up_to_date_cached_crc() {
+                let fixture = Fixture::new(GameType::Oblivion);
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                game.load_plugin_headers(&[Path::new(BLANK_ESM)]).unwrap();
+                assert!(game.plugin(BLANK_ESM).unwrap().crc().is_none());
+
+                let plugin_path = data_path(game.base_type, &game.install_path).join(BLANK_ESM);
+                game.cache.crcs().warm(&[plugin_path]);
+
+                game.load_plugin_headers(&[Path::new(BLANK_ESM)]).unwrap();
+                assert!(game.plugin(BLANK_ESM).unwrap().crc().is_some());
+            }
+
+            #[test]
+            fn load_plugin_headers_should_not_write_the_cache() {
+                let fixture = Fixture::new(GameType::Oblivion);
+                let cache_path = fixture.local_path.join("crcs.bin");
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+                game.set_crc_cache_path(&cache_path);
+
+                game.load_plugin_headers(&[Path::new(BLANK_ESM)]).unwrap();
+
+                assert!(!cache_path.exists());
+            }
+        }
+
+        mod record_overlaps {
+            use super::*;
+
+            #[test]
+            fn should_be_empty_if_no_plugins_are_loaded() {
+                let fixture = Fixture::new(GameType::Oblivion);
+
+                let game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                let overlaps = game.record_overlaps().unwrap();
+
+                assert!(overlaps.plugin_names().is_empty());
+                assert!(overlaps.pairs().is_empty());
+                assert!(overlaps.overlap_counts().is_empty());
+            }
+
+            #[test]
+            fn should_not_find_overlaps_between_plugins_with_only_headers_loaded() {
+                let fixture = Fixture::new(GameType::Oblivion);
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                game.load_plugin_headers(&[
+                    Path::new(BLANK_ESM),
+                    Path::new(BLANK_MASTER_DEPENDENT_ESM),
+                ])
+                .unwrap();
+
+                let overlaps = game.record_overlaps().unwrap();
+
+                assert_eq!(
+                    &[BLANK_MASTER_DEPENDENT_ESM, BLANK_ESM],
+                    overlaps.plugin_names()
+                );
+                assert!(overlaps.pairs().is_empty());
+                assert_eq!(&[0_usize, 0], overlaps.overlap_counts());
+            }
+
+            #[parameterized_test(ALL_GAME_TYPES)]
+            fn should_match_do_records_overlap_for_every_pair_of_plugins(game_type: GameType) {
+                let fixture = Fixture::new(game_type);
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                game.load_plugins(&[
+                    Path::new(BLANK_ESM),
+                    Path::new(BLANK_ESP),
+                    Path::new(BLANK_DIFFERENT_ESM),
+                    Path::new(BLANK_MASTER_DEPENDENT_ESM),
+                ])
+                .unwrap();
+
+                let overlaps = game.record_overlaps().unwrap();
+                let names = overlaps.plugin_names();
+
+                let mut expected_pairs = Vec::new();
+                let mut expected_counts = vec![0_usize; names.len()];
+                for (i, first) in names.iter().enumerate() {
+                    for (j, second) in names.iter().enumerate().skip(i + 1) {
+                        let first = game.plugin(first).unwrap();
+                        let second = game.plugin(second).unwrap();
+                        if first.do_records_overlap(&second).unwrap() {
+                            expected_pairs.push((i, j));
+                            expected_counts[i] += 1;
+                            expected_counts[j] += 1;
+                        }
+                    }
+                }
+
+                assert_eq!(expected_pairs, overlaps.pairs());
+                assert_eq!(expected_counts, overlaps.overlap_counts());
+            }
+        }
+
         mod sort_plugins {
             use crate::tests::initial_load_order;
 
@@ -1978,6 +2264,59 @@ mod tests {
 
                 assert!(game.sort_plugins(&[BLANK_ESP]).is_err());
             }
+
+            #[test]
+            fn should_give_the_same_result_sequentially_and_in_parallel() {
+                let fixture = Fixture::new(GameType::Oblivion);
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                load_all_installed_plugins(&mut game, &fixture);
+
+                let load_order = initial_load_order(fixture.game_type);
+                let input: Vec<_> = load_order.iter().map(|(n, _)| *n).collect();
+
+                let sequential = game
+                    .sort_plugins_with_parallelism(&input, SortParallelism::Sequential)
+                    .unwrap();
+                let parallel = game
+                    .sort_plugins_with_parallelism(&input, SortParallelism::Parallel)
+                    .unwrap();
+
+                assert_eq!(sequential, parallel);
+            }
+
+            #[test]
+            fn with_statistics_should_return_the_same_load_order_and_count_the_sorted_plugins() {
+                let fixture = Fixture::new(GameType::Oblivion);
+
+                let mut game = Game::with_local_path(
+                    fixture.game_type,
+                    &fixture.game_path,
+                    &fixture.local_path,
+                )
+                .unwrap();
+
+                load_all_installed_plugins(&mut game, &fixture);
+
+                let load_order = initial_load_order(fixture.game_type);
+                let input: Vec<_> = load_order.iter().map(|(n, _)| *n).collect();
+
+                let sorted = game.sort_plugins(&input).unwrap();
+                let (sorted_with_statistics, statistics) = game
+                    .sort_plugins_with_statistics(&input, SortParallelism::default())
+                    .unwrap();
+
+                assert_eq!(sorted, sorted_with_statistics);
+                assert_eq!(input.len(), statistics.node_count());
+                assert_ne!(0, statistics.edge_count(crate::EdgeType::TieBreak));
+                assert!(statistics.total_duration() > std::time::Duration::ZERO);
+            }
         }
 
         mod is_plugin_active {
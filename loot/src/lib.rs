@@ -34,8 +34,12 @@ use regress::{Error as RegexImplError, Regex};
 pub use database::{Database, EvalMode, MergeMode, WriteMode};
 pub use game::{Game, GameType};
 pub use logging::{LogLevel, set_log_level, set_logging_callback};
-pub use plugin::Plugin;
-pub use sorting::vertex::{EdgeType, Vertex};
+pub use plugin::{Plugin, RecordOverlaps};
+pub use sorting::{
+    plugins::SortParallelism,
+    statistics::{SortPhase, SortStatistics},
+    vertex::{EdgeType, Vertex},
+};
 pub use version::{
     LIBLOOT_VERSION_MAJOR, LIBLOOT_VERSION_MINOR, LIBLOOT_VERSION_PATCH, is_compatible,
     libloot_revision, libloot_version,
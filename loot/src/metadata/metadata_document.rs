@@ -16,6 +16,7 @@ use super::{
     group::Group,
     message::Message,
     plugin_metadata::PluginMetadata,
+    snapshot::{self, SnapshotKey},
     yaml::{
         EmitYaml, TryFromYaml, YamlEmitter, YamlObjectType, get_slice_value, process_merge_keys,
     },
@@ -93,6 +94,110 @@ impl MetadataDocument {
         Ok(())
     }
 
+    /// Load the masterlist (and optional prelude), using a binary snapshot
+    /// stored alongside the masterlist if one exists and was created from the
+    /// same content. If the snapshot can't be used, the masterlist is parsed
+    /// and a new snapshot is written.
+    ///
+    /// Returns true if the metadata was loaded from a snapshot.
+    pub(crate) fn load_with_snapshot(
+        &mut self,
+        masterlist_path: &Path,
+        prelude_path: Option<&Path>,
+    ) -> Result<bool, LoadMetadataError> {
+        if !masterlist_path.exists() {
+            return Err(LoadMetadataError::new(
+                masterlist_path.into(),
+                MetadataDocumentParsingError::PathNotFound,
+            ));
+        }
+
+        if let Some(prelude_path) = prelude_path {
+            if !prelude_path.exists() {
+                return Err(LoadMetadataError::new(
+                    prelude_path.into(),
+                    MetadataDocumentParsingError::PathNotFound,
+                ));
+            }
+        }
+
+        let masterlist = std::fs::read_to_string(masterlist_path)
+            .map_err(|e| LoadMetadataError::from_io_error(masterlist_path.into(), e))?;
+
+        let prelude = prelude_path
+            .map(|p| {
+                std::fs::read_to_string(p)
+                    .map_err(|e| LoadMetadataError::from_io_error(p.into(), e))
+            })
+            .transpose()?;
+
+        let key = SnapshotKey::new(&masterlist, prelude.as_deref());
+        let snapshot_path = snapshot::snapshot_path(masterlist_path);
+
+        match snapshot::read(&snapshot_path, &key) {
+            Ok(document) => {
+                *self = document;
+
+                logging::trace!(
+                    "Successfully loaded metadata from snapshot at \"{}\".",
+                    escape_ascii(&snapshot_path)
+                );
+
+                return Ok(true);
+            }
+            Err(e) => logging::debug!(
+                "Could not use masterlist snapshot at \"{}\": {}",
+                escape_ascii(&snapshot_path),
+                e
+            ),
+        }
+
+        let masterlist = match prelude {
+            Some(prelude) => replace_prelude(masterlist, &prelude),
+            None => masterlist,
+        };
+
+        self.load_from_str(&masterlist)
+            .map_err(|e| LoadMetadataError::new(masterlist_path.into(), e))?;
+
+        logging::trace!(
+            "Successfully loaded metadata from file at \"{}\".",
+            escape_ascii(masterlist_path)
+        );
+
+        // Failing to write a snapshot only costs time on the next load.
+        if let Err(e) = snapshot::write(self, &snapshot_path, &key) {
+            logging::warn!(
+                "Failed to write masterlist snapshot to \"{}\": {}",
+                escape_ascii(&snapshot_path),
+                e
+            );
+        }
+
+        Ok(false)
+    }
+
+    pub(super) fn from_parts(
+        bash_tags: Vec<String>,
+        groups: Vec<Group>,
+        messages: Vec<Message>,
+        plugins: Vec<PluginMetadata>,
+    ) -> Self {
+        let mut document = Self {
+            bash_tags,
+            groups,
+            messages,
+            plugins: HashMap::new(),
+            regex_plugins: Vec::new(),
+        };
+
+        for plugin in plugins {
+            document.set_plugin_metadata(plugin);
+        }
+
+        document
+    }
+
     fn load_from_str(&mut self, string: &str) -> Result<(), MetadataDocumentParsingError> {
         let mut docs = MarkedYaml::load_from_str(string)?;
 
@@ -7,6 +7,7 @@ mod message;
 pub(crate) mod metadata_document;
 mod plugin_cleaning_data;
 pub(crate) mod plugin_metadata;
+pub(crate) mod snapshot;
 mod tag;
 mod yaml;
 
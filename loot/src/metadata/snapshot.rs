@@ -0,0 +1,647 @@
+//! A compact binary encoding of a parsed metadata document, used to avoid
+//! re-parsing an unchanged masterlist's YAML.
+use std::{
+    ffi::OsString,
+    num::TryFromIntError,
+    path::{Path, PathBuf},
+    str::Utf8Error,
+};
+
+use crate::version::libloot_version;
+
+use super::{
+    file::File,
+    group::Group,
+    location::Location,
+    message::{Message, MessageContent, MessageType},
+    metadata_document::MetadataDocument,
+    plugin_cleaning_data::PluginCleaningData,
+    plugin_metadata::PluginMetadata,
+    tag::{Tag, TagSuggestion},
+};
+
+const MAGIC: &[u8; 8] = b"LOOTSNAP";
+
+/// Incremented whenever the encoding changes in an incompatible way.
+const FORMAT_VERSION: u32 = 1;
+
+const SNAPSHOT_EXTENSION: &str = ".snapshot";
+
+/// Identifies the source content that a snapshot was created from.
+#[derive(Clone, Copy, Debug, Eq, PartialEq)]
+pub(crate) struct SnapshotKey {
+    crc: u32,
+    length: u64,
+}
+
+impl SnapshotKey {
+    pub(crate) fn new(masterlist: &str, prelude: Option<&str>) -> Self {
+        let mut hasher = crc32fast::Hasher::new();
+        hasher.update(masterlist.as_bytes());
+        let mut length = masterlist.len();
+
+        if let Some(prelude) = prelude {
+            // Separate the two inputs so that moving bytes between them
+            // changes the key.
+            hasher.update(&[0]);
+            hasher.update(prelude.as_bytes());
+            length = length.saturating_add(prelude.len()).saturating_add(1);
+        }
+
+        Self {
+            crc: hasher.finalize(),
+            length: u64::try_from(length).unwrap_or(u64::MAX),
+        }
+    }
+}
+
+#[derive(Clone, Copy, Debug, Eq, PartialEq)]
+pub(crate) enum SnapshotError {
+    Io(std::io::ErrorKind),
+    UnrecognisedFormat,
+    VersionMismatch,
+    KeyMismatch,
+    UnexpectedEndOfData,
+    TrailingData,
+    InvalidValue,
+}
+
+impl std::fmt::Display for SnapshotError {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        match self {
+            Self::Io(kind) => write!(f, "an I/O error occurred: {kind}"),
+            Self::UnrecognisedFormat => write!(f, "the file is not a metadata snapshot"),
+            Self::VersionMismatch => {
+                write!(f, "the snapshot was written by a different libloot version")
+            }
+            Self::KeyMismatch => write!(f, "the snapshot was created from different content"),
+            Self::UnexpectedEndOfData => write!(f, "the snapshot data is truncated"),
+            Self::TrailingData => write!(f, "the snapshot has unexpected trailing data"),
+            Self::InvalidValue => write!(f, "the snapshot contains an invalid value"),
+        }
+    }
+}
+
+impl std::error::Error for SnapshotError {}
+
+impl From<std::io::Error> for SnapshotError {
+    fn from(value: std::io::Error) -> Self {
+        Self::Io(value.kind())
+    }
+}
+
+impl From<TryFromIntError> for SnapshotError {
+    fn from(_value: TryFromIntError) -> Self {
+        Self::InvalidValue
+    }
+}
+
+impl From<Utf8Error> for SnapshotError {
+    fn from(_value: Utf8Error) -> Self {
+        Self::InvalidValue
+    }
+}
+
+/// Get the path of the snapshot that is stored alongside the given masterlist.
+pub(crate) fn snapshot_path(masterlist_path: &Path) -> PathBuf {
+    let mut path = OsString::from(masterlist_path.as_os_str());
+    path.push(SNAPSHOT_EXTENSION);
+    PathBuf::from(path)
+}
+
+/// Read the snapshot at the given path, checking that it was created by this
+/// libloot version from content matching the given key.
+pub(crate) fn read(path: &Path, key: &SnapshotKey) -> Result<MetadataDocument, SnapshotError> {
+    let bytes = std::fs::read(path)?;
+
+    decode(&bytes, key)
+}
+
+/// Write a snapshot of the given document to the given path.
+pub(crate) fn write(
+    document: &MetadataDocument,
+    path: &Path,
+    key: &SnapshotKey,
+) -> Result<(), SnapshotError> {
+    let bytes = encode(document, key)?;
+
+    write_atomically(path, &bytes)
+}
+
+/// Write the given bytes to a temporary file next to the given path and then
+/// move it into place, so that readers never see a partially written file.
+pub(crate) fn write_atomically(path: &Path, bytes: &[u8]) -> Result<(), SnapshotError> {
+    let mut temp_path = OsString::from(path.as_os_str());
+    temp_path.push(".tmp");
+    let temp_path = PathBuf::from(temp_path);
+
+    std::fs::write(&temp_path, bytes)?;
+    std::fs::rename(&temp_path, path)?;
+
+    Ok(())
+}
+
+pub(crate) fn encode(
+    document: &MetadataDocument,
+    key: &SnapshotKey,
+) -> Result<Vec<u8>, SnapshotError> {
+    let mut encoder = Encoder::default();
+
+    encoder.bytes(MAGIC);
+    encoder.u32(FORMAT_VERSION);
+    encoder.str(&libloot_version())?;
+    encoder.u32(key.crc);
+    encoder.u64(key.length);
+
+    encoder.slice(document.bash_tags(), |e, t| e.str(t))?;
+    encoder.slice(document.groups(), encode_group)?;
+    encoder.slice(document.messages(), encode_message)?;
+
+    let plugins: Vec<&PluginMetadata> = document.plugins_iter().collect();
+    encoder.slice(&plugins, |e, p| encode_plugin(e, p))?;
+
+    Ok(encoder.buffer)
+}
+
+pub(crate) fn decode(bytes: &[u8], key: &SnapshotKey) -> Result<MetadataDocument, SnapshotError> {
+    let mut decoder = Decoder::new(bytes);
+
+    if decoder.take(MAGIC.len())? != MAGIC {
+        return Err(SnapshotError::UnrecognisedFormat);
+    }
+
+    if decoder.u32()? != FORMAT_VERSION || decoder.str()? != libloot_version() {
+        return Err(SnapshotError::VersionMismatch);
+    }
+
+    let stored_key = SnapshotKey {
+        crc: decoder.u32()?,
+        length: decoder.u64()?,
+    };
+    if stored_key != *key {
+        return Err(SnapshotError::KeyMismatch);
+    }
+
+    let bash_tags = decoder.vec(|d| d.string())?;
+    let groups = decoder.vec(decode_group)?;
+    let messages = decoder.vec(decode_message)?;
+    let plugins = decoder.vec(decode_plugin)?;
+
+    decoder.finish()?;
+
+    Ok(MetadataDocument::from_parts(
+        bash_tags, groups, messages, plugins,
+    ))
+}
+
+#[derive(Debug, Default)]
+pub(crate) struct Encoder {
+    buffer: Vec<u8>,
+}
+
+impl Encoder {
+    pub(crate) fn into_bytes(self) -> Vec<u8> {
+        self.buffer
+    }
+
+    pub(crate) fn bytes(&mut self, bytes: &[u8]) {
+        self.buffer.extend_from_slice(bytes);
+    }
+
+    pub(crate) fn u8(&mut self, value: u8) {
+        self.buffer.push(value);
+    }
+
+    pub(crate) fn u32(&mut self, value: u32) {
+        self.bytes(&value.to_le_bytes());
+    }
+
+    pub(crate) fn u64(&mut self, value: u64) {
+        self.bytes(&value.to_le_bytes());
+    }
+
+    pub(crate) fn len(&mut self, length: usize) -> Result<(), SnapshotError> {
+        self.u32(u32::try_from(length)?);
+        Ok(())
+    }
+
+    pub(crate) fn str(&mut self, value: &str) -> Result<(), SnapshotError> {
+        self.len(value.len())?;
+        self.bytes(value.as_bytes());
+        Ok(())
+    }
+
+    pub(crate) fn optional_str(&mut self, value: Option<&str>) -> Result<(), SnapshotError> {
+        match value {
+            Some(value) => {
+                self.u8(1);
+                self.str(value)
+            }
+            None => {
+                self.u8(0);
+                Ok(())
+            }
+        }
+    }
+
+    pub(crate) fn slice<T>(
+        &mut self,
+        values: &[T],
+        mut encode: impl FnMut(&mut Self, &T) -> Result<(), SnapshotError>,
+    ) -> Result<(), SnapshotError> {
+        self.len(values.len())?;
+        for value in values {
+            encode(self, value)?;
+        }
+        Ok(())
+    }
+}
+
+#[derive(Debug)]
+pub(crate) struct Decoder<'a> {
+    bytes: &'a [u8],
+}
+
+impl<'a> Decoder<'a> {
+    pub(crate) fn new(bytes: &'a [u8]) -> Self {
+        Self { bytes }
+    }
+
+    /// Check that all the data has been decoded.
+    pub(crate) fn finish(self) -> Result<(), SnapshotError> {
+        if self.bytes.is_empty() {
+            Ok(())
+        } else {
+            Err(SnapshotError::TrailingData)
+        }
+    }
+
+    pub(crate) fn take(&mut self, count: usize) -> Result<&'a [u8], SnapshotError> {
+        let (head, tail) = self
+            .bytes
+            .split_at_checked(count)
+            .ok_or(SnapshotError::UnexpectedEndOfData)?;
+        self.bytes = tail;
+        Ok(head)
+    }
+
+    fn array<const N: usize>(&mut self) -> Result<[u8; N], SnapshotError> {
+        let mut array = [0; N];
+        array.copy_from_slice(self.take(N)?);
+        Ok(array)
+    }
+
+    pub(crate) fn u8(&mut self) -> Result<u8, SnapshotError> {
+        let [value] = self.array::<1>()?;
+        Ok(value)
+    }
+
+    pub(crate) fn u32(&mut self) -> Result<u32, SnapshotError> {
+        Ok(u32::from_le_bytes(self.array()?))
+    }
+
+    pub(crate) fn u64(&mut self) -> Result<u64, SnapshotError> {
+        Ok(u64::from_le_bytes(self.array()?))
+    }
+
+    pub(crate) fn len(&mut self) -> Result<usize, SnapshotError> {
+        Ok(usize::try_from(self.u32()?)?)
+    }
+
+    pub(crate) fn str(&mut self) -> Result<&'a str, SnapshotError> {
+        let length = self.len()?;
+        Ok(std::str::from_utf8(self.take(length)?)?)
+    }
+
+    pub(crate) fn string(&mut self) -> Result<String, SnapshotError> {
+        self.str().map(str::to_owned)
+    }
+
+    pub(crate) fn optional_string(&mut self) -> Result<Option<String>, SnapshotError> {
+        match self.u8()? {
+            0 => Ok(None),
+            1 => self.string().map(Some),
+            _ => Err(SnapshotError::InvalidValue),
+        }
+    }
+
+    pub(crate) fn vec<T>(
+        &mut self,
+        mut decode: impl FnMut(&mut Self) -> Result<T, SnapshotError>,
+    ) -> Result<Vec<T>, SnapshotError> {
+        let count = self.len()?;
+        // Don't trust the count for preallocation, a corrupt value could be
+        // huge.
+        let mut values = Vec::with_capacity(count.min(self.bytes.len()));
+        for _ in 0..count {
+            values.push(decode(self)?);
+        }
+        Ok(values)
+    }
+}
+
+fn encode_message_contents(
+    encoder: &mut Encoder,
+    contents: &[MessageContent],
+) -> Result<(), SnapshotError> {
+    encoder.slice(contents, |e, c| {
+        e.str(c.text())?;
+        e.str(c.language())
+    })
+}
+
+fn decode_message_contents(
+    decoder: &mut Decoder<'_>,
+) -> Result<Vec<MessageContent>, SnapshotError> {
+    decoder.vec(|d| {
+        let text = d.string()?;
+        let language = d.string()?;
+        Ok(MessageContent::new(text).with_language(language))
+    })
+}
+
+fn encode_group(encoder: &mut Encoder, group: &Group) -> Result<(), SnapshotError> {
+    encoder.str(group.name())?;
+    encoder.optional_str(group.description())?;
+    encoder.slice(group.after_groups(), |e, g| e.str(g))
+}
+
+fn decode_group(decoder: &mut Decoder<'_>) -> Result<Group, SnapshotError> {
+    let mut group = Group::new(decoder.string()?);
+    if let Some(description) = decoder.optional_string()? {
+        group = group.with_description(description);
+    }
+    Ok(group.with_after_groups(decoder.vec(|d| d.string())?))
+}
+
+fn encode_message(encoder: &mut Encoder, message: &Message) -> Result<(), SnapshotError> {
+    encoder.u8(match message.message_type() {
+        MessageType::Say => 0,
+        MessageType::Warn => 1,
+        MessageType::Error => 2,
+    });
+    encode_message_contents(encoder, message.content())?;
+    encoder.optional_str(message.condition())
+}
+
+fn decode_message(decoder: &mut Decoder<'_>) -> Result<Message, SnapshotError> {
+    let message_type = match decoder.u8()? {
+        0 => MessageType::Say,
+        1 => MessageType::Warn,
+        2 => MessageType::Error,
+        _ => return Err(SnapshotError::InvalidValue),
+    };
+    let contents = decode_message_contents(decoder)?;
+    let mut message =
+        Message::multilingual(message_type, contents).map_err(|_e| SnapshotError::InvalidValue)?;
+    if let Some(condition) = decoder.optional_string()? {
+        message = message.with_condition(condition);
+    }
+    Ok(message)
+}
+
+fn encode_file(encoder: &mut Encoder, file: &File) -> Result<(), SnapshotError> {
+    encoder.str(file.name().as_str())?;
+    encoder.optional_str(file.display_name())?;
+    encode_message_contents(encoder, file.detail())?;
+    encoder.optional_str(file.condition())?;
+    encoder.optional_str(file.constraint())
+}
+
+fn decode_file(decoder: &mut Decoder<'_>) -> Result<File, SnapshotError> {
+    let mut file = File::new(decoder.string()?);
+    if let Some(display_name) = decoder.optional_string()? {
+        file = file.with_display_name(display_name);
+    }
+    file = file
+        .with_detail(decode_message_contents(decoder)?)
+        .map_err(|_e| SnapshotError::InvalidValue)?;
+    if let Some(condition) = decoder.optional_string()? {
+        file = file.with_condition(condition);
+    }
+    if let Some(constraint) = decoder.optional_string()? {
+        file = file.with_constraint(constraint);
+    }
+    Ok(file)
+}
+
+fn encode_tag(encoder: &mut Encoder, tag: &Tag) -> Result<(), SnapshotError> {
+    encoder.str(tag.name())?;
+    encoder.u8(u8::from(tag.is_addition()));
+    encoder.optional_str(tag.condition())
+}
+
+fn decode_tag(decoder: &mut Decoder<'_>) -> Result<Tag, SnapshotError> {
+    let name = decoder.string()?;
+    let suggestion = match decoder.u8()? {
+        0 => TagSuggestion::Removal,
+        1 => TagSuggestion::Addition,
+        _ => return Err(SnapshotError::InvalidValue),
+    };
+    let mut tag = Tag::new(name, suggestion);
+    if let Some(condition) = decoder.optional_string()? {
+        tag = tag.with_condition(condition);
+    }
+    Ok(tag)
+}
+
+fn encode_cleaning_data(
+    encoder: &mut Encoder,
+    data: &PluginCleaningData,
+) -> Result<(), SnapshotError> {
+    encoder.u32(data.crc());
+    encoder.str(data.cleaning_utility())?;
+    encoder.u32(data.itm_count());
+    encoder.u32(data.deleted_reference_count());
+    encoder.u32(data.deleted_navmesh_count());
+    encode_message_contents(encoder, data.detail())
+}
+
+fn decode_cleaning_data(decoder: &mut Decoder<'_>) -> Result<PluginCleaningData, SnapshotError> {
+    let crc = decoder.u32()?;
+    let utility = decoder.string()?;
+    PluginCleaningData::new(crc, utility)
+        .with_itm_count(decoder.u32()?)
+        .with_deleted_reference_count(decoder.u32()?)
+        .with_deleted_navmesh_count(decoder.u32()?)
+        .with_detail(decode_message_contents(decoder)?)
+        .map_err(|_e| SnapshotError::InvalidValue)
+}
+
+fn encode_location(encoder: &mut Encoder, location: &Location) -> Result<(), SnapshotError> {
+    encoder.str(location.url())?;
+    encoder.optional_str(location.name())
+}
+
+fn decode_location(decoder: &mut Decoder<'_>) -> Result<Location, SnapshotError> {
+    let mut location = Location::new(decoder.string()?);
+    if let Some(name) = decoder.optional_string()? {
+        location = location.with_name(name);
+    }
+    Ok(location)
+}
+
+fn encode_plugin(encoder: &mut Encoder, plugin: &PluginMetadata) -> Result<(), SnapshotError> {
+    encoder.str(plugin.name())?;
+    encoder.optional_str(plugin.group())?;
+    encoder.slice(plugin.load_after_files(), encode_file)?;
+    encoder.slice(plugin.requirements(), encode_file)?;
+    encoder.slice(plugin.incompatibilities(), encode_file)?;
+    encoder.slice(plugin.messages(), encode_message)?;
+    encoder.slice(plugin.tags(), encode_tag)?;
+    encoder.slice(plugin.dirty_info(), encode_cleaning_data)?;
+    encoder.slice(plugin.clean_info(), encode_cleaning_data)?;
+    encoder.slice(plugin.locations(), encode_location)
+}
+
+fn decode_plugin(decoder: &mut Decoder<'_>) -> Result<PluginMetadata, SnapshotError> {
+    let mut plugin =
+        PluginMetadata::new(decoder.str()?).map_err(|_e| SnapshotError::InvalidValue)?;
+    if let Some(group) = decoder.optional_string()? {
+        plugin.set_group(group);
+    }
+    plugin.set_load_after_files(decoder.vec(decode_file)?);
+    plugin.set_requirements(decoder.vec(decode_file)?);
+    plugin.set_incompatibilities(decoder.vec(decode_file)?);
+    plugin.set_messages(decoder.vec(decode_message)?);
+    plugin.set_tags(decoder.vec(decode_tag)?);
+    plugin.set_dirty_info(decoder.vec(decode_cleaning_data)?);
+    plugin.set_clean_info(decoder.vec(decode_cleaning_data)?);
+    plugin.set_locations(decoder.vec(decode_location)?);
+    Ok(plugin)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use tempfile::tempdir;
+
+    const MASTERLIST: &str = "
+bash_tags:
+  - Actors.ACBS
+globals:
+  - type: warn
+    content:
+      - lang: en
+        text: 'English'
+      - lang: de
+        text: 'Deutsch'
+    condition: 'file(\"missing.esp\")'
+groups:
+  - name: early
+    description: 'Loads early'
+  - name: late
+    after:
+      - early
+plugins:
+  - name: Blank.esm
+    group: early
+    after:
+      - name: Oblivion.esm
+        display: 'Oblivion'
+        condition: 'file(\"Oblivion.esm\")'
+    req:
+      - Blank - Different.esm
+    inc:
+      - name: Blank.esp
+        constraint: 'file(\"Blank.esm\")'
+    msg:
+      - type: say
+        content: 'A note'
+    tag:
+      - Actors.ACBS
+      - '-C.Water'
+    dirty:
+      - crc: 0x7d22f9df
+        util: TES4Edit
+        udr: 4
+        itm: 2
+        nav: 1
+    clean:
+      - crc: 0x12345678
+        util: TES4Edit
+    url:
+      - link: 'https://example.com'
+        name: 'Example'
+  - name: 'Blank.*\\.esp'
+    group: late
+";
+
+    fn document() -> MetadataDocument {
+        // Each test gets its own file, as tests run in parallel.
+        let tmp_dir = tempdir().unwrap();
+        let path = tmp_dir.path().join("masterlist.yaml");
+        std::fs::write(&path, MASTERLIST).unwrap();
+
+        let mut document = MetadataDocument::default();
+        document.load(&path).unwrap();
+
+        document
+    }
+
+    #[test]
+    fn decode_should_round_trip_an_encoded_document() {
+        let document = document();
+        let key = SnapshotKey::new(MASTERLIST, None);
+
+        let bytes = encode(&document, &key).unwrap();
+        let decoded = decode(&bytes, &key).unwrap();
+
+        assert_eq!(document, decoded);
+    }
+
+    #[test]
+    fn decode_should_error_if_the_key_does_not_match() {
+        let document = document();
+        let key = SnapshotKey::new(MASTERLIST, None);
+
+        let bytes = encode(&document, &key).unwrap();
+        let other_key = SnapshotKey::new(MASTERLIST, Some("- prelude"));
+
+        assert_eq!(
+            SnapshotError::KeyMismatch,
+            decode(&bytes, &other_key).unwrap_err()
+        );
+    }
+
+    #[test]
+    fn decode_should_error_if_the_data_is_truncated() {
+        let document = document();
+        let key = SnapshotKey::new(MASTERLIST, None);
+
+        let bytes = encode(&document, &key).unwrap();
+        let truncated = &bytes[..bytes.len() - 1];
+
+        assert_eq!(
+            SnapshotError::UnexpectedEndOfData,
+            decode(truncated, &key).unwrap_err()
+        );
+    }
+
+    #[test]
+    fn decode_should_error_if_the_magic_bytes_are_wrong() {
+        let key = SnapshotKey::new(MASTERLIST, None);
+
+        assert_eq!(
+            SnapshotError::UnrecognisedFormat,
+            decode(b"NOTASNAPSHOT", &key).unwrap_err()
+        );
+    }
+
+    #[test]
+    fn snapshot_key_should_differ_if_bytes_move_between_masterlist_and_prelude() {
+        assert_ne!(
+            SnapshotKey::new("ab", Some("c")),
+            SnapshotKey::new("a", Some("bc"))
+        );
+    }
+
+    #[test]
+    fn snapshot_path_should_append_the_snapshot_extension() {
+        assert_eq!(
+            Path::new("masterlist.yaml.snapshot"),
+            snapshot_path(Path::new("masterlist.yaml"))
+        );
+    }
+}
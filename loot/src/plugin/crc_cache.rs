@@ -0,0 +1,396 @@
+//! A persistent cache of plugin file CRCs, so that unchanged plugins don't need
+//! to be hashed again in later sessions.
+use std::{
+    collections::HashMap,
+    fs::File,
+    hash::Hasher,
+    io::{BufRead, BufReader},
+    path::{Path, PathBuf},
+    sync::{
+        Arc, Mutex, RwLock,
+        atomic::{AtomicBool, Ordering},
+    },
+    time::UNIX_EPOCH,
+};
+
+use rayon::iter::{IntoParallelRefIterator, ParallelIterator};
+
+use crate::{
+    escape_ascii, logging,
+    metadata::snapshot::{Decoder, Encoder, SnapshotError, write_atomically},
+};
+
+const MAGIC: &[u8; 8] = b"LOOTCRCS";
+
+/// Incremented whenever the encoding changes in an incompatible way.
+const FORMAT_VERSION: u32 = 1;
+
+/// The size and modification time of a file, used to detect changes without
+/// reading its content.
+#[derive(Clone, Copy, Debug, Eq, PartialEq)]
+struct FileStamp {
+    size: u64,
+    modified_nanos: u64,
+}
+
+impl FileStamp {
+    fn of(path: &Path) -> Option<Self> {
+        let metadata = std::fs::metadata(path).ok()?;
+        let modified = metadata.modified().ok()?.duration_since(UNIX_EPOCH).ok()?;
+
+        Some(Self {
+            size: metadata.len(),
+            modified_nanos: u64::try_from(modified.as_nanos()).ok()?,
+        })
+    }
+}
+
+#[derive(Clone, Copy, Debug, Eq, PartialEq)]
+struct CrcCacheEntry {
+    stamp: FileStamp,
+    crc: u32,
+}
+
+/// Maps plugin paths to the CRCs of their content, keyed by each file's size
+/// and modification time so that stale entries are ignored.
+#[derive(Debug, Default)]
+pub(crate) struct CrcCache {
+    entries: RwLock<HashMap<PathBuf, CrcCacheEntry>>,
+    path: Mutex<Option<PathBuf>>,
+    is_dirty: AtomicBool,
+}
+
+impl CrcCache {
+    /// Get the CRC of the file at the given path, calculating it and adding it
+    /// to the cache if there isn't an up-to-date cached value.
+    pub(crate) fn crc(&self, path: &Path) -> std::io::Result<u32> {
+        let stamp = FileStamp::of(path);
+        if let Some(stamp) = stamp
+            && let Some(crc) = self.lookup(path, stamp)
+        {
+            return Ok(crc);
+        }
+
+        let crc = calculate_crc(path)?;
+
+        if let Some(stamp) = stamp {
+            self.insert(path.to_path_buf(), CrcCacheEntry { stamp, crc });
+        }
+
+        Ok(crc)
+    }
+
+    /// Get the cached CRC of the file at the given path, if it is up to date.
+    pub(crate) fn cached_crc(&self, path: &Path) -> Option<u32> {
+        FileStamp::of(path).and_then(|stamp| self.lookup(path, stamp))
+    }
+
+    /// Calculate the CRCs of the files at the given paths in parallel, skipping
+    /// files that already have up-to-date cached CRCs, and then save the cache
+    /// if it has a path.
+    pub(crate) fn warm(&self, paths: &[PathBuf]) {
+        paths.par_iter().for_each(|path| {
+            if let Err(e) = self.crc(path) {
+                logging::debug!(
+                    "Unable to calculate the CRC of \"{}\": {}",
+                    escape_ascii(path),
+                    e
+                );
+            }
+        });
+
+        self.save_if_dirty();
+    }
+
+    /// Calculate the CRCs of the files at the given paths on rayon's thread
+    /// pool, returning immediately.
+    pub(crate) fn warm_in_background(self: &Arc<Self>, paths: Vec<PathBuf>) {
+        let cache = Arc::clone(self);
+        rayon::spawn(move || cache.warm(&paths));
+    }
+
+    /// Set the file that the cache is persisted to, replacing the cache's
+    /// entries with those read from the file. If the file doesn't exist or
+    /// can't be read, the cache starts out empty.
+    pub(crate) fn set_path(&self, path: &Path) {
+        let entries = match read(path) {
+            Ok(entries) => {
+                logging::debug!(
+                    "Loaded {} cached plugin CRCs from \"{}\"",
+                    entries.len(),
+                    escape_ascii(path)
+                );
+                entries
+            }
+            Err(SnapshotError::Io(std::io::ErrorKind::NotFound)) => HashMap::new(),
+            Err(e) => {
+                logging::warn!(
+                    "Discarding the CRC cache at \"{}\": {}",
+                    escape_ascii(path),
+                    e
+                );
+                HashMap::new()
+            }
+        };
+
+        match self.entries.write() {
+            Ok(mut guard) => *guard = entries,
+            Err(e) => *e.into_inner() = entries,
+        }
+        match self.path.lock() {
+            Ok(mut guard) => *guard = Some(path.to_path_buf()),
+            Err(e) => *e.into_inner() = Some(path.to_path_buf()),
+        }
+        self.is_dirty.store(false, Ordering::Release);
+    }
+
+    /// Write the cache to its file if it has one and has changed since it was
+    /// last read or written.
+    pub(crate) fn save_if_dirty(&self) {
+        // Holding the path lock while writing stops concurrent saves from
+        // racing each other.
+        let Ok(path) = self.path.lock() else {
+            logging::error!("The CRC cache's path lock is poisoned, not saving the cache");
+            return;
+        };
+
+        let Some(path) = path.as_deref() else {
+            return;
+        };
+
+        if !self.is_dirty.swap(false, Ordering::AcqRel) {
+            return;
+        }
+
+        let bytes = match self.entries.read() {
+            Ok(entries) => encode(&entries),
+            Err(_e) => {
+                logging::error!("The CRC cache's lock is poisoned, not saving the cache");
+                return;
+            }
+        };
+
+        if let Err(e) = bytes.and_then(|b| write_atomically(path, &b)) {
+            logging::warn!(
+                "Failed to write the CRC cache to \"{}\": {}",
+                escape_ascii(path),
+                e
+            );
+            self.is_dirty.store(true, Ordering::Release);
+        }
+    }
+
+    fn lookup(&self, path: &Path, stamp: FileStamp) -> Option<u32> {
+        let entries = self.entries.read().ok()?;
+
+        entries
+            .get(path)
+            .filter(|e| e.stamp == stamp)
+            .map(|e| e.crc)
+    }
+
+    fn insert(&self, path: PathBuf, entry: CrcCacheEntry) {
+        if let Ok(mut entries) = self.entries.write() {
+            entries.insert(path, entry);
+            self.is_dirty.store(true, Ordering::Release);
+        }
+    }
+}
+
+fn calculate_crc(path: &Path) -> std::io::Result<u32> {
+    let file = File::open(path)?;
+    let mut reader = BufReader::new(file);
+    let mut hasher = crc32fast::Hasher::new();
+
+    let mut buffer = reader.fill_buf()?;
+    while !buffer.is_empty() {
+        hasher.write(buffer);
+        let length = buffer.len();
+        reader.consume(length);
+
+        buffer = reader.fill_buf()?;
+    }
+
+    Ok(hasher.finalize())
+}
+
+fn read(path: &Path) -> Result<HashMap<PathBuf, CrcCacheEntry>, SnapshotError> {
+    let bytes = std::fs::read(path)?;
+    decode(&bytes)
+}
+
+fn encode(entries: &HashMap<PathBuf, CrcCacheEntry>) -> Result<Vec<u8>, SnapshotError> {
+    // Paths that aren't valid UTF-8 are rare, and just don't get persisted.
+    let mut entries: Vec<(&str, &CrcCacheEntry)> = entries
+        .iter()
+        .filter_map(|(p, e)| p.to_str().map(|p| (p, e)))
+        .collect();
+    entries.sort_unstable_by_key(|(p, _)| *p);
+
+    let mut encoder = Encoder::default();
+    encoder.bytes(MAGIC);
+    encoder.u32(FORMAT_VERSION);
+    encoder.slice(&entries, |e, (path, entry)| {
+        e.str(path)?;
+        e.u64(entry.stamp.size);
+        e.u64(entry.stamp.modified_nanos);
+        e.u32(entry.crc);
+        Ok(())
+    })?;
+
+    Ok(encoder.into_bytes())
+}
+
+fn decode(bytes: &[u8]) -> Result<HashMap<PathBuf, CrcCacheEntry>, SnapshotError> {
+    let mut decoder = Decoder::new(bytes);
+
+    if decoder.take(MAGIC.len())? != MAGIC {
+        return Err(SnapshotError::UnrecognisedFormat);
+    }
+
+    if decoder.u32()? != FORMAT_VERSION {
+        return Err(SnapshotError::VersionMismatch);
+    }
+
+    let entries = decoder.vec(|d| {
+        let path = PathBuf::from(d.str()?);
+        let stamp = FileStamp {
+            size: d.u64()?,
+            modified_nanos: d.u64()?,
+        };
+        let crc = d.u32()?;
+
+        Ok((path, CrcCacheEntry { stamp, crc }))
+    })?;
+
+    decoder.finish()?;
+
+    Ok(entries.into_iter().collect())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use tempfile::tempdir;
+
+    use crate::{
+        GameType,
+        tests::{BLANK_ESM, BLANK_ESP, source_plugins_path},
+    };
+
+    fn copy_plugin(name: &str, dir: &Path) -> PathBuf {
+        let path = dir.join(name);
+        std::fs::copy(source_plugins_path(GameType::Oblivion).join(name), &path).unwrap();
+        path
+    }
+
+    #[test]
+    fn crc_should_calculate_and_cache_the_crc_of_an_uncached_file() {
+        let tmp_dir = tempdir().unwrap();
+        let path = copy_plugin(BLANK_ESM, tmp_dir.path());
+        let cache = CrcCache::default();
+
+        assert!(cache.cached_crc(&path).is_none());
+
+        let crc = cache.crc(&path).unwrap();
+
+        assert_eq!(calculate_crc(&path).unwrap(), crc);
+        assert_eq!(Some(crc), cache.cached_crc(&path));
+    }
+
+    #[test]
+    fn crc_should_return_the_cached_crc_if_the_file_is_unchanged() {
+        let tmp_dir = tempdir().unwrap();
+        let path = copy_plugin(BLANK_ESM, tmp_dir.path());
+        let cache = CrcCache::default();
+
+        let stamp = FileStamp::of(&path).unwrap();
+        cache.insert(
+            path.clone(),
+            CrcCacheEntry {
+                stamp,
+                crc: 0xDEAD_BEEF_u32,
+            },
+        );
+
+        assert_eq!(0xDEAD_BEEF_u32, cache.crc(&path).unwrap());
+    }
+
+    #[test]
+    fn crc_should_recalculate_the_crc_if_the_file_size_has_changed() {
+        let tmp_dir = tempdir().unwrap();
+        let path = copy_plugin(BLANK_ESM, tmp_dir.path());
+        let cache = CrcCache::default();
+
+        let mut stamp = FileStamp::of(&path).unwrap();
+        stamp.size += 1;
+        cache.insert(
+            path.clone(),
+            CrcCacheEntry {
+                stamp,
+                crc: 0xDEAD_BEEF_u32,
+            },
+        );
+
+        assert_eq!(calculate_crc(&path).unwrap(), cache.crc(&path).unwrap());
+    }
+
+    #[test]
+    fn warm_should_cache_the_crcs_of_all_given_files() {
+        let tmp_dir = tempdir().unwrap();
+        let esm = copy_plugin(BLANK_ESM, tmp_dir.path());
+        let esp = copy_plugin(BLANK_ESP, tmp_dir.path());
+        let cache = CrcCache::default();
+
+        cache.warm(&[esm.clone(), esp.clone(), tmp_dir.path().join("missing.esp")]);
+
+        assert_eq!(Some(calculate_crc(&esm).unwrap()), cache.cached_crc(&esm));
+        assert_eq!(Some(calculate_crc(&esp).unwrap()), cache.cached_crc(&esp));
+    }
+
+    #[test]
+    fn set_path_should_read_crcs_saved_by_another_cache() {
+        let tmp_dir = tempdir().unwrap();
+        let path = copy_plugin(BLANK_ESM, tmp_dir.path());
+        let cache_path = tmp_dir.path().join("crcs.bin");
+
+        let cache = CrcCache::default();
+        cache.set_path(&cache_path);
+        let crc = cache.crc(&path).unwrap();
+        cache.save_if_dirty();
+
+        assert!(cache_path.exists());
+
+        let other_cache = CrcCache::default();
+        other_cache.set_path(&cache_path);
+
+        assert_eq!(Some(crc), other_cache.cached_crc(&path));
+    }
+
+    #[test]
+    fn set_path_should_leave_the_cache_empty_if_the_file_is_invalid() {
+        let tmp_dir = tempdir().unwrap();
+        let path = copy_plugin(BLANK_ESM, tmp_dir.path());
+        let cache_path = tmp_dir.path().join("crcs.bin");
+        std::fs::write(&cache_path, b"not a cache").unwrap();
+
+        let cache = CrcCache::default();
+        cache.crc(&path).unwrap();
+        cache.set_path(&cache_path);
+
+        assert!(cache.cached_crc(&path).is_none());
+    }
+
+    #[test]
+    fn save_if_dirty_should_do_nothing_if_the_cache_has_no_path() {
+        let tmp_dir = tempdir().unwrap();
+        let path = copy_plugin(BLANK_ESM, tmp_dir.path());
+
+        let cache = CrcCache::default();
+        cache.crc(&path).unwrap();
+        cache.save_if_dirty();
+
+        assert!(cache.is_dirty.load(Ordering::Acquire));
+    }
+}
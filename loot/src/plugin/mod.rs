@@ -1,10 +1,9 @@
+mod crc_cache;
 pub(crate) mod error;
+mod overlap;
 
 use std::{
     collections::{BTreeMap, BTreeSet},
-    fs::File,
-    hash::Hasher,
-    io::{BufRead, BufReader},
     path::{Path, PathBuf},
     sync::LazyLock,
 };
@@ -20,10 +19,13 @@ use crate::{
     logging,
     metadata::plugin_metadata::trim_dot_ghost,
 };
+pub(crate) use crc_cache::CrcCache;
 use error::{
     InvalidFilenameReason, LoadPluginError, PluginDataError, PluginValidationError,
     PluginValidationErrorReason,
 };
+pub use overlap::RecordOverlaps;
+pub(crate) use overlap::find_record_overlaps;
 
 #[derive(Clone, Copy, Debug, Eq, PartialEq, Ord, PartialOrd, Hash)]
 pub(crate) enum LoadScope {
@@ -46,6 +48,7 @@ pub struct Plugin {
     name: String,
     data: Option<esplugin::Plugin>,
     game_type: GameType,
+    load_scope: LoadScope,
     crc: Option<u32>,
     version: Option<String>,
     tags: Box<[String]>,
@@ -63,9 +66,13 @@ impl Plugin {
         let name = name_string(game_type, plugin_path)?;
 
         let (parse_options, crc) = if load_scope == LoadScope::HeaderOnly {
-            (ParseOptions::header_only(), None)
+            // Don't read the whole file, but a cached CRC is free to use.
+            (
+                ParseOptions::header_only(),
+                game_cache.crcs().cached_crc(plugin_path),
+            )
         } else {
-            let crc = calculate_crc(plugin_path)?;
+            let crc = game_cache.crcs().crc(plugin_path)?;
             (ParseOptions::whole_plugin(), Some(crc))
         };
 
@@ -99,6 +106,7 @@ impl Plugin {
             name,
             data: plugin,
             game_type,
+            load_scope,
             crc,
             version,
             tags,
@@ -150,9 +158,16 @@ impl Plugin {
         &self.tags
     }
 
+    /// Get how much of the plugin was loaded. Only whole plugins have their
+    /// records loaded.
+    pub(crate) fn load_scope(&self) -> LoadScope {
+        self.load_scope
+    }
+
     /// Get the plugin's CRC-32 checksum.
     ///
-    /// This will be `None` if the plugin is not fully loaded.
+    /// This will be `None` if the plugin is not fully loaded, unless the
+    /// game's CRC cache holds an up-to-date CRC for it.
     pub fn crc(&self) -> Option<u32> {
         self.crc
     }
@@ -373,23 +388,6 @@ fn name_string(game_type: GameType, path: &Path) -> Result<String, LoadPluginErr
     }
 }
 
-fn calculate_crc(path: &Path) -> std::io::Result<u32> {
-    let file = File::open(path)?;
-    let mut reader = BufReader::new(file);
-    let mut hasher = crc32fast::Hasher::new();
-
-    let mut buffer = reader.fill_buf()?;
-    while !buffer.is_empty() {
-        hasher.write(buffer);
-        let length = buffer.len();
-        reader.consume(length);
-
-        buffer = reader.fill_buf()?;
-    }
-
-    Ok(hasher.finalize())
-}
-
 fn extract_bash_tags(description: &str) -> Vec<String> {
     if let Some((_, bash_tags)) = description.split_once("{{BASH:")
         && let Some((bash_tags, _)) = bash_tags.split_once("}}")
@@ -726,7 +724,7 @@ mod tests {
 
             std::fs::copy(data_path.join(blank_esm(game_type)), &omwgame).unwrap();
             std::fs::copy(data_path.join(BLANK_ESP), &omwaddon).unwrap();
-            File::create(&omwscripts).unwrap();
+            std::fs::File::create(&omwscripts).unwrap();
 
             assert!(
                 Plugin::new(
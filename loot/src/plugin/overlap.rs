@@ -0,0 +1,136 @@
+use std::sync::Arc;
+
+use rayon::iter::{IndexedParallelIterator, IntoParallelRefIterator, ParallelIterator};
+
+use super::{LoadScope, Plugin, error::PluginDataError};
+
+/// The pairs of plugins that contain records with the same IDs.
+#[derive(Clone, Debug, Default, Eq, PartialEq)]
+pub struct RecordOverlaps {
+    plugin_names: Vec<String>,
+    pairs: Vec<(usize, usize)>,
+    overlap_counts: Vec<usize>,
+}
+
+impl RecordOverlaps {
+    /// Get the names of the plugins that were checked, in ascending order.
+    pub fn plugin_names(&self) -> &[String] {
+        &self.plugin_names
+    }
+
+    /// Get the overlapping pairs of plugins, as indices into
+    /// [`RecordOverlaps::plugin_names`].
+    ///
+    /// Each pair is only listed once, with the lower index first, and pairs
+    /// are sorted.
+    pub fn pairs(&self) -> &[(usize, usize)] {
+        &self.pairs
+    }
+
+    /// Get the number of other plugins that each plugin overlaps with, in the
+    /// same order as [`RecordOverlaps::plugin_names`].
+    pub fn overlap_counts(&self) -> &[usize] {
+        &self.overlap_counts
+    }
+}
+
+/// Check every pair of the given plugins for overlapping records.
+///
+/// esplugin keeps each plugin's record IDs sorted, so each check is a linear
+/// merge of the two lists. Plugins that have no records (including plugins
+/// that only had their headers loaded, as they can't overlap) are skipped
+/// before any pairs are compared, and the remaining rows of the triangle of
+/// pairs are compared in parallel.
+pub(crate) fn find_record_overlaps(
+    plugins: &[Arc<Plugin>],
+) -> Result<RecordOverlaps, PluginDataError> {
+    let mut plugins: Vec<&Plugin> = plugins.iter().map(AsRef::as_ref).collect();
+    plugins.sort_by(|a, b| a.name().cmp(b.name()));
+
+    let candidates = overlap_candidates(&plugins);
+
+    let rows = candidates
+        .par_iter()
+        .enumerate()
+        .map(|(position, (index, plugin))| {
+            candidates
+                .iter()
+                .skip(position + 1)
+                .filter_map(
+                    |(other_index, other)| match plugin.do_records_overlap(other) {
+                        Ok(true) => Some(Ok((*index, *other_index))),
+                        Ok(false) => None,
+                        Err(e) => Some(Err(e)),
+                    },
+                )
+                .collect::<Result<Vec<_>, _>>()
+        })
+        .collect::<Result<Vec<_>, _>>()?;
+
+    let pairs: Vec<(usize, usize)> = rows.into_iter().flatten().collect();
+
+    let mut overlap_counts = vec![0_usize; plugins.len()];
+    for (first, second) in &pairs {
+        if let Some(count) = overlap_counts.get_mut(*first) {
+            *count += 1;
+        }
+        if let Some(count) = overlap_counts.get_mut(*second) {
+            *count += 1;
+        }
+    }
+
+    Ok(RecordOverlaps {
+        plugin_names: plugins.iter().map(|p| p.name().to_owned()).collect(),
+        pairs,
+        overlap_counts,
+    })
+}
+
+/// The plugins, with their indices, that can overlap with another plugin.
+///
+/// A header-only plugin's header still gives a record count, and it may have
+/// a CRC from the cache, so neither says whether its records were loaded.
+fn overlap_candidates<'a>(plugins: &[&'a Plugin]) -> Vec<(usize, &'a Plugin)> {
+    plugins
+        .iter()
+        .enumerate()
+        .filter(|(_, p)| p.load_scope() == LoadScope::WholePlugin && !p.is_empty())
+        .map(|(i, p)| (i, *p))
+        .collect()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use crate::{
+        GameType,
+        game::GameCache,
+        tests::{BLANK_ESM, BLANK_MASTER_DEPENDENT_ESM, source_plugins_path},
+    };
+
+    #[test]
+    fn overlap_candidates_should_skip_header_only_plugins_that_have_a_cached_crc() {
+        let game_type = GameType::Oblivion;
+        let cache = GameCache::default();
+        let header_only_path = source_plugins_path(game_type).join(BLANK_MASTER_DEPENDENT_ESM);
+        cache.crcs().warm(&[header_only_path.clone()]);
+
+        let header_only =
+            Plugin::new(game_type, &cache, &header_only_path, LoadScope::HeaderOnly).unwrap();
+        let whole = Plugin::new(
+            game_type,
+            &cache,
+            &source_plugins_path(game_type).join(BLANK_ESM),
+            LoadScope::WholePlugin,
+        )
+        .unwrap();
+
+        assert!(header_only.crc().is_some());
+
+        let candidates = overlap_candidates(&[&header_only, &whole]);
+        let indices: Vec<usize> = candidates.iter().map(|(i, _)| *i).collect();
+
+        assert_eq!(vec![1], indices);
+    }
+}
@@ -1,7 +1,9 @@
 pub(crate) mod error;
 pub(crate) mod groups;
 pub(crate) mod plugins;
+mod reachability;
 mod search;
+pub(crate) mod statistics;
 mod validate;
 pub(crate) mod vertex;
 
@@ -1,4 +1,4 @@
-use std::rc::Rc;
+use std::{cell::Cell, rc::Rc, time::Instant};
 
 use petgraph::{
     Graph,
@@ -20,7 +20,9 @@ use crate::{
 
 use super::{
     groups::GroupsGraph,
+    reachability::Reachability,
     search::{BidirBfsVisitor, DfsVisitor, bidirectional_bfs, depth_first_search, find_cycle},
+    statistics::{SortPhase, SortStatistics},
     validate::{validate_plugin_groups, validate_specific_and_hardcoded_edges},
 };
 
@@ -152,7 +154,9 @@ type InnerPluginsGraph<'a, T> = Graph<Rc<PluginSortingData<'a, T>>, EdgeType>;
 #[derive(Debug)]
 struct PluginsGraph<'a, T: SortingPlugin> {
     inner: InnerPluginsGraph<'a, T>,
-    paths_cache: HashMap<NodeIndex, HashSet<NodeIndex>>,
+    reachability: Reachability,
+    path_query_count: Cell<usize>,
+    path_search_count: Cell<usize>,
 }
 
 impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
@@ -165,7 +169,7 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
     }
 
     fn add_edge(&mut self, from: NodeIndex, to: NodeIndex, edge_type: EdgeType) {
-        if self.is_path_cached(from, to) {
+        if self.reachability.has_edge(from, to) {
             return;
         }
 
@@ -178,7 +182,7 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
 
         self.inner.add_edge(from, to, edge_type);
 
-        self.cache_path(from, to);
+        self.reachability.add_edge(from, to);
     }
 
     fn node_indices(&self) -> petgraph::graph::NodeIndices {
@@ -439,7 +443,7 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
                     (other_node_index, node_index)
                 };
 
-                if !self.is_path_cached(from_index, to_index) {
+                if !self.reachability.has_edge(from_index, to_index) {
                     if self.path_exists(to_index, from_index) {
                         logging::debug!(
                             "Skipping {} edge from \"{}\" to \"{}\" as it would create a cycle.",
@@ -467,10 +471,10 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
         //
         // Brute-forcing this by adding an edge between every pair of vertices
         // (unless it would cause a cycle) works but scales terribly, as before each
-        // edge is added a bidirectional search needs to be done for a path in the
-        // other direction (to detect a potential cycle). This search takes more time
-        // as the number of edges involves increases, so adding tie breaks gets slower
-        // as they get added.
+        // edge is added there needs to be a check for a path in the other direction
+        // (to detect a potential cycle), and each edge that is added needs to be
+        // recorded in the graph's reachability index, which gets more expensive as
+        // more plugins become connected.
         //
         // The point of adding these tie breaks is to ensure that there's a
         // Hamiltonian path through the graph and therefore only one possible
@@ -482,8 +486,8 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
         // the later for each consecutive pair of plugins (e.g. for [A, B, C], add
         // edges A->B, B->C), unless adding the edge would cause a cycle. If sorting
         // has made no changes to the load order, then it'll be possible to add all
-        // those edges and only N - 1 bidirectional searches will be needed when there
-        // are N vertices.
+        // those edges and only N - 1 path checks will be needed when there are N
+        // vertices.
         //
         // If it's not possible to add such an edge for a pair of plugins [A, B], that
         // means that LOOT thinks A needs to load after B, i.e. the sorted load order
@@ -723,12 +727,14 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
         )
     }
 
-    fn cache_path(&mut self, from: NodeIndex, to: NodeIndex) {
-        self.paths_cache.entry(from).or_default().insert(to);
-    }
+    fn record_statistics(&self, statistics: &mut SortStatistics) {
+        statistics.add_node_count(self.inner.node_count());
+
+        for edge_type in self.inner.edge_weights() {
+            statistics.add_edge(*edge_type);
+        }
 
-    fn is_path_cached(&self, from: NodeIndex, to: NodeIndex) -> bool {
-        self.paths_cache.get(&from).is_some_and(|s| s.contains(&to))
+        statistics.add_path_queries(self.path_query_count.get(), self.path_search_count.get());
     }
 
     fn node_index_by_name(&self, name: &str) -> Option<NodeIndex> {
@@ -736,22 +742,25 @@ impl<'a, T: SortingPlugin> PluginsGraph<'a, T> {
             .find(|i| unicase::eq(self[*i].name(), name))
     }
 
-    fn path_exists(&mut self, from: NodeIndex, to: NodeIndex) -> bool {
-        if self.is_path_cached(from, to) {
-            return true;
-        }
-
-        let mut visitor = PathCacher::new(&mut self.paths_cache, from, to);
+    fn path_exists(&self, from: NodeIndex, to: NodeIndex) -> bool {
+        self.path_query_count.set(self.path_query_count.get() + 1);
 
-        bidirectional_bfs(&self.inner, from, to, &mut visitor)
+        self.reachability.path_exists(from, to)
     }
 
     fn find_path(
-        &mut self,
+        &self,
         from: NodeIndex,
         to: NodeIndex,
     ) -> Result<Option<Vec<NodeIndex>>, PathfindingError> {
-        let mut path_finder = PathFinder::new(&self.inner, &mut self.paths_cache, from, to);
+        // Only search the graph if there's a path to reconstruct.
+        if !self.path_exists(from, to) {
+            return Ok(None);
+        }
+
+        self.path_search_count.set(self.path_search_count.get() + 1);
+
+        let mut path_finder = PathFinder::new(&self.inner, from, to);
 
         if bidirectional_bfs(&self.inner, from, to, &mut path_finder) {
             path_finder.path()
@@ -766,7 +775,9 @@ impl<T: SortingPlugin> std::default::Default for PluginsGraph<'_, T> {
     fn default() -> Self {
         Self {
             inner: Graph::default(),
-            paths_cache: HashMap::default(),
+            reachability: Reachability::default(),
+            path_query_count: Cell::new(0),
+            path_search_count: Cell::new(0),
         }
     }
 }
@@ -779,13 +790,45 @@ impl<'a, T: SortingPlugin> std::ops::Index<NodeIndex> for PluginsGraph<'a, T> {
     }
 }
 
-pub(crate) fn sort_plugins<T: SortingPlugin>(
-    mut plugins_sorting_data: Vec<PluginSortingData<T>>,
+/// Control whether or not plugins are sorted using multiple threads.
+#[derive(Clone, Copy, Debug, Default, Eq, PartialEq, Ord, PartialOrd, Hash)]
+#[expect(clippy::exhaustive_enums, reason = "It's effectively a boolean")]
+pub enum SortParallelism {
+    /// Sort all plugins on the calling thread.
+    Sequential,
+    /// Sort masters, non-masters and blueprint masters in parallel, as they
+    /// are sorted independently of each other. The result is the same as when
+    /// sorting sequentially.
+    #[default]
+    Parallel,
+}
+
+#[cfg(test)]
+fn sort_plugins<T: SortingPlugin + Sync>(
+    plugins_sorting_data: Vec<PluginSortingData<T>>,
     groups_graph: &GroupsGraph,
     early_loading_plugins: &[String],
+    parallelism: SortParallelism,
 ) -> Result<Vec<String>, SortingError> {
+    sort_plugins_with_statistics(
+        plugins_sorting_data,
+        groups_graph,
+        early_loading_plugins,
+        parallelism,
+    )
+    .map(|(load_order, _)| load_order)
+}
+
+pub(crate) fn sort_plugins_with_statistics<T: SortingPlugin + Sync>(
+    mut plugins_sorting_data: Vec<PluginSortingData<T>>,
+    groups_graph: &GroupsGraph,
+    early_loading_plugins: &[String],
+    parallelism: SortParallelism,
+) -> Result<(Vec<String>, SortStatistics), SortingError> {
+    let start = Instant::now();
+
     if plugins_sorting_data.is_empty() {
-        return Ok(Vec::new());
+        return Ok((Vec::new(), SortStatistics::default()));
     }
 
     validate_plugin_groups(&plugins_sorting_data, groups_graph)?;
@@ -801,9 +844,9 @@ pub(crate) fn sort_plugins<T: SortingPlugin>(
 
     // Some parts of sorting are O(N^2) for N plugins, and master flags cause
     // O(M*N) edges to be added for M masters and N non-masters, which can be
-    // two thirds of all edges added. The cost of each bidirectional search
-    // scales with the number of edges, so reducing edges makes searches
-    // faster.
+    // two thirds of all edges added. Each edge added needs to be recorded in
+    // the graph's reachability index, and the cost of doing so scales with the
+    // number of plugins in the graph, so smaller graphs are cheaper to build.
     // Similarly, blueprint plugins load after all others.
     // As such, sort plugins using three separate graphs for masters,
     // non-masters and blueprint plugins. This means that any edges that go from a
@@ -823,50 +866,84 @@ pub(crate) fn sort_plugins<T: SortingPlugin>(
         early_loading_plugins,
     )?;
 
-    let mut masters_load_order =
-        sort_plugins_partition(masters, groups_graph, early_loading_plugins)?;
-
-    let blueprint_masters_load_order =
-        sort_plugins_partition(blueprint_masters, groups_graph, early_loading_plugins)?;
+    // The partitions share no edges, so they can be sorted independently. If
+    // more than one fails, the error from the first partition in sequential
+    // order is returned, so the result doesn't depend on the parallelism.
+    let (masters_result, blueprint_masters_result, non_masters_result) = match parallelism {
+        SortParallelism::Sequential => (
+            sort_plugins_partition(masters, groups_graph, early_loading_plugins),
+            sort_plugins_partition(blueprint_masters, groups_graph, early_loading_plugins),
+            sort_plugins_partition(non_masters, groups_graph, early_loading_plugins),
+        ),
+        SortParallelism::Parallel => {
+            let (masters_result, (blueprint_masters_result, non_masters_result)) = rayon::join(
+                || sort_plugins_partition(masters, groups_graph, early_loading_plugins),
+                || {
+                    rayon::join(
+                        || {
+                            sort_plugins_partition(
+                                blueprint_masters,
+                                groups_graph,
+                                early_loading_plugins,
+                            )
+                        },
+                        || sort_plugins_partition(non_masters, groups_graph, early_loading_plugins),
+                    )
+                },
+            );
+            (masters_result, blueprint_masters_result, non_masters_result)
+        }
+    };
 
-    let non_masters_load_order =
-        sort_plugins_partition(non_masters, groups_graph, early_loading_plugins)?;
+    let (mut masters_load_order, mut statistics) = masters_result?;
+    let (blueprint_masters_load_order, blueprint_masters_statistics) = blueprint_masters_result?;
+    let (non_masters_load_order, non_masters_statistics) = non_masters_result?;
 
     masters_load_order.extend(non_masters_load_order);
     masters_load_order.extend(blueprint_masters_load_order);
 
-    Ok(masters_load_order)
+    statistics.merge(non_masters_statistics);
+    statistics.merge(blueprint_masters_statistics);
+    statistics.set_total_duration(start.elapsed());
+
+    Ok((masters_load_order, statistics))
 }
 
 fn sort_plugins_partition<T: SortingPlugin>(
     plugins_sorting_data: Vec<PluginSortingData<T>>,
     groups_graph: &GroupsGraph,
     early_loading_plugins: &[String],
-) -> Result<Vec<String>, SortingError> {
+) -> Result<(Vec<String>, SortStatistics), SortingError> {
+    let mut statistics = SortStatistics::default();
     let mut graph = PluginsGraph::new();
 
     for plugin in plugins_sorting_data {
         graph.add_node(plugin);
     }
 
-    graph.add_specific_edges()?;
-    graph.add_early_loading_plugin_edges(early_loading_plugins);
+    statistics.time(SortPhase::SpecificEdges, || {
+        graph.add_specific_edges()?;
+        graph.add_early_loading_plugin_edges(early_loading_plugins);
+        Ok::<(), SortingError>(())
+    })?;
 
     // Check for cycles now because from this point on edges are only added if
     // they don't cause cycles, and adding overlap and tie-break edges is
     // relatively slow, so checking now provides quicker feedback if there is an
     // issue.
-    graph.check_for_cycles()?;
+    statistics.time(SortPhase::CycleChecks, || graph.check_for_cycles())?;
 
-    graph.add_group_edges(groups_graph)?;
-    graph.add_overlap_edges()?;
-    graph.add_tie_break_edges()?;
+    statistics.time(SortPhase::GroupEdges, || {
+        graph.add_group_edges(groups_graph)
+    })?;
+    statistics.time(SortPhase::OverlapEdges, || graph.add_overlap_edges())?;
+    statistics.time(SortPhase::TieBreakEdges, || graph.add_tie_break_edges())?;
 
     // Check for cycles again, just in case there's a bug that lets some occur.
     // The check doesn't take a significant amount of time.
-    graph.check_for_cycles()?;
+    statistics.time(SortPhase::CycleChecks, || graph.check_for_cycles())?;
 
-    let sorted_nodes = graph.topological_sort()?;
+    let sorted_nodes = statistics.time(SortPhase::TopologicalSort, || graph.topological_sort())?;
 
     if let Some((first, second)) = graph.check_path_is_hamiltonian(&sorted_nodes) {
         logging::error!(
@@ -881,7 +958,9 @@ fn sort_plugins_partition<T: SortingPlugin>(
         .map(|i| graph[i].name().to_owned())
         .collect();
 
-    Ok(sorted_plugin_names)
+    graph.record_statistics(&mut statistics);
+
+    Ok((sorted_plugin_names, statistics))
 }
 
 fn path_to_string<T: SortingPlugin>(graph: &InnerPluginsGraph<T>, path: &[NodeIndex]) -> String {
@@ -894,7 +973,6 @@ fn path_to_string<T: SortingPlugin>(graph: &InnerPluginsGraph<T>, path: &[NodeIn
 #[derive(Debug)]
 struct PathFinder<'a, 'b, T: SortingPlugin> {
     graph: &'a InnerPluginsGraph<'b, T>,
-    cache: &'a mut HashMap<NodeIndex, HashSet<NodeIndex>>,
     from_node_index: NodeIndex,
     to_node_index: NodeIndex,
     forward_parents: HashMap<NodeIndex, NodeIndex>,
@@ -905,13 +983,11 @@ struct PathFinder<'a, 'b, T: SortingPlugin> {
 impl<'a, 'b, T: SortingPlugin> PathFinder<'a, 'b, T> {
     fn new(
         graph: &'a InnerPluginsGraph<'b, T>,
-        cache: &'a mut HashMap<NodeIndex, HashSet<NodeIndex>>,
         from_node_index: NodeIndex,
         to_node_index: NodeIndex,
     ) -> Self {
         Self {
             graph,
-            cache,
             from_node_index,
             to_node_index,
             forward_parents: HashMap::default(),
@@ -920,10 +996,6 @@ impl<'a, 'b, T: SortingPlugin> PathFinder<'a, 'b, T> {
         }
     }
 
-    fn cache_path(&mut self, from: NodeIndex, to: NodeIndex) {
-        self.cache.entry(from).or_default().insert(to);
-    }
-
     fn path(&self) -> Result<Option<Vec<NodeIndex>>, PathfindingError> {
         match self.intersection_node {
             None => Ok(None),
@@ -980,14 +1052,10 @@ impl<'a, 'b, T: SortingPlugin> PathFinder<'a, 'b, T> {
 
 impl<T: SortingPlugin> BidirBfsVisitor for PathFinder<'_, '_, T> {
     fn visit_forward_bfs_edge(&mut self, source: NodeIndex, target: NodeIndex) {
-        self.cache_path(self.from_node_index, target);
-
         self.forward_parents.insert(target, source);
     }
 
     fn visit_reverse_bfs_edge(&mut self, source: NodeIndex, target: NodeIndex) {
-        self.cache_path(source, self.to_node_index);
-
         self.reverse_children.insert(source, target);
     }
 
@@ -996,13 +1064,6 @@ impl<T: SortingPlugin> BidirBfsVisitor for PathFinder<'_, '_, T> {
     }
 }
 
-#[derive(Debug)]
-struct PathCacher<'a> {
-    cache: &'a mut HashMap<NodeIndex, HashSet<NodeIndex>>,
-    from_node_index: NodeIndex,
-    to_node_index: NodeIndex,
-}
-
 fn get_plugins_in_groups<T: SortingPlugin>(
     graph: &InnerPluginsGraph<T>,
 ) -> HashMap<Box<str>, Vec<NodeIndex>> {
@@ -1032,36 +1093,6 @@ fn get_plugins_in_groups<T: SortingPlugin>(
     plugins_in_groups
 }
 
-impl<'a> PathCacher<'a> {
-    fn new(
-        cache: &'a mut HashMap<NodeIndex, HashSet<NodeIndex>>,
-        from_node_index: NodeIndex,
-        to_node_index: NodeIndex,
-    ) -> Self {
-        Self {
-            cache,
-            from_node_index,
-            to_node_index,
-        }
-    }
-
-    fn cache_path(&mut self, from: NodeIndex, to: NodeIndex) {
-        self.cache.entry(from).or_default().insert(to);
-    }
-}
-
-impl BidirBfsVisitor for PathCacher<'_> {
-    fn visit_forward_bfs_edge(&mut self, _: NodeIndex, target: NodeIndex) {
-        self.cache_path(self.from_node_index, target);
-    }
-
-    fn visit_reverse_bfs_edge(&mut self, source: NodeIndex, _: NodeIndex) {
-        self.cache_path(source, self.to_node_index);
-    }
-
-    fn visit_intersection_node(&mut self, _: NodeIndex) {}
-}
-
 // Use type aliases to make intent clearer without the complications of introducing newtypes.
 type PluginNodeIndex = NodeIndex;
 type GroupNodeIndex = NodeIndex;
@@ -1140,7 +1171,7 @@ fn add_edges_from_plugin<T: SortingPlugin>(
     }
 
     for to_plugin in to_plugins {
-        if !plugins_graph.is_path_cached(from_plugin, *to_plugin) {
+        if !plugins_graph.reachability.has_edge(from_plugin, *to_plugin) {
             let involves_user_metadata = path_involves_user_metadata
                 || plugins_graph[from_plugin].group_is_user_metadata
                 || plugins_graph[*to_plugin].group_is_user_metadata;
@@ -3255,6 +3286,7 @@ mod tests {
                 ],
                 &fixture.groups_graph,
                 &[],
+                SortParallelism::Parallel,
             )
             .unwrap();
 
@@ -3267,12 +3299,130 @@ mod tests {
                 ],
                 &fixture.groups_graph,
                 &[],
+                SortParallelism::Parallel,
+            )
+            .unwrap();
+
+            assert_eq!(expected, sorted.as_slice());
+        }
+
+        #[test]
+        fn should_give_the_same_result_when_sorting_sequentially_or_in_parallel() {
+            const PLUGIN_C: &str = "C.esp";
+            const PLUGIN_D: &str = "D.esp";
+
+            let mut fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B, PLUGIN_C, PLUGIN_D]);
+
+            fixture.get_plugin_mut(PLUGIN_A).is_master = true;
+            let b = fixture.get_plugin_mut(PLUGIN_B);
+            b.is_master = true;
+            b.is_blueprint_plugin = true;
+            fixture.get_plugin_mut(PLUGIN_C).add_master(PLUGIN_D);
+
+            let data = || {
+                vec![
+                    fixture.sorting_data(PLUGIN_D),
+                    fixture.sorting_data(PLUGIN_C),
+                    fixture.sorting_data(PLUGIN_B),
+                    fixture.sorting_data(PLUGIN_A),
+                ]
+            };
+
+            let expected = &[PLUGIN_A, PLUGIN_D, PLUGIN_C, PLUGIN_B];
+
+            let sorted = sort_plugins(
+                data(),
+                &fixture.groups_graph,
+                &[],
+                SortParallelism::Sequential,
             )
             .unwrap();
+            assert_eq!(expected, sorted.as_slice());
 
+            let sorted = sort_plugins(
+                data(),
+                &fixture.groups_graph,
+                &[],
+                SortParallelism::Parallel,
+            )
+            .unwrap();
             assert_eq!(expected, sorted.as_slice());
         }
 
+        #[test]
+        fn should_return_the_masters_error_if_more_than_one_partition_fails_in_parallel() {
+            const PLUGIN_C: &str = "C.esp";
+            const PLUGIN_D: &str = "D.esp";
+
+            let mut fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B, PLUGIN_C, PLUGIN_D]);
+
+            let a = fixture.get_plugin_mut(PLUGIN_A);
+            a.is_master = true;
+            a.add_master(PLUGIN_B);
+            let b = fixture.get_plugin_mut(PLUGIN_B);
+            b.is_master = true;
+            b.add_master(PLUGIN_A);
+            fixture.get_plugin_mut(PLUGIN_C).add_master(PLUGIN_D);
+            fixture.get_plugin_mut(PLUGIN_D).add_master(PLUGIN_C);
+
+            let data = vec![
+                fixture.sorting_data(PLUGIN_A),
+                fixture.sorting_data(PLUGIN_B),
+                fixture.sorting_data(PLUGIN_C),
+                fixture.sorting_data(PLUGIN_D),
+            ];
+
+            match sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel) {
+                Err(SortingError::CycleFound(e)) => {
+                    assert_eq!(
+                        &[
+                            Vertex::new(PLUGIN_A.into()).with_out_edge_type(EdgeType::Master),
+                            Vertex::new(PLUGIN_B.into()).with_out_edge_type(EdgeType::Master),
+                        ],
+                        e.into_cycle().as_slice()
+                    );
+                }
+                _ => panic!("Expected to find a cycle"),
+            }
+        }
+
+        #[test]
+        fn with_statistics_should_sum_the_statistics_for_all_partitions() {
+            const PLUGIN_C: &str = "C.esp";
+            const PLUGIN_D: &str = "D.esp";
+
+            let mut fixture = Fixture::with_plugins(&[PLUGIN_A, PLUGIN_B, PLUGIN_C, PLUGIN_D]);
+
+            fixture.get_plugin_mut(PLUGIN_A).is_master = true;
+            fixture.get_plugin_mut(PLUGIN_C).add_master(PLUGIN_D);
+
+            let data = vec![
+                fixture.sorting_data(PLUGIN_A),
+                fixture.sorting_data(PLUGIN_B),
+                fixture.sorting_data(PLUGIN_C),
+                fixture.sorting_data(PLUGIN_D),
+            ];
+
+            let (sorted, statistics) = sort_plugins_with_statistics(
+                data,
+                &fixture.groups_graph,
+                &[],
+                SortParallelism::Sequential,
+            )
+            .unwrap();
+
+            assert_eq!(&[PLUGIN_A, PLUGIN_B, PLUGIN_D, PLUGIN_C], sorted.as_slice());
+            assert_eq!(4, statistics.node_count());
+            assert_eq!(1, statistics.edge_count(EdgeType::Master));
+            assert_ne!(0, statistics.edge_count(EdgeType::TieBreak));
+            assert_ne!(0, statistics.path_query_count());
+            assert!(statistics.path_search_count() <= statistics.path_query_count());
+
+            let phases_duration: std::time::Duration =
+                statistics.phase_durations().map(|(_, d)| d).sum();
+            assert!(statistics.total_duration() >= phases_duration);
+        }
+
         #[test]
         fn should_use_group_metadata_when_deciding_relative_plugin_positions() {
             let fixture = Fixture::with_plugins(&[PLUGIN_B, PLUGIN_A]);
@@ -3284,7 +3434,8 @@ mod tests {
 
             let expected = &[PLUGIN_A, PLUGIN_B];
 
-            let sorted = sort_plugins(data, &fixture.groups_graph, &[]).unwrap();
+            let sorted =
+                sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel).unwrap();
 
             assert_eq!(expected, sorted.as_slice());
         }
@@ -3300,7 +3451,8 @@ mod tests {
 
             let expected = &[PLUGIN_B, PLUGIN_A];
 
-            let sorted = sort_plugins(data, &fixture.groups_graph, &[]).unwrap();
+            let sorted =
+                sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel).unwrap();
 
             assert_eq!(expected, sorted.as_slice());
         }
@@ -3316,7 +3468,8 @@ mod tests {
 
             let expected = &[PLUGIN_B, PLUGIN_A];
 
-            let sorted = sort_plugins(data, &fixture.groups_graph, &[]).unwrap();
+            let sorted =
+                sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel).unwrap();
 
             assert_eq!(expected, sorted.as_slice());
         }
@@ -3332,7 +3485,13 @@ mod tests {
 
             let expected = &[PLUGIN_A, PLUGIN_B];
 
-            let sorted = sort_plugins(data, &fixture.groups_graph, &[PLUGIN_A.into()]).unwrap();
+            let sorted = sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[PLUGIN_A.into()],
+                SortParallelism::Parallel,
+            )
+            .unwrap();
 
             assert_eq!(expected, sorted.as_slice());
         }
@@ -3343,7 +3502,9 @@ mod tests {
 
             let data = vec![fixture.group_sorting_data(PLUGIN_A, "missing")];
 
-            assert!(sort_plugins(data, &fixture.groups_graph, &[]).is_err());
+            assert!(
+                sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel).is_err()
+            );
         }
 
         #[test]
@@ -3358,7 +3519,7 @@ mod tests {
                 fixture.sorting_data(PLUGIN_B),
             ];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel) {
                 Err(SortingError::CycleFound(e)) => {
                     assert_eq!(
                         &[
@@ -3385,7 +3546,7 @@ mod tests {
                 fixture.sorting_data(PLUGIN_B),
             ];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3410,7 +3571,7 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3436,7 +3597,7 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3462,7 +3623,7 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3488,7 +3649,7 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3514,7 +3675,12 @@ mod tests {
                 fixture.sorting_data(PLUGIN_B),
             ];
 
-            match sort_plugins(data, &fixture.groups_graph, &[PLUGIN_B.into()]) {
+            match sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[PLUGIN_B.into()],
+                SortParallelism::Parallel,
+            ) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3547,7 +3713,8 @@ mod tests {
 
             let expected = &[PLUGIN_B, PLUGIN_A];
 
-            let sorted = sort_plugins(data, &fixture.groups_graph, &[]).unwrap();
+            let sorted =
+                sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel).unwrap();
 
             assert_eq!(expected, sorted.as_slice());
         }
@@ -3569,7 +3736,8 @@ mod tests {
 
             let expected = &[PLUGIN_B, PLUGIN_A];
 
-            let sorted = sort_plugins(data, &fixture.groups_graph, &[]).unwrap();
+            let sorted =
+                sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel).unwrap();
 
             assert_eq!(expected, sorted.as_slice());
         }
@@ -3589,7 +3757,7 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3619,7 +3787,7 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3650,7 +3818,7 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3679,7 +3847,7 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3710,7 +3878,7 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3740,7 +3908,7 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3771,7 +3939,7 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3800,7 +3968,7 @@ mod tests {
 
             let data = vec![a, fixture.sorting_data(PLUGIN_B)];
 
-            match sort_plugins(data, &fixture.groups_graph, &[]) {
+            match sort_plugins(data, &fixture.groups_graph, &[], SortParallelism::Parallel) {
                 Err(SortingError::ValidationError(PluginGraphValidationError::CycleFound(e))) => {
                     assert_eq!(
                         &[
@@ -3833,7 +4001,13 @@ mod tests {
 
             let expected = &[PLUGIN_A, PLUGIN_B];
 
-            let sorted = sort_plugins(data, &fixture.groups_graph, &[PLUGIN_B.into()]).unwrap();
+            let sorted = sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[PLUGIN_B.into()],
+                SortParallelism::Parallel,
+            )
+            .unwrap();
 
             assert_eq!(expected, sorted.as_slice());
         }
@@ -3853,7 +4027,13 @@ mod tests {
 
             let expected = &[PLUGIN_A, PLUGIN_B];
 
-            let sorted = sort_plugins(data, &fixture.groups_graph, &[PLUGIN_B.into()]).unwrap();
+            let sorted = sort_plugins(
+                data,
+                &fixture.groups_graph,
+                &[PLUGIN_B.into()],
+                SortParallelism::Parallel,
+            )
+            .unwrap();
 
             assert_eq!(expected, sorted.as_slice());
         }
@@ -0,0 +1,291 @@
+use petgraph::graph::NodeIndex;
+
+const WORD_BITS: usize = 64;
+const WORD_SHIFT: usize = 6;
+const BIT_MASK: usize = WORD_BITS - 1;
+
+fn bit(index: usize) -> u64 {
+    1_u64 << (index & BIT_MASK)
+}
+
+/// A dense set of node indices, stored as one bit per index. The set grows
+/// as higher indices are inserted, so untouched nodes cost nothing.
+#[derive(Clone, Debug, Default, PartialEq, Eq)]
+struct BitSet(Vec<u64>);
+
+impl BitSet {
+    fn contains(&self, index: usize) -> bool {
+        self.0
+            .get(index >> WORD_SHIFT)
+            .is_some_and(|word| word & bit(index) != 0)
+    }
+
+    fn insert(&mut self, index: usize) {
+        let word_index = index >> WORD_SHIFT;
+        if word_index >= self.0.len() {
+            self.0.resize(word_index + 1, 0);
+        }
+
+        if let Some(word) = self.0.get_mut(word_index) {
+            *word |= bit(index);
+        }
+    }
+
+    fn union_with(&mut self, other: &BitSet) {
+        if other.0.len() > self.0.len() {
+            self.0.resize(other.0.len(), 0);
+        }
+
+        for (word, other_word) in self.0.iter_mut().zip(&other.0) {
+            *word |= other_word;
+        }
+    }
+
+    fn iter(&self) -> impl Iterator<Item = usize> + '_ {
+        self.0
+            .iter()
+            .enumerate()
+            .filter(|(_, word)| **word != 0)
+            .flat_map(|(word_index, word)| {
+                let base = word_index << WORD_SHIFT;
+                (0..WORD_BITS)
+                    .filter(move |bit_index| word & (1_u64 << bit_index) != 0)
+                    .map(move |bit_index| base + bit_index)
+            })
+    }
+}
+
+/// The transitive closure of a directed graph, kept up to date as edges are
+/// added so that asking if there is a path between two nodes is a constant
+/// time lookup instead of a graph search.
+///
+/// Each node has a bitset of the nodes it can reach and a bitset of the nodes
+/// that can reach it. Adding an edge from A to B joins everything that can
+/// reach A to everything that B can reach, which only involves walking the
+/// nodes whose sets actually change. This holds whether or not the graph is
+/// acyclic.
+#[derive(Clone, Debug, Default)]
+pub(super) struct Reachability {
+    successors: Vec<BitSet>,
+    descendants: Vec<BitSet>,
+    ancestors: Vec<BitSet>,
+}
+
+impl Reachability {
+    /// Returns true if an edge from `from` to `to` has been added.
+    pub(super) fn has_edge(&self, from: NodeIndex, to: NodeIndex) -> bool {
+        self.successors
+            .get(from.index())
+            .is_some_and(|s| s.contains(to.index()))
+    }
+
+    /// Returns true if `to` can be reached from `from`. A node can always
+    /// reach itself.
+    pub(super) fn path_exists(&self, from: NodeIndex, to: NodeIndex) -> bool {
+        from == to
+            || self
+                .descendants
+                .get(from.index())
+                .is_some_and(|s| s.contains(to.index()))
+    }
+
+    pub(super) fn add_edge(&mut self, from: NodeIndex, to: NodeIndex) {
+        let from = from.index();
+        let to = to.index();
+
+        let min_len = from.max(to) + 1;
+        if self.successors.len() < min_len {
+            self.successors.resize_with(min_len, BitSet::default);
+            self.descendants.resize_with(min_len, BitSet::default);
+            self.ancestors.resize_with(min_len, BitSet::default);
+        }
+
+        if let Some(successors) = self.successors.get_mut(from) {
+            successors.insert(to);
+        }
+
+        if self.descendants.get(from).is_some_and(|d| d.contains(to)) {
+            // Everything that can reach from can already reach everything
+            // that to can reach, so there's nothing to update.
+            return;
+        }
+
+        let mut sources = self.ancestors.get(from).cloned().unwrap_or_default();
+        sources.insert(from);
+
+        let mut targets = self.descendants.get(to).cloned().unwrap_or_default();
+        targets.insert(to);
+
+        for source in sources.iter() {
+            if let Some(descendants) = self.descendants.get_mut(source) {
+                descendants.union_with(&targets);
+            }
+        }
+
+        for target in targets.iter() {
+            if let Some(ancestors) = self.ancestors.get_mut(target) {
+                ancestors.union_with(&sources);
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn node(index: usize) -> NodeIndex {
+        NodeIndex::new(index)
+    }
+
+    mod bit_set {
+        use super::*;
+
+        #[test]
+        fn contains_should_be_false_for_indices_past_the_end_of_the_set() {
+            let set = BitSet::default();
+
+            assert!(!set.contains(0));
+            assert!(!set.contains(1000));
+        }
+
+        #[test]
+        fn insert_should_grow_the_set_to_fit_the_index() {
+            let mut set = BitSet::default();
+            set.insert(130);
+
+            assert!(set.contains(130));
+            assert!(!set.contains(129));
+            assert!(!set.contains(131));
+            assert_eq!(3, set.0.len());
+        }
+
+        #[test]
+        fn union_with_should_include_bits_from_both_sets() {
+            let mut set = BitSet::default();
+            set.insert(1);
+
+            let mut other = BitSet::default();
+            other.insert(63);
+            other.insert(64);
+            other.insert(200);
+
+            set.union_with(&other);
+
+            assert_eq!(vec![1, 63, 64, 200], set.iter().collect::<Vec<_>>());
+        }
+
+        #[test]
+        fn iter_should_return_indices_in_ascending_order() {
+            let mut set = BitSet::default();
+            set.insert(70);
+            set.insert(3);
+            set.insert(0);
+            set.insert(127);
+
+            assert_eq!(vec![0, 3, 70, 127], set.iter().collect::<Vec<_>>());
+        }
+    }
+
+    mod reachability {
+        use super::*;
+
+        #[test]
+        fn a_node_should_always_reach_itself() {
+            let reachability = Reachability::default();
+
+            assert!(reachability.path_exists(node(5), node(5)));
+        }
+
+        #[test]
+        fn add_edge_should_record_the_edge_and_the_path() {
+            let mut reachability = Reachability::default();
+            reachability.add_edge(node(0), node(1));
+
+            assert!(reachability.has_edge(node(0), node(1)));
+            assert!(reachability.path_exists(node(0), node(1)));
+            assert!(!reachability.has_edge(node(1), node(0)));
+            assert!(!reachability.path_exists(node(1), node(0)));
+        }
+
+        #[test]
+        fn add_edge_should_not_record_transitive_paths_as_edges() {
+            let mut reachability = Reachability::default();
+            reachability.add_edge(node(0), node(1));
+            reachability.add_edge(node(1), node(2));
+
+            assert!(reachability.path_exists(node(0), node(2)));
+            assert!(!reachability.has_edge(node(0), node(2)));
+        }
+
+        #[test]
+        fn add_edge_should_join_the_ancestors_of_from_to_the_descendants_of_to() {
+            let mut reachability = Reachability::default();
+            reachability.add_edge(node(0), node(1));
+            reachability.add_edge(node(2), node(3));
+            reachability.add_edge(node(1), node(2));
+
+            assert!(reachability.path_exists(node(0), node(3)));
+            assert!(reachability.path_exists(node(0), node(2)));
+            assert!(reachability.path_exists(node(1), node(3)));
+            assert!(!reachability.path_exists(node(3), node(0)));
+            assert!(!reachability.path_exists(node(2), node(1)));
+        }
+
+        #[test]
+        fn add_edge_should_handle_cycles() {
+            let mut reachability = Reachability::default();
+            reachability.add_edge(node(0), node(1));
+            reachability.add_edge(node(1), node(2));
+            reachability.add_edge(node(2), node(0));
+
+            for from in 0..3_usize {
+                for to in 0..3_usize {
+                    assert!(
+                        reachability.path_exists(node(from), node(to)),
+                        "expected a path from {from} to {to}"
+                    );
+                }
+            }
+        }
+
+        #[test]
+        fn add_edge_should_match_a_graph_search() {
+            use petgraph::{Graph, algo::has_path_connecting};
+
+            // A fixed pseudo-random sequence of edges between 100 nodes,
+            // spanning several words per bitset.
+            const NODE_COUNT: usize = 100;
+            let mut graph = Graph::<(), ()>::new();
+            for _ in 0..NODE_COUNT {
+                graph.add_node(());
+            }
+
+            let mut reachability = Reachability::default();
+            let mut state = 12345_usize;
+            for _ in 0..150_usize {
+                state = state.wrapping_mul(1_103_515_245).wrapping_add(12345);
+                let from = (state >> 8_usize) & 127;
+                state = state.wrapping_mul(1_103_515_245).wrapping_add(12345);
+                let to = (state >> 8_usize) & 127;
+
+                if from < NODE_COUNT && to < NODE_COUNT {
+                    graph.add_edge(node(from), node(to), ());
+                    reachability.add_edge(node(from), node(to));
+                }
+            }
+
+            for from in graph.node_indices() {
+                for to in graph.node_indices() {
+                    assert_eq!(
+                        has_path_connecting(&graph, from, to, None),
+                        reachability.path_exists(from, to),
+                        "path from {} to {}",
+                        from.index(),
+                        to.index()
+                    );
+                }
+            }
+        }
+    }
+}
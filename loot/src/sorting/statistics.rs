@@ -0,0 +1,217 @@
+use std::{
+    collections::BTreeMap,
+    time::{Duration, Instant},
+};
+
+use crate::EdgeType;
+
+/// A phase of sorting a graph of plugins.
+#[derive(Clone, Copy, Debug, Eq, PartialEq, Ord, PartialOrd, Hash)]
+#[non_exhaustive]
+pub enum SortPhase {
+    /// Adding edges for masters, requirements, load after metadata and
+    /// early-loading plugins.
+    SpecificEdges,
+    /// Adding edges for plugin groups.
+    GroupEdges,
+    /// Adding edges between plugins with overlapping records or assets.
+    OverlapEdges,
+    /// Adding edges to make the sorted load order unique.
+    TieBreakEdges,
+    /// Checking the graph for cycles, which is done before and after the
+    /// edges that avoid cycles are added.
+    CycleChecks,
+    /// Topologically sorting the graph.
+    TopologicalSort,
+}
+
+/// Timings and counts collected while sorting plugins.
+///
+/// Masters, non-masters and blueprint masters are sorted in separate graphs,
+/// and the statistics for each graph are summed. As the graphs may be sorted
+/// in parallel, the sum of the phase durations may be greater than the total
+/// duration.
+#[derive(Clone, Debug, Default, Eq, PartialEq)]
+pub struct SortStatistics {
+    total_duration: Duration,
+    phase_durations: BTreeMap<SortPhase, Duration>,
+    node_count: usize,
+    edge_counts: BTreeMap<EdgeType, usize>,
+    path_query_count: usize,
+    path_search_count: usize,
+}
+
+impl SortStatistics {
+    /// Get the time taken to sort, from the start of validating the input to
+    /// getting the sorted load order.
+    pub fn total_duration(&self) -> Duration {
+        self.total_duration
+    }
+
+    /// Get the total time spent in the given phase.
+    pub fn phase_duration(&self, phase: SortPhase) -> Duration {
+        self.phase_durations
+            .get(&phase)
+            .copied()
+            .unwrap_or_default()
+    }
+
+    /// Get the time spent in each phase, ordered by phase.
+    pub fn phase_durations(&self) -> impl Iterator<Item = (SortPhase, Duration)> + '_ {
+        self.phase_durations.iter().map(|(p, d)| (*p, *d))
+    }
+
+    /// Get the number of plugins that were sorted.
+    pub fn node_count(&self) -> usize {
+        self.node_count
+    }
+
+    /// Get the number of edges of the given type that were added.
+    pub fn edge_count(&self, edge_type: EdgeType) -> usize {
+        self.edge_counts
+            .get(&edge_type)
+            .copied()
+            .unwrap_or_default()
+    }
+
+    /// Get the number of edges of each type that were added, ordered by edge
+    /// type. Edge types with no edges are omitted.
+    pub fn edge_counts(&self) -> impl Iterator<Item = (EdgeType, usize)> + '_ {
+        self.edge_counts.iter().map(|(t, c)| (*t, *c))
+    }
+
+    /// Get the number of times that sorting checked if there was a path
+    /// between two plugins. These checks are answered by a reachability index
+    /// that is kept up to date as edges are added.
+    pub fn path_query_count(&self) -> usize {
+        self.path_query_count
+    }
+
+    /// Get the number of path checks that also needed the path itself, which
+    /// involves searching the graph. The remaining checks were answered by the
+    /// reachability index alone.
+    pub fn path_search_count(&self) -> usize {
+        self.path_search_count
+    }
+
+    pub(super) fn set_total_duration(&mut self, duration: Duration) {
+        self.total_duration = duration;
+    }
+
+    pub(super) fn time<R>(&mut self, phase: SortPhase, f: impl FnOnce() -> R) -> R {
+        let start = Instant::now();
+        let result = f();
+        *self.phase_durations.entry(phase).or_default() += start.elapsed();
+        result
+    }
+
+    pub(super) fn add_node_count(&mut self, count: usize) {
+        self.node_count += count;
+    }
+
+    pub(super) fn add_edge(&mut self, edge_type: EdgeType) {
+        *self.edge_counts.entry(edge_type).or_default() += 1;
+    }
+
+    pub(super) fn add_path_queries(&mut self, query_count: usize, search_count: usize) {
+        self.path_query_count += query_count;
+        self.path_search_count += search_count;
+    }
+
+    pub(super) fn merge(&mut self, other: SortStatistics) {
+        for (phase, duration) in other.phase_durations {
+            *self.phase_durations.entry(phase).or_default() += duration;
+        }
+
+        for (edge_type, count) in other.edge_counts {
+            *self.edge_counts.entry(edge_type).or_default() += count;
+        }
+
+        self.node_count += other.node_count;
+        self.path_query_count += other.path_query_count;
+        self.path_search_count += other.path_search_count;
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn phase_duration_should_be_zero_for_a_phase_that_was_not_timed() {
+        let statistics = SortStatistics::default();
+
+        assert_eq!(
+            Duration::ZERO,
+            statistics.phase_duration(SortPhase::TopologicalSort)
+        );
+    }
+
+    #[test]
+    fn time_should_accumulate_durations_for_the_same_phase() {
+        let mut statistics = SortStatistics::default();
+
+        statistics.time(SortPhase::GroupEdges, || {
+            std::thread::sleep(Duration::from_millis(1));
+        });
+        let first = statistics.phase_duration(SortPhase::GroupEdges);
+        statistics.time(SortPhase::GroupEdges, || {
+            std::thread::sleep(Duration::from_millis(1));
+        });
+
+        assert!(first >= Duration::from_millis(1));
+        assert!(statistics.phase_duration(SortPhase::GroupEdges) > first);
+        assert_eq!(1, statistics.phase_durations().count());
+    }
+
+    #[test]
+    fn time_should_return_the_closure_result() {
+        let mut statistics = SortStatistics::default();
+
+        assert_eq!(5_u8, statistics.time(SortPhase::CycleChecks, || 5));
+    }
+
+    #[test]
+    fn edge_count_should_be_zero_for_an_edge_type_with_no_edges() {
+        let mut statistics = SortStatistics::default();
+        statistics.add_edge(EdgeType::Master);
+
+        assert_eq!(1, statistics.edge_count(EdgeType::Master));
+        assert_eq!(0, statistics.edge_count(EdgeType::TieBreak));
+        assert_eq!(
+            vec![(EdgeType::Master, 1)],
+            statistics.edge_counts().collect::<Vec<_>>()
+        );
+    }
+
+    #[test]
+    fn merge_should_sum_all_counts_and_phase_durations() {
+        let mut statistics = SortStatistics::default();
+        statistics.add_node_count(2);
+        statistics.add_edge(EdgeType::Master);
+        statistics.add_path_queries(5, 1);
+        statistics.time(SortPhase::OverlapEdges, || {});
+
+        let mut other = SortStatistics::default();
+        other.add_node_count(3);
+        other.add_edge(EdgeType::Master);
+        other.add_edge(EdgeType::TieBreak);
+        other.add_path_queries(7, 2);
+        other.time(SortPhase::TieBreakEdges, || {});
+
+        statistics.merge(other);
+
+        assert_eq!(5, statistics.node_count());
+        assert_eq!(2, statistics.edge_count(EdgeType::Master));
+        assert_eq!(1, statistics.edge_count(EdgeType::TieBreak));
+        assert_eq!(12, statistics.path_query_count());
+        assert_eq!(3, statistics.path_search_count());
+        assert_eq!(
+            vec![SortPhase::OverlapEdges, SortPhase::TieBreakEdges],
+            statistics
+                .phase_durations()
+                .map(|(p, _)| p)
+                .collect::<Vec<_>>()
+        );
+    }
+}
@@ -0,0 +1,159 @@
+#include "diagnosticsPanel.h"
+#include "log.h"
+#include "stallWatchdog.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QVBoxLayout>
+
+namespace {
+// Columns before the histogram buckets. Max and total follow them.
+enum Column { OperationColumn, CountColumn, FirstBucketColumn };
+
+QString bucketLabel(int bucket)
+{
+    const auto &limits = StallWatchdog::BucketLimitsMs;
+    auto format = [](qint64 ms) {
+        return ms >= 1000 ? QString("%1 s").arg(ms / 1000.0) : QString("%1 ms").arg(ms);
+    };
+    if (bucket == 0)
+        return QString("< %1").arg(format(limits.front()));
+    if (bucket == StallWatchdog::BucketCount - 1)
+        return QString("≥ %1").arg(format(limits.back()));
+    return QString("%1 – %2").arg(format(limits[bucket - 1]), format(limits[bucket]));
+}
+
+QTableWidgetItem *numberItem(qint64 value)
+{
+    auto *item = new QTableWidgetItem();
+    // Display role data so the column sorts numerically.
+    item->setData(Qt::DisplayRole, value);
+    item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    return item;
+}
+
+QString recentLine(const StallWatchdog::Stall &stall)
+{
+    return QString("%1  %2 ms  %3")
+        .arg(stall.when.toString("HH:mm:ss.zzz"))
+        .arg(stall.durationMs, 6)
+        .arg(stall.operation);
+}
+}
+
+DiagnosticsPanel::DiagnosticsPanel(StallWatchdog *watchdog, QWidget *parent)
+    : QWidget(parent), watchdog(watchdog)
+{
+    auto *layout = new QVBoxLayout(this);
+
+    auto *controls = new QHBoxLayout();
+    controls->addWidget(new QLabel("Report GUI stalls longer than", this));
+    thresholdSpin = new QSpinBox(this);
+    thresholdSpin->setRange(10, 5000);
+    thresholdSpin->setSingleStep(10);
+    thresholdSpin->setSuffix(" ms");
+    thresholdSpin->setValue(watchdog->thresholdMs());
+    controls->addWidget(thresholdSpin);
+    controls->addStretch(1);
+    clearButton = new QPushButton("Clear", this);
+    controls->addWidget(clearButton);
+    saveLogButton = new QPushButton("Save Recent Log...", this);
+    saveLogButton->setToolTip(QString("Save the last %1 log events").arg(Log::HistorySize));
+    controls->addWidget(saveLogButton);
+    layout->addLayout(controls);
+
+    logLabel = new QLabel(this);
+    logLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    if (!watchdog->logFile().isEmpty())
+        logLabel->setText(QString("Log: %1").arg(QDir::toNativeSeparators(watchdog->logFile())));
+    layout->addWidget(logLabel);
+
+    QStringList headers{"Operation", "Stalls"};
+    for (int bucket = 0; bucket < StallWatchdog::BucketCount; ++bucket)
+        headers << bucketLabel(bucket);
+    headers << "Max (ms)" << "Total (ms)";
+
+    histogramTable = new QTableWidget(0, static_cast<int>(headers.size()), this);
+    histogramTable->setHorizontalHeaderLabels(headers);
+    histogramTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    histogramTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    histogramTable->verticalHeader()->setVisible(false);
+    histogramTable->horizontalHeader()->setSectionResizeMode(OperationColumn, QHeaderView::Stretch);
+    histogramTable->horizontalHeader()->setSortIndicator(CountColumn, Qt::DescendingOrder);
+    histogramTable->setSortingEnabled(true);
+    layout->addWidget(histogramTable, 2);
+
+    layout->addWidget(new QLabel("Recent stalls", this));
+    recentView = new QPlainTextEdit(this);
+    recentView->setReadOnly(true);
+    recentView->setLineWrapMode(QPlainTextEdit::NoWrap);
+    recentView->setMaximumBlockCount(200);
+    layout->addWidget(recentView, 1);
+
+    connect(thresholdSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int ms) {
+        this->watchdog->setThresholdMs(ms);
+        emit thresholdChanged(this->watchdog->thresholdMs());
+    });
+    connect(clearButton, &QPushButton::clicked, watchdog, &StallWatchdog::clear);
+    connect(saveLogButton, &QPushButton::clicked, this, &DiagnosticsPanel::saveRecentLog);
+    connect(watchdog, &StallWatchdog::cleared, this, [this]() {
+        rebuildHistogram();
+        rebuildRecent();
+    });
+    connect(watchdog, &StallWatchdog::stallRecorded, this, [this]() {
+        // Stalls are rare, so rebuilding the whole table is fine.
+        rebuildHistogram();
+        recentView->appendPlainText(recentLine(this->watchdog->recentStalls().constLast()));
+    });
+
+    rebuildHistogram();
+    rebuildRecent();
+}
+
+void DiagnosticsPanel::rebuildHistogram()
+{
+    const auto &stats = watchdog->operationStats();
+    const int maxColumn = FirstBucketColumn + StallWatchdog::BucketCount;
+
+    // Rows move around while sorting is on.
+    histogramTable->setSortingEnabled(false);
+    histogramTable->setRowCount(static_cast<int>(stats.size()));
+    int row = 0;
+    for (auto it = stats.constBegin(); it != stats.constEnd(); ++it, ++row) {
+        histogramTable->setItem(row, OperationColumn, new QTableWidgetItem(it.key()));
+        histogramTable->setItem(row, CountColumn, numberItem(it->count));
+        for (int bucket = 0; bucket < StallWatchdog::BucketCount; ++bucket)
+            histogramTable->setItem(row, FirstBucketColumn + bucket,
+                                    numberItem(it->buckets[static_cast<size_t>(bucket)]));
+        histogramTable->setItem(row, maxColumn, numberItem(it->maxMs));
+        histogramTable->setItem(row, maxColumn + 1, numberItem(it->totalMs));
+    }
+    histogramTable->setSortingEnabled(true);
+}
+
+void DiagnosticsPanel::rebuildRecent()
+{
+    recentView->clear();
+    for (const StallWatchdog::Stall &stall : watchdog->recentStalls())
+        recentView->appendPlainText(recentLine(stall));
+}
+
+void DiagnosticsPanel::saveRecentLog()
+{
+    // Next to the stall log, which is in the workspace.
+    QString suggested = watchdog->logFile().isEmpty()
+                            ? QDir::homePath()
+                            : QFileInfo(watchdog->logFile()).absolutePath();
+    suggested += QString("/nordic-%1.log").arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss"));
+
+    const QString path = QFileDialog::getSaveFileName(this, "Save Recent Log", suggested,
+                                                      "Log files (*.log *.txt)");
+    if (path.isEmpty())
+        return;
+    if (!Log::dumpRecent(path))
+        QMessageBox::warning(this, "Error", QString("Failed to write %1").arg(path));
+}
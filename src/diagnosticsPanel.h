@@ -0,0 +1,40 @@
+#ifndef DIAGNOSTICSPANEL_H
+#define DIAGNOSTICSPANEL_H
+
+#include <QWidget>
+#include <QLabel>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTableWidget>
+
+class StallWatchdog;
+
+// Shows the GUI stalls a StallWatchdog has recorded: a histogram of stall
+// durations per operation and the most recent stalls. Also saves the recent
+// log events to a file.
+class DiagnosticsPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit DiagnosticsPanel(StallWatchdog *watchdog, QWidget *parent = nullptr);
+
+signals:
+    void thresholdChanged(int ms);
+
+private:
+    void rebuildHistogram();
+    void rebuildRecent();
+    void saveRecentLog();
+
+    StallWatchdog *watchdog;
+    QSpinBox *thresholdSpin = nullptr;
+    QPushButton *clearButton = nullptr;
+    QPushButton *saveLogButton = nullptr;
+    QLabel *logLabel = nullptr;
+    QTableWidget *histogramTable = nullptr;
+    QPlainTextEdit *recentView = nullptr;
+};
+
+#endif // DIAGNOSTICSPANEL_H
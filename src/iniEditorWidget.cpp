@@ -1,21 +1,41 @@
 #include "iniEditorWidget.h"
+#include "iniFileIndex.h"
+#include "jobScheduler.h"
+#include "stallWatchdog.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
-#include <QDirIterator>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QTextStream>
 #include <QMessageBox>
 
+namespace {
+// Found files are handed to the GUI thread in batches of this many, or
+// after BatchIntervalMs, whichever comes first.
+constexpr int BatchSize = 200;
+constexpr qint64 BatchIntervalMs = 100;
+// Watches are a limited resource (inotify), so only the folders most likely
+// to gain or lose INI files are watched.
+constexpr int MaxWatchedDirectoriesPerRoot = 2000;
+constexpr int RescanDelayMs = 1000;
+}
+
 IniEditorWidget::IniEditorWidget(QWidget *parent)
     : QWidget(parent)
 {
     auto *mainLayout = new QVBoxLayout(this);
 
     auto *contentLayout = new QHBoxLayout();
+    auto *listLayout = new QVBoxLayout();
     fileList = new QListWidget(this);
     fileList->setSelectionMode(QAbstractItemView::SingleSelection);
-    contentLayout->addWidget(fileList, 1);
+    listLayout->addWidget(fileList, 1);
+    statusLabel = new QLabel(this);
+    listLayout->addWidget(statusLabel);
+    contentLayout->addLayout(listLayout, 1);
 
     editor = new QPlainTextEdit(this);
     editor->setPlaceholderText("Select an INI file to view or edit.");
@@ -30,6 +50,15 @@ IniEditorWidget::IniEditorWidget(QWidget *parent)
             this, &IniEditorWidget::onFileSelected);
     connect(saveButton, &QPushButton::clicked,
             this, &IniEditorWidget::onSaveClicked);
+
+    index = std::make_shared<IniFileIndex>();
+    watcher = new QFileSystemWatcher(this);
+    rescanTimer = new QTimer(this);
+    rescanTimer->setSingleShot(true);
+    rescanTimer->setInterval(RescanDelayMs);
+    connect(watcher, &QFileSystemWatcher::directoryChanged,
+            rescanTimer, qOverload<>(&QTimer::start));
+    connect(rescanTimer, &QTimer::timeout, this, &IniEditorWidget::refreshFiles);
 }
 
 void IniEditorWidget::setIniRoots(const QList<QPair<QString, QString>> &roots)
@@ -40,29 +69,134 @@ void IniEditorWidget::setIniRoots(const QList<QPair<QString, QString>> &roots)
 
 void IniEditorWidget::refreshFiles()
 {
-    fileList->clear();
-    editor->clear();
-    currentFilePath.clear();
+    UI_OPERATION("IniEditorWidget::refreshFiles");
+    if (!jobs) {
+        qWarning() << "[IniEditor] No job scheduler to search for INI files with";
+        return;
+    }
+
+    // The list is kept while searching. Files found again keep their items,
+    // so the selection and the open file survive, and the rest are removed
+    // once the search is done.
+    const quint64 generation = ++scanGeneration;
+    foundPaths.clear();
+    rescanTimer->stop();
+    statusLabel->setText("Searching for INI files...");
+
+    JobScheduler::Job job;
+    job.key = QStringLiteral("ini-scan");
+    job.description = QStringLiteral("Finding INI files");
+    job.priority = JobScheduler::Priority::Background;
+    job.resource = QStringLiteral("ini");
+
+    auto watchDirectories = std::make_shared<QStringList>();
+    const std::shared_ptr<IniFileIndex> fileIndex = index;
+    const QList<QPair<QString, QString>> roots = iniRoots;
+    job.run = [this, fileIndex, roots, generation, watchDirectories](const JobContext &context) {
+        FoundFiles batch;
+        QElapsedTimer sinceBatch;
+        sinceBatch.start();
+        auto send = [&]() {
+            if (batch.isEmpty())
+                return;
+            // Queued to the widget, so it's dropped if the widget is gone.
+            QMetaObject::invokeMethod(this, [this, generation, files = std::move(batch)]() {
+                addFiles(generation, files);
+            }, Qt::QueuedConnection);
+            batch = FoundFiles();
+            sinceBatch.restart();
+        };
+
+        QStringList rootPaths;
+        for (const auto &root : roots) {
+            rootPaths.append(root.first);
+            const QDir base(root.first);
+            if (!base.exists())
+                continue;
+
+            const bool finished = fileIndex->scan(
+                root.first,
+                [&context]() { return context.isCancelled(); },
+                [&](const QStringList &files) {
+                    for (const QString &path : files)
+                        batch.append({path, QString("%1: %2").arg(root.second, base.relativeFilePath(path))});
+                    if (batch.size() >= BatchSize || sinceBatch.elapsed() >= BatchIntervalMs)
+                        send();
+                });
+            if (!finished)
+                return;
+            *watchDirectories += fileIndex->watchDirectories(root.first, MaxWatchedDirectoriesPerRoot);
+        }
+        send();
+        fileIndex->retainRoots(rootPaths);
+    };
+    job.finished = [this, generation, watchDirectories]() {
+        finishScan(generation, *watchDirectories);
+    };
+
+    // A search already under way is for the old roots or is out of date.
+    jobs->cancelKey(job.key);
+    jobs->schedule(std::move(job));
+}
+
+void IniEditorWidget::addFiles(quint64 generation, const FoundFiles &files)
+{
+    UI_OPERATION("IniEditorWidget::addFiles");
+    if (generation != scanGeneration)
+        return;
 
-    for (const auto &root : iniRoots) {
-        QDir base(root.first);
-        if (!base.exists())
+    for (const auto &file : files) {
+        foundPaths.insert(file.first);
+        if (QListWidgetItem *existing = itemsByPath.value(file.first)) {
+            // The root may have been relabelled.
+            existing->setText(file.second);
             continue;
+        }
+        auto *item = new QListWidgetItem(file.second, fileList);
+        item->setData(Qt::UserRole, file.first);
+        item->setToolTip(file.first);
+        itemsByPath.insert(file.first, item);
+    }
+    statusLabel->setText(QString("Searching for INI files... %1 found").arg(foundPaths.size()));
+}
+
+void IniEditorWidget::finishScan(quint64 generation, const QStringList &watchDirectories)
+{
+    UI_OPERATION("IniEditorWidget::finishScan");
+    if (generation != scanGeneration)
+        return;
 
-        QDirIterator it(root.first,
-                        QStringList() << "*.ini" << "*.INI",
-                        QDir::Files,
-                        QDirIterator::Subdirectories);
-
-        while (it.hasNext()) {
-            QString path = it.next();
-            QString rel = base.relativeFilePath(path);
-            QString label = QString("%1: %2").arg(root.second, rel);
-            auto *item = new QListWidgetItem(label, fileList);
-            item->setData(Qt::UserRole, path);
-            item->setToolTip(path);
+    for (auto it = itemsByPath.begin(); it != itemsByPath.end();) {
+        if (foundPaths.contains(it.key())) {
+            ++it;
+            continue;
+        }
+        if (it.key() == currentFilePath) {
+            editor->clear();
+            currentFilePath.clear();
         }
+        delete it.value();
+        it = itemsByPath.erase(it);
+    }
+    statusLabel->setText(QString("%1 INI files").arg(itemsByPath.size()));
+
+    const QStringList watched = watcher->directories();
+    const QSet<QString> wanted(watchDirectories.cbegin(), watchDirectories.cend());
+    QStringList stale;
+    for (const QString &path : watched) {
+        if (!wanted.contains(path))
+            stale.append(path);
+    }
+    if (!stale.isEmpty())
+        watcher->removePaths(stale);
+    const QSet<QString> current(watched.cbegin(), watched.cend());
+    QStringList added;
+    for (const QString &path : watchDirectories) {
+        if (!current.contains(path))
+            added.append(path);
     }
+    if (!added.isEmpty())
+        watcher->addPaths(added);
 }
 
 void IniEditorWidget::onFileSelected(QListWidgetItem *item)
@@ -75,6 +209,7 @@ void IniEditorWidget::onFileSelected(QListWidgetItem *item)
 
 void IniEditorWidget::loadFile(const QString &path)
 {
+    UI_OPERATION("IniEditorWidget::loadFile");
     QFile file(path);
     if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
         QMessageBox::warning(this, "Error",
@@ -89,6 +224,7 @@ void IniEditorWidget::loadFile(const QString &path)
 
 void IniEditorWidget::onSaveClicked()
 {
+    UI_OPERATION("IniEditorWidget::onSaveClicked");
     if (currentFilePath.isEmpty())
         return;
 
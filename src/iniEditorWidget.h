@@ -6,13 +6,31 @@
 #include <QListWidgetItem>
 #include <QPlainTextEdit>
 #include <QPushButton>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QLabel>
+#include <QSet>
+#include <QTimer>
+#include <QVector>
+#include <memory>
 
+class IniFileIndex;
+class JobScheduler;
+
+// Lists the INI files under a set of root folders and edits them.
+//
+// The folders are searched by a background job, which adds files to the list
+// as it finds them and keeps each folder's listing for the next search. A
+// watcher on the folders that matter searches again when files come and go.
 class IniEditorWidget : public QWidget
 {
     Q_OBJECT
 public:
     explicit IniEditorWidget(QWidget *parent = nullptr);
 
+    // Must be set before the first refreshFiles().
+    void setJobScheduler(JobScheduler *scheduler) { jobs = scheduler; }
+    // Pairs of folder path and the label shown before its files.
     void setIniRoots(const QList<QPair<QString, QString>> &roots);
 
 public slots:
@@ -23,13 +41,31 @@ private slots:
     void onSaveClicked();
 
 private:
+    // Absolute path and list label.
+    using FoundFiles = QVector<QPair<QString, QString>>;
+
     QList<QPair<QString, QString>> iniRoots;
     QListWidget *fileList = nullptr;
+    QLabel *statusLabel = nullptr;
     QPlainTextEdit *editor = nullptr;
     QPushButton *saveButton = nullptr;
     QString currentFilePath;
 
+    JobScheduler *jobs = nullptr;
+    // Only used by the search job, which holds the "ini" resource.
+    std::shared_ptr<IniFileIndex> index;
+    QFileSystemWatcher *watcher = nullptr;
+    // Collects watcher notifications into one search.
+    QTimer *rescanTimer = nullptr;
+    // Batches from older searches are ignored.
+    quint64 scanGeneration = 0;
+    QHash<QString, QListWidgetItem*> itemsByPath;
+    // Paths the current search has found so far.
+    QSet<QString> foundPaths;
+
     void loadFile(const QString &path);
+    void addFiles(quint64 generation, const FoundFiles &files);
+    void finishScan(quint64 generation, const QStringList &watchDirectories);
 };
 
 #endif // INIEDITORWIDGET_H
@@ -0,0 +1,117 @@
+#include "iniFileIndex.h"
+#include "trace.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QSet>
+
+namespace {
+// Folder times can be this coarse (FAT). A folder changed more recently than
+// this may change again without its time moving, so its listing is re-read
+// next time.
+constexpr qint64 TimestampGranularityMs = 2000;
+}
+
+IniFileIndex::Directory IniFileIndex::list(const QString &path, qint64 modifiedMs)
+{
+    Directory directory;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    directory.modifiedMs = now - modifiedMs > TimestampGranularityMs ? modifiedMs : -1;
+
+    const QFileInfoList entries = QDir(path).entryInfoList(
+        QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden, QDir::Name);
+    for (const QFileInfo &entry : entries) {
+        if (entry.isDir()) {
+            // Like QDirIterator, don't follow links into other folders.
+            if (!entry.isSymLink())
+                directory.subdirectories.append(entry.absoluteFilePath());
+        } else if (entry.suffix().compare(QLatin1String("ini"), Qt::CaseInsensitive) == 0) {
+            directory.iniFiles.append(entry.absoluteFilePath());
+        }
+    }
+    return directory;
+}
+
+bool IniFileIndex::scan(const QString &root,
+                        const std::function<bool()> &cancelled,
+                        const std::function<void(const QStringList &)> &found)
+{
+    Trace::Span span("ini", "IniFileIndex::scan");
+    span.setDetail(root);
+
+    const QHash<QString, Directory> &cached = roots[root];
+    QHash<QString, Directory> visited;
+    visited.reserve(cached.size());
+    int relisted = 0;
+
+    QStringList pending{QDir(root).absolutePath()};
+    while (!pending.isEmpty()) {
+        if (cancelled())
+            return false;
+
+        const QString path = pending.takeLast();
+        const QFileInfo info(path);
+        if (!info.isDir())
+            continue;
+
+        const qint64 modifiedMs = info.lastModified().toMSecsSinceEpoch();
+        auto it = cached.constFind(path);
+        Directory directory;
+        if (it != cached.constEnd() && it->modifiedMs >= 0 && it->modifiedMs == modifiedMs) {
+            directory = *it;
+        } else {
+            directory = list(path, modifiedMs);
+            ++relisted;
+        }
+
+        if (!directory.iniFiles.isEmpty())
+            found(directory.iniFiles);
+        // Reversed so folders come out in name order.
+        for (auto sub = directory.subdirectories.crbegin(); sub != directory.subdirectories.crend(); ++sub)
+            pending.append(*sub);
+        visited.insert(path, std::move(directory));
+    }
+
+    if (span.isActive())
+        span.setDetail(QString("%1: %2 folders, %3 re-listed").arg(root).arg(visited.size()).arg(relisted));
+    roots[root] = std::move(visited);
+    return true;
+}
+
+void IniFileIndex::retainRoots(const QStringList &keep)
+{
+    for (auto it = roots.begin(); it != roots.end();) {
+        if (keep.contains(it.key()))
+            ++it;
+        else
+            it = roots.erase(it);
+    }
+}
+
+QStringList IniFileIndex::watchDirectories(const QString &root, int limit) const
+{
+    const auto rootIt = roots.constFind(root);
+    if (rootIt == roots.constEnd())
+        return {};
+
+    const QString rootPath = QDir(root).absolutePath();
+    QStringList directories{rootPath};
+    QSet<QString> added{rootPath};
+    auto add = [&](const QString &path) {
+        if (directories.size() < limit && !added.contains(path)) {
+            added.insert(path);
+            directories.append(path);
+        }
+    };
+
+    const auto top = rootIt->constFind(rootPath);
+    if (top != rootIt->constEnd()) {
+        for (const QString &sub : top->subdirectories)
+            add(sub);
+    }
+    for (auto it = rootIt->constBegin(); it != rootIt->constEnd(); ++it) {
+        if (!it->iniFiles.isEmpty())
+            add(it.key());
+    }
+    return directories;
+}
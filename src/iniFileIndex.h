@@ -0,0 +1,49 @@
+#ifndef INIFILEINDEX_H
+#define INIFILEINDEX_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <functional>
+
+// Finds the INI files under a set of root folders.
+//
+// Each folder's listing is kept with the folder's modification time, which
+// changes when entries are added, removed or renamed. A rescan still visits
+// every folder but only re-lists the ones whose time changed, so repeating
+// it over a large, mostly unchanged Mods tree costs one stat per folder.
+//
+// Not thread-safe. The INI editor uses it from one job at a time.
+class IniFileIndex
+{
+public:
+    // Calls found with the INI files (absolute paths) of each folder as it
+    // goes, and stops early once cancelled returns true. Returns false if it
+    // stopped early, in which case the cached listings are left as they were.
+    bool scan(const QString &root,
+              const std::function<bool()> &cancelled,
+              const std::function<void(const QStringList &)> &found);
+
+    // Drops the listings of roots not in roots.
+    void retainRoots(const QStringList &roots);
+
+    // Folders worth watching for changes under root, from its last scan: the
+    // root, its immediate subfolders and every folder holding INI files.
+    QStringList watchDirectories(const QString &root, int limit) const;
+
+private:
+    struct Directory {
+        // -1 if the listing was read too soon after the folder last
+        // changed to trust the time.
+        qint64 modifiedMs = -1;
+        QStringList iniFiles;
+        QStringList subdirectories;
+    };
+
+    static Directory list(const QString &path, qint64 modifiedMs);
+
+    // Root path -> folder path -> listing.
+    QHash<QString, QHash<QString, Directory>> roots;
+};
+
+#endif // INIFILEINDEX_H
@@ -0,0 +1,259 @@
+#include "jobScheduler.h"
+#include "stallWatchdog.h"
+#include "trace.h"
+#include <QMetaObject>
+#include <algorithm>
+#include <vector>
+
+void JobContext::setProgress(int percent) const
+{
+    JobScheduler *target = scheduler;
+    const quint64 job = id;
+    QMetaObject::invokeMethod(target, [target, job, percent]() {
+        target->onJobProgress(job, percent);
+    }, Qt::QueuedConnection);
+}
+
+JobScheduler::JobScheduler(QObject *parent)
+    : QObject(parent)
+{
+}
+
+JobScheduler::~JobScheduler()
+{
+    cancelAndWait();
+}
+
+JobScheduler::JobId JobScheduler::schedule(Job job)
+{
+    if (!job.key.isEmpty()) {
+        for (auto it = jobs.begin(); it != jobs.end(); ++it) {
+            if (it->job.key != job.key)
+                continue;
+
+            if (it->state == State::Pending) {
+                // Coalesce: the newest request wins, but still waits for
+                // everything either request was waiting for.
+                QList<JobId> dependsOn = it->job.dependsOn;
+                for (JobId dependency : job.dependsOn) {
+                    if (dependency != it.key() && !dependsOn.contains(dependency))
+                        dependsOn.append(dependency);
+                }
+                job.dependsOn = dependsOn;
+                job.priority = std::max(job.priority, it->job.priority);
+                it->job = std::move(job);
+
+                const JobId id = it.key();
+                dispatch();
+                reportActivity();
+                return id;
+            }
+
+            // The running job may have read state that this request
+            // changes, so run again once it's done.
+            if (!job.dependsOn.contains(it.key()))
+                job.dependsOn.append(it.key());
+        }
+    }
+
+    const JobId id = nextId++;
+    Entry entry;
+    entry.job = std::move(job);
+    jobs.insert(id, std::move(entry));
+    ++totalCount;
+
+    dispatch();
+    reportActivity();
+    return id;
+}
+
+JobScheduler::JobId JobScheduler::find(const QString &key) const
+{
+    if (key.isEmpty())
+        return 0;
+
+    // Prefer the newest, which is the pending one if there is one.
+    JobId newest = 0;
+    for (auto it = jobs.constBegin(); it != jobs.constEnd(); ++it) {
+        if (it->job.key == key)
+            newest = std::max(newest, it.key());
+    }
+    return newest;
+}
+
+void JobScheduler::cancel(JobId id)
+{
+    auto it = jobs.find(id);
+    if (it == jobs.end())
+        return;
+
+    it->cancelled->store(true, std::memory_order_relaxed);
+    if (it->state == State::Pending)
+        drop(id);
+
+    // Anything waiting on this job would run against state it never produced.
+    std::vector<JobId> dependents;
+    for (auto dependent = jobs.constBegin(); dependent != jobs.constEnd(); ++dependent) {
+        if (dependent->state == State::Pending && dependent->job.dependsOn.contains(id))
+            dependents.push_back(dependent.key());
+    }
+    for (JobId dependent : dependents)
+        cancel(dependent);
+
+    reportActivity();
+}
+
+void JobScheduler::cancelKey(const QString &key)
+{
+    std::vector<JobId> matching;
+    for (auto it = jobs.constBegin(); it != jobs.constEnd(); ++it) {
+        if (it->job.key == key)
+            matching.push_back(it.key());
+    }
+    for (JobId id : matching)
+        cancel(id);
+}
+
+void JobScheduler::cancelAll()
+{
+    const QList<JobId> ids = jobs.keys();
+    for (JobId id : ids)
+        cancel(id);
+}
+
+void JobScheduler::cancelAndWait()
+{
+    STALL_SCOPE("JobScheduler::cancelAndWait");
+    cancelAll();
+    pool.waitForDone();
+}
+
+void JobScheduler::dispatch()
+{
+    std::vector<JobId> ready;
+    for (auto it = jobs.constBegin(); it != jobs.constEnd(); ++it) {
+        if (it->state != State::Pending)
+            continue;
+        bool waiting = std::any_of(it->job.dependsOn.cbegin(), it->job.dependsOn.cend(),
+                                   [this](JobId dependency) { return jobs.contains(dependency); });
+        if (!waiting)
+            ready.push_back(it.key());
+    }
+
+    std::sort(ready.begin(), ready.end(), [this](JobId lhs, JobId rhs) {
+        const Priority left = jobs.constFind(lhs)->job.priority;
+        const Priority right = jobs.constFind(rhs)->job.priority;
+        if (left != right)
+            return left > right;
+        return lhs < rhs;
+    });
+
+    for (JobId id : ready) {
+        const QString &resource = jobs.constFind(id)->job.resource;
+        if (!resource.isEmpty() && busyResources.contains(resource))
+            continue;
+        start(id);
+    }
+}
+
+void JobScheduler::start(JobId id)
+{
+    auto it = jobs.find(id);
+    if (it == jobs.end())
+        return;
+
+    it->state = State::Running;
+    it->clock.start();
+    if (!it->job.resource.isEmpty())
+        busyResources.insert(it->job.resource);
+    activeId = id;
+
+    if (it->job.started)
+        it->job.started();
+
+    // started() must not schedule or cancel jobs, but look the entry up again
+    // rather than rely on that.
+    it = jobs.find(id);
+    if (it == jobs.end())
+        return;
+
+    JobContext context(this, id, it->cancelled);
+    std::function<void(const JobContext &)> run = it->job.run;
+    const QString description = it->job.description;
+    pool.start([this, id, context, run, description]() {
+        if (run && !context.isCancelled()) {
+            Trace::Span span("job", description);
+            run(context);
+        }
+        QMetaObject::invokeMethod(this, [this, id]() { onJobDone(id); }, Qt::QueuedConnection);
+    }, static_cast<int>(it->job.priority));
+}
+
+void JobScheduler::onJobProgress(JobId id, int percent)
+{
+    auto it = jobs.find(id);
+    if (it == jobs.end())
+        return;
+
+    it->percent = percent;
+    if (id == activeId)
+        reportActivity();
+}
+
+void JobScheduler::onJobDone(JobId id)
+{
+    auto it = jobs.find(id);
+    if (it == jobs.end())
+        return;
+
+    // finished() may schedule more jobs, which can invalidate the iterator.
+    const bool cancelled = it->cancelled->load(std::memory_order_relaxed);
+    const std::function<void()> finished = it->job.finished;
+    const QString resource = it->job.resource;
+    const QString description = it->job.description;
+    const QElapsedTimer clock = it->clock;
+
+    if (!cancelled && finished) {
+        STALL_SCOPE("JobScheduler::finished");
+        finished();
+    }
+    emit jobFinished(description, clock.elapsed(), cancelled);
+
+    if (!resource.isEmpty())
+        busyResources.remove(resource);
+    drop(id);
+
+    dispatch();
+    reportActivity();
+}
+
+void JobScheduler::drop(JobId id)
+{
+    if (jobs.remove(id) > 0)
+        ++completedCount;
+    if (activeId == id)
+        activeId = 0;
+}
+
+void JobScheduler::reportActivity()
+{
+    if (jobs.isEmpty()) {
+        completedCount = 0;
+        totalCount = 0;
+        emit activityChanged(QString(), 0, 0, -1);
+        return;
+    }
+
+    auto active = jobs.constFind(activeId);
+    if (active == jobs.constEnd() || active->state != State::Running) {
+        active = std::find_if(jobs.constBegin(), jobs.constEnd(),
+                              [](const Entry &entry) { return entry.state == State::Running; });
+    }
+
+    if (active == jobs.constEnd()) {
+        emit activityChanged(tr("Waiting..."), completedCount, totalCount, -1);
+        return;
+    }
+
+    emit activityChanged(active->job.description, completedCount, totalCount, active->percent);
+}
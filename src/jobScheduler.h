@@ -0,0 +1,132 @@
+#ifndef JOBSCHEDULER_H
+#define JOBSCHEDULER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+class JobScheduler;
+
+// Handed to a job's work function so it can stop early and report how far it
+// has got. Safe to use from the pool thread the job runs on.
+class JobContext
+{
+public:
+    bool isCancelled() const { return cancelled->load(std::memory_order_relaxed); }
+    // 0-100, or -1 if the job can't tell how far along it is.
+    void setProgress(int percent) const;
+
+private:
+    friend class JobScheduler;
+    JobContext(JobScheduler *scheduler, quint64 id, std::shared_ptr<std::atomic<bool>> cancelled)
+        : scheduler(scheduler), id(id), cancelled(std::move(cancelled)) {}
+
+    JobScheduler *scheduler;
+    quint64 id;
+    std::shared_ptr<std::atomic<bool>> cancelled;
+};
+
+// Runs the app's slow operations (installs, rescans, LOOT metadata, git,
+// sorting) on a thread pool so the GUI thread never waits on them.
+//
+// All bookkeeping happens on the thread that owns the scheduler. A job runs
+// once its dependencies have finished and no other job holding the same
+// resource is running. Scheduling a job whose key matches one that hasn't
+// started yet merges the two, so repeated clicks only do the work once.
+class JobScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    using JobId = quint64;
+
+    enum class Priority { Background, Normal, Interactive };
+
+    struct Job {
+        // Pending jobs with the same non-empty key are coalesced: the newest
+        // functions win and the dependencies are merged.
+        QString key;
+        // Shown in the status bar while the job runs.
+        QString description;
+        Priority priority = Priority::Normal;
+        QList<JobId> dependsOn;
+        // Jobs that touch the same non-thread-safe object share a resource
+        // name and never run at the same time.
+        QString resource;
+        // Runs on the owning thread just before the job is handed to the pool,
+        // to snapshot state that other jobs' finished() calls may have changed.
+        std::function<void()> started;
+        // Runs on a pool thread.
+        std::function<void(const JobContext &)> run;
+        // Runs on the owning thread after run() returns, unless the job was
+        // cancelled. The job's resource is still held until this returns.
+        std::function<void()> finished;
+    };
+
+    explicit JobScheduler(QObject *parent = nullptr);
+    ~JobScheduler() override;
+
+    JobId schedule(Job job);
+
+    // The newest pending or running job with the given key, or 0.
+    JobId find(const QString &key) const;
+    bool isResourceBusy(const QString &resource) const { return busyResources.contains(resource); }
+    bool isIdle() const { return jobs.isEmpty(); }
+
+    // Pending jobs are dropped, running jobs are asked to stop and their
+    // finished() calls are skipped. Jobs depending on a cancelled job are
+    // cancelled too.
+    void cancel(JobId id);
+    void cancelKey(const QString &key);
+    void cancelAll();
+
+    // Cancels everything and waits for running jobs to return, e.g. before
+    // replacing an object that running jobs use. Scheduling can carry on
+    // afterwards.
+    void cancelAndWait();
+
+signals:
+    // completed and total count the jobs since the scheduler was last idle.
+    // percent is the running job's progress, or -1 if unknown. total is 0
+    // once everything has finished.
+    void activityChanged(const QString &description, int completed, int total, int percent);
+    // A started job has returned. elapsedMs runs from just before started()
+    // until run() returned and, unless the job was cancelled, finished() did.
+    void jobFinished(const QString &description, qint64 elapsedMs, bool cancelled);
+
+private:
+    enum class State { Pending, Running };
+
+    struct Entry {
+        Job job;
+        State state = State::Pending;
+        std::shared_ptr<std::atomic<bool>> cancelled = std::make_shared<std::atomic<bool>>(false);
+        int percent = -1;
+        QElapsedTimer clock;
+    };
+
+    friend class JobContext;
+    void dispatch();
+    void start(JobId id);
+    void onJobProgress(JobId id, int percent);
+    void onJobDone(JobId id);
+    void drop(JobId id);
+    void reportActivity();
+
+    QThreadPool pool;
+    QHash<JobId, Entry> jobs;
+    QSet<QString> busyResources;
+    JobId nextId = 1;
+    JobId activeId = 0;  // most recently started running job, for the status bar
+    int completedCount = 0;
+    int totalCount = 0;
+};
+
+#endif // JOBSCHEDULER_H
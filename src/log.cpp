@@ -0,0 +1,360 @@
+#include "log.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QThread>
+#include <QWaitCondition>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace Log {
+
+namespace internal {
+std::atomic<int> minLevel{static_cast<int>(Level::Debug)};
+}
+
+namespace {
+constexpr int FlushIntervalMs = 100;
+
+struct Event {
+    qint64 timestampUs = 0;  // since the epoch
+    Level level = Level::Debug;
+    const char *category = nullptr;
+    quint32 thread = 0;
+    QString message;
+    std::vector<Field> fields;
+};
+
+// Single producer (the owning thread), single consumer (whoever holds
+// drainMutex). A full buffer drops new events rather than waiting.
+class ThreadBuffer
+{
+public:
+    static constexpr size_t Capacity = 1024;  // power of two
+
+    explicit ThreadBuffer(quint32 thread) : thread(thread) {}
+
+    void push(Event &&event)
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= Capacity) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        slots[h & (Capacity - 1)] = std::move(event);
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    template<typename F>
+    void drain(F &&consume)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        const size_t h = head.load(std::memory_order_acquire);
+        for (; t != h; ++t)
+            consume(std::move(slots[t & (Capacity - 1)]));
+        tail.store(h, std::memory_order_release);
+    }
+
+    const quint32 thread;
+    std::atomic<size_t> dropped{0};
+    // Set when the thread exits. The buffer is forgotten once drained.
+    std::atomic<bool> retired{false};
+
+private:
+    std::array<Event, Capacity> slots;
+    std::atomic<size_t> head{0};
+    std::atomic<size_t> tail{0};
+};
+
+std::atomic<bool> running{false};
+std::atomic<quint32> nextThreadId{1};
+
+QMutex registryMutex;
+std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+// Held while consuming buffers and while touching history.
+QMutex drainMutex;
+std::vector<QString> history;
+size_t historyNext = 0;
+
+QMutex wakeMutex;
+QWaitCondition wake;
+QThread *flushThread = nullptr;
+
+QtMessageHandler previousHandler = nullptr;
+
+// Registers the calling thread's buffer on first use and retires it when the
+// thread exits.
+struct BufferHandle {
+    std::shared_ptr<ThreadBuffer> buffer;
+
+    BufferHandle()
+        : buffer(std::make_shared<ThreadBuffer>(nextThreadId.fetch_add(1, std::memory_order_relaxed)))
+    {
+        QMutexLocker locker(&registryMutex);
+        buffers.push_back(buffer);
+    }
+    ~BufferHandle() { buffer->retired.store(true, std::memory_order_release); }
+};
+
+ThreadBuffer &threadBuffer()
+{
+    thread_local BufferHandle handle;
+    return *handle.buffer;
+}
+
+qint64 nowMicros()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+const char *levelName(Level level)
+{
+    switch (level) {
+    case Level::Trace: return "TRACE";
+    case Level::Debug: return "DEBUG";
+    case Level::Info: return "INFO";
+    case Level::Warning: return "WARN";
+    case Level::Error: return "ERROR";
+    }
+    return "?";
+}
+
+QString format(const Event &event)
+{
+    const QDateTime when = QDateTime::fromMSecsSinceEpoch(event.timestampUs / 1000);
+    QString line = QString("%1 %2 [%3] ")
+                       .arg(when.toString("HH:mm:ss.zzz"))
+                       .arg(QLatin1String(levelName(event.level)), -5)
+                       .arg(QLatin1String(event.category));
+    line += event.message;
+    for (const Field &field : event.fields) {
+        line += ' ';
+        line += QLatin1String(field.key);
+        line += '=';
+        if (field.value.contains(' '))
+            line += '"' + field.value + '"';
+        else
+            line += field.value;
+    }
+    return line;
+}
+
+void writeLine(const QString &line)
+{
+    std::fputs(line.toLocal8Bit().constData(), stderr);
+    std::fputc('\n', stderr);
+}
+
+void remember(QString line)
+{
+    if (history.size() < static_cast<size_t>(HistorySize)) {
+        history.push_back(std::move(line));
+        return;
+    }
+    history[historyNext] = std::move(line);
+    historyNext = (historyNext + 1) % history.size();
+}
+
+void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    Level level = Level::Debug;
+    switch (type) {
+    case QtDebugMsg: level = Level::Debug; break;
+    case QtInfoMsg: level = Level::Info; break;
+    case QtWarningMsg: level = Level::Warning; break;
+    case QtCriticalMsg: level = Level::Error; break;
+    case QtFatalMsg:
+        // Qt aborts once this returns, so there's no time for the flush thread.
+        flush();
+        if (previousHandler)
+            previousHandler(type, context, message);
+        else
+            writeLine(qFormatLogMessage(type, context, message));
+        return;
+    }
+    if (!isEnabled(level))
+        return;
+
+    const bool named = context.category && std::strcmp(context.category, "default") != 0;
+    internal::write(level, named ? context.category : "qt", message);
+}
+
+void flushLoop()
+{
+    while (running.load(std::memory_order_acquire)) {
+        {
+            QMutexLocker locker(&wakeMutex);
+            wake.wait(&wakeMutex, FlushIntervalMs);
+        }
+        flush();
+    }
+}
+}
+
+void internal::write(Level level, const char *category, const QString &message,
+                     std::initializer_list<Field> fields)
+{
+    Event event;
+    event.timestampUs = nowMicros();
+    event.level = level;
+    event.category = category;
+    event.message = message;
+    event.fields.assign(fields.begin(), fields.end());
+
+    if (!running.load(std::memory_order_acquire)) {
+        writeLine(format(event));
+        return;
+    }
+
+    ThreadBuffer &buffer = threadBuffer();
+    event.thread = buffer.thread;
+    buffer.push(std::move(event));
+    if (level >= Level::Warning)
+        wake.wakeOne();
+}
+
+void setLevel(Level level)
+{
+    internal::minLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+bool parseLevel(const QString &name, Level *out)
+{
+    static const std::array<std::pair<const char *, Level>, 5> names{{
+        {"trace", Level::Trace},
+        {"debug", Level::Debug},
+        {"info", Level::Info},
+        {"warning", Level::Warning},
+        {"error", Level::Error},
+    }};
+    for (const auto &entry : names) {
+        if (name.compare(QLatin1String(entry.first), Qt::CaseInsensitive) == 0) {
+            *out = entry.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+void start()
+{
+    if (flushThread)
+        return;
+
+    {
+        QMutexLocker locker(&drainMutex);
+        history.reserve(HistorySize);
+    }
+    running.store(true, std::memory_order_release);
+    previousHandler = qInstallMessageHandler(messageHandler);
+    flushThread = QThread::create(flushLoop);
+    flushThread->setObjectName("LogFlush");
+    flushThread->start(QThread::LowPriority);
+}
+
+void stop()
+{
+    if (!flushThread)
+        return;
+
+    qInstallMessageHandler(previousHandler);
+    running.store(false, std::memory_order_release);
+    wake.wakeOne();
+    flushThread->wait();
+    delete flushThread;
+    flushThread = nullptr;
+    // Events pushed after the flush thread's last pass.
+    flush();
+}
+
+void flush()
+{
+    std::vector<std::shared_ptr<ThreadBuffer>> snapshot;
+    {
+        QMutexLocker locker(&registryMutex);
+        snapshot = buffers;
+    }
+
+    QMutexLocker locker(&drainMutex);
+    std::vector<Event> events;
+    size_t dropped = 0;
+    for (const auto &buffer : snapshot) {
+        // Read retired first: a retired buffer gets no more events, so once
+        // this pass drains it, it can go.
+        const bool retired = buffer->retired.load(std::memory_order_acquire);
+        buffer->drain([&events](Event &&event) { events.push_back(std::move(event)); });
+        dropped += buffer->dropped.exchange(0, std::memory_order_relaxed);
+        if (retired) {
+            QMutexLocker registryLocker(&registryMutex);
+            buffers.erase(std::remove(buffers.begin(), buffers.end(), buffer), buffers.end());
+        }
+    }
+    if (events.empty() && dropped == 0)
+        return;
+
+    // Each buffer is already in order, so this only interleaves threads.
+    std::stable_sort(events.begin(), events.end(), [](const Event &lhs, const Event &rhs) {
+        return lhs.timestampUs < rhs.timestampUs;
+    });
+
+    QString text;
+    for (const Event &event : events) {
+        QString line = format(event);
+        text += line;
+        text += '\n';
+        remember(std::move(line));
+    }
+    if (dropped > 0) {
+        QString line = QString("[Log] Dropped %1 events from full thread buffers").arg(dropped);
+        text += line;
+        text += '\n';
+        remember(std::move(line));
+    }
+    std::fputs(text.toLocal8Bit().constData(), stderr);
+    std::fflush(stderr);
+}
+
+QStringList recent(int count)
+{
+    flush();
+
+    QMutexLocker locker(&drainMutex);
+    const int size = static_cast<int>(history.size());
+    const int first = std::max(0, size - count);
+    QStringList lines;
+    lines.reserve(size - first);
+    // history is a ring once full; historyNext is the oldest entry.
+    for (int i = first; i < size; ++i)
+        lines.append(history[(historyNext + static_cast<size_t>(i)) % history.size()]);
+    return lines;
+}
+
+bool dumpRecent(const QString &path, int count)
+{
+    const QStringList lines = recent(count);
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning() << "[Log] Unable to write" << path;
+        return false;
+    }
+    for (const QString &line : lines) {
+        file.write(line.toUtf8());
+        file.write("\n");
+    }
+    return file.commit();
+}
+
+}
@@ -0,0 +1,88 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <initializer_list>
+#include <string>
+#include <type_traits>
+
+// Leveled logging with structured fields.
+//
+//   LOG_DEBUG("scan", "Read plugin", {{"file", name}, {"masters", count}});
+//
+// Levels below NORDIC_LOG_MIN_LEVEL are compiled out, and levels below the
+// runtime level (NORDIC_LOG_LEVEL, Debug by default) cost one atomic load.
+// While the log is running, events go into a lock-free ring buffer owned by
+// the calling thread, and a background thread writes them to stderr and
+// keeps the last HistorySize of them for dumpRecent(). qDebug() and friends
+// are routed through the same path.
+namespace Log {
+
+enum class Level { Trace, Debug, Info, Warning, Error };
+
+// 0 keeps LOG_TRACE calls, which are for per-item logging in hot loops.
+#ifndef NORDIC_LOG_MIN_LEVEL
+#define NORDIC_LOG_MIN_LEVEL 1
+#endif
+constexpr Level CompiledMinLevel = static_cast<Level>(NORDIC_LOG_MIN_LEVEL);
+
+constexpr int HistorySize = 20000;
+
+struct Field {
+    Field(const char *key, const QString &value) : key(key), value(value) {}
+    Field(const char *key, const char *value) : key(key), value(QString::fromUtf8(value)) {}
+    Field(const char *key, const std::string &value) : key(key), value(QString::fromStdString(value)) {}
+    Field(const char *key, bool value) : key(key), value(value ? "true" : "false") {}
+    template<typename T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+    Field(const char *key, T value) : key(key), value(QString::number(value)) {}
+
+    const char *key;
+    QString value;
+};
+
+namespace internal {
+extern std::atomic<int> minLevel;
+void write(Level level, const char *category, const QString &message,
+           std::initializer_list<Field> fields = {});
+}
+
+inline bool isEnabled(Level level)
+{
+    return static_cast<int>(level) >= internal::minLevel.load(std::memory_order_relaxed);
+}
+void setLevel(Level level);
+// "trace", "debug", "info", "warning" or "error".
+bool parseLevel(const QString &name, Level *out);
+
+// Starts the flush thread and installs the Qt message handler. Until start()
+// and after stop(), events are written to stderr straight away.
+void start();
+void stop();
+
+// Writes out everything logged so far. Called by the flush thread on a timer
+// and after warnings and errors.
+void flush();
+
+// Up to count of the most recent events, oldest first, one line each.
+QStringList recent(int count = HistorySize);
+bool dumpRecent(const QString &path, int count = HistorySize);
+
+}
+
+#define NORDIC_LOG(level, category, ...)                                  \
+    do {                                                                  \
+        if constexpr ((level) >= Log::CompiledMinLevel) {                 \
+            if (Log::isEnabled(level))                                    \
+                Log::internal::write((level), (category), __VA_ARGS__);   \
+        }                                                                 \
+    } while (false)
+
+#define LOG_TRACE(category, ...) NORDIC_LOG(Log::Level::Trace, category, __VA_ARGS__)
+#define LOG_DEBUG(category, ...) NORDIC_LOG(Log::Level::Debug, category, __VA_ARGS__)
+#define LOG_INFO(category, ...) NORDIC_LOG(Log::Level::Info, category, __VA_ARGS__)
+#define LOG_WARNING(category, ...) NORDIC_LOG(Log::Level::Warning, category, __VA_ARGS__)
+#define LOG_ERROR(category, ...) NORDIC_LOG(Log::Level::Error, category, __VA_ARGS__)
+
+#endif // LOG_H
@@ -1,10 +1,45 @@
 #include "lootManager.h"
+#include "trace.h"
 #include <QDebug>
 #include <QJsonDocument>
 #include <QJsonParseError>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QSaveFile>
+#include <mutex>
+#include <vector>
+
+namespace {
+// Written to the sort cache file and hashed into every key. Bump it when the
+// file layout or the way cached orders are produced changes, so that orders
+// from an older build are not reused.
+constexpr int SortCacheFormatVersion = 2;
+
+// Puts libloot's own log messages on the trace timeline.
+void traceLootLog(int level, const char *message, void *)
+{
+    static const char *const levelNames[] = {"trace", "debug", "info", "warning", "error"};
+    const char *levelName = level >= LootLogLevel_Trace && level <= LootLogLevel_Error
+                                ? levelNames[level]
+                                : "error";
+    Trace::instant("libloot", QString::fromUtf8(message), QString::fromLatin1(levelName));
+}
+}
 
 LootManager::LootManager(const QString &dataPath, const QString &installPath, LootGameType gameType)
 {
+    Trace::Span span("loot", "LootManager::create");
+    span.setDetail(installPath);
+
+    static std::once_flag loggingForwarded;
+    if (Trace::isEnabled()) {
+        std::call_once(loggingForwarded, []() {
+            loot_set_logging_callback(traceLootLog, nullptr, LootLogLevel_Debug);
+        });
+    }
+
     qDebug() << "[LOOT] Creating handle. dataPath=" << dataPath << "installPath=" << installPath << "gameType=" << gameType;
     QByteArray data = dataPath.toUtf8();
     QByteArray install = installPath.toUtf8();
@@ -26,49 +61,367 @@ LootManager::~LootManager()
         loot_destroy_game_handle(handle);
 }
 
-bool LootManager::sortPlugins()
+bool LootManager::sortPlugins(const QStringList &pluginPaths)
 {
+    TRACE_SPAN("loot", "LootManager::sortPlugins");
+
     if (!handle) {
         qWarning() << "[LOOT] sortPlugins called without valid handle.";
         return false;
     }
-    int result = loot_sort_plugins(handle);
-    return result == 0;
+
+    const QByteArray key = sortCacheKey(pluginPaths);
+    auto cached = sortCache.constFind(key);
+    lastSortStatistics = QJsonObject();
+    if (cached != sortCache.constEnd()) {
+        lastSortedPlugins = *cached;
+        lastSortCached = true;
+        ++cacheHits;
+        sortCacheRecency.removeOne(key);
+        sortCacheRecency.prepend(key);
+        return true;
+    }
+
+    lastSortCached = false;
+    ++cacheMisses;
+
+    std::vector<QByteArray> encoded;
+    encoded.reserve(pluginPaths.size());
+    for (const QString &path : pluginPaths)
+        encoded.push_back(path.toUtf8());
+
+    std::vector<const char *> paths;
+    paths.reserve(encoded.size());
+    for (const QByteArray &path : encoded)
+        paths.push_back(path.constData());
+
+    int result = loot_sort_plugin_paths(handle, paths.data(), paths.size());
+    if (result != 0) {
+        lastSortedPlugins.clear();
+        return false;
+    }
+
+    QStringList names;
+    LootStringList list = loot_get_sorted_plugins(handle);
+    names.reserve(static_cast<qsizetype>(list.count));
+    for (size_t i = 0; i < list.count; ++i)
+        names.append(QString::fromUtf8(list.items[i]));
+    loot_free_string_list(list);
+    lastSortedPlugins = names;
+
+    if (char *json = loot_get_sort_statistics_json(handle)) {
+        QJsonDocument doc = QJsonDocument::fromJson(QByteArray(json));
+        loot_free_json(json);
+        if (doc.isObject())
+            lastSortStatistics = doc.object();
+    }
+
+    sortCache.insert(key, names);
+    sortCacheRecency.removeOne(key);
+    sortCacheRecency.prepend(key);
+    while (sortCacheRecency.size() > MaxSortCacheEntries)
+        sortCache.remove(sortCacheRecency.takeLast());
+    saveSortCache();
+    return true;
+}
+
+QStringList LootManager::sortStatisticsReport() const
+{
+    QStringList lines;
+    if (lastSortStatistics.isEmpty())
+        return lines;
+
+    auto millis = [](const QJsonValue &micros) {
+        return QString::number(micros.toDouble() / 1000.0, 'f', 2);
+    };
+
+    lines.append(QString("Sort took %1 ms for %2 plugins.")
+                     .arg(millis(lastSortStatistics.value("totalMicros")))
+                     .arg(lastSortStatistics.value("nodes").toInteger()));
+
+    // Masters and non-masters are sorted in parallel, so the phases can add up
+    // to more than the total.
+    for (const QJsonValue &value : lastSortStatistics.value("phases").toArray()) {
+        const QJsonObject phase = value.toObject();
+        lines.append(QString("  %1: %2 ms")
+                         .arg(phase.value("name").toString(), millis(phase.value("micros"))));
+    }
+
+    qint64 totalEdges = 0;
+    QStringList edgeCounts;
+    for (const QJsonValue &value : lastSortStatistics.value("edges").toArray()) {
+        const QJsonObject edge = value.toObject();
+        const qint64 count = edge.value("count").toInteger();
+        totalEdges += count;
+        edgeCounts.append(QString("%1 %2").arg(count).arg(edge.value("type").toString()));
+    }
+    lines.append(QString("  %1 edges: %2").arg(totalEdges).arg(edgeCounts.join(", ")));
+
+    const qint64 queries = lastSortStatistics.value("pathQueries").toInteger();
+    const qint64 searches = lastSortStatistics.value("pathSearches").toInteger();
+    const double hitRate = queries > 0 ? 100.0 * double(queries - searches) / double(queries) : 100.0;
+    lines.append(QString("  %1 path checks, %2 needed a graph search (%3% answered from the index).")
+                     .arg(queries)
+                     .arg(searches)
+                     .arg(QString::number(hitRate, 'f', 1)));
+    return lines;
+}
+
+QByteArray LootManager::sortCacheKey(const QStringList &pluginPaths) const
+{
+    static const QByteArray separator(1, '\0');
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    // A different libloot may sort the same input differently.
+    hash.addData(QByteArray::number(SortCacheFormatVersion));
+    hash.addData(separator);
+    hash.addData(QByteArray(loot_get_version()));
+    hash.addData(separator);
+    hash.addData(masterlistStamp.digest);
+    hash.addData(separator);
+    hash.addData(preludeStamp.digest);
+    hash.addData(separator);
+    hash.addData(userlistStamp.digest);
+
+    // The input order matters: LOOT uses it as the current load order.
+    for (const QString &path : pluginPaths) {
+        QFileInfo info(path);
+        hash.addData(separator);
+        hash.addData(info.fileName().toUtf8());
+        hash.addData(QByteArray::number(info.size()));
+        hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    }
+
+    return hash.result().toHex();
+}
+
+void LootManager::setSortCachePath(const QString &path)
+{
+    if (path == sortCachePath)
+        return;
+
+    sortCachePath = path;
+    sortCache.clear();
+    sortCacheRecency.clear();
+    loadSortCache();
+}
+
+void LootManager::setCrcCachePath(const QString &path)
+{
+    if (!handle || path.isEmpty())
+        return;
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QByteArray utf8 = path.toUtf8();
+    int rc = loot_set_crc_cache_path(handle, utf8.constData());
+    if (rc != 0)
+        qWarning() << "[LOOT] Unable to set CRC cache path" << path << "rc=" << rc;
+}
+
+void LootManager::prewarmCrcCache(const QStringList &pluginPaths)
+{
+    TRACE_SPAN("loot", "LootManager::prewarmCrcCache");
+
+    if (!handle || pluginPaths.isEmpty())
+        return;
+
+    std::vector<QByteArray> encoded;
+    encoded.reserve(pluginPaths.size());
+    for (const QString &path : pluginPaths)
+        encoded.push_back(path.toUtf8());
+
+    std::vector<const char *> paths;
+    paths.reserve(encoded.size());
+    for (const QByteArray &path : encoded)
+        paths.push_back(path.constData());
+
+    // Returns straight away, the shim copies the paths before hashing starts.
+    int rc = loot_prewarm_crc_cache(handle, paths.data(), paths.size());
+    if (rc != 0)
+        qWarning() << "[LOOT] Unable to prewarm CRC cache rc=" << rc;
+}
+
+void LootManager::loadSortCache()
+{
+    TRACE_SPAN("loot", "LootManager::loadSortCache");
+
+    if (sortCachePath.isEmpty())
+        return;
+
+    QFile file(sortCachePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+        qWarning() << "[LOOT] Ignoring unreadable sort cache" << sortCachePath;
+        return;
+    }
+    if (doc.object().value("version").toInt() != SortCacheFormatVersion) {
+        qDebug() << "[LOOT] Ignoring sort cache from another version" << sortCachePath;
+        return;
+    }
+
+    const QJsonArray entries = doc.object().value("entries").toArray();
+    for (const QJsonValue &value : entries) {
+        if (sortCacheRecency.size() >= MaxSortCacheEntries)
+            break;
+
+        const QJsonObject entry = value.toObject();
+        const QByteArray key = entry.value("key").toString().toLatin1();
+        if (key.isEmpty() || sortCache.contains(key))
+            continue;
+
+        QStringList order;
+        for (const QJsonValue &name : entry.value("order").toArray())
+            order.append(name.toString());
+
+        sortCache.insert(key, order);
+        sortCacheRecency.append(key);
+    }
+
+    qDebug() << "[LOOT] Loaded" << sortCache.size() << "cached sort results.";
+}
+
+void LootManager::saveSortCache() const
+{
+    TRACE_SPAN("loot", "LootManager::saveSortCache");
+
+    if (sortCachePath.isEmpty())
+        return;
+
+    QJsonArray entries;
+    for (const QByteArray &key : sortCacheRecency) {
+        QJsonObject entry;
+        entry.insert("key", QString::fromLatin1(key));
+        entry.insert("order", QJsonArray::fromStringList(sortCache.value(key)));
+        entries.append(entry);
+    }
+
+    QJsonObject root;
+    root.insert("version", SortCacheFormatVersion);
+    root.insert("entries", entries);
+
+    QDir().mkpath(QFileInfo(sortCachePath).absolutePath());
+    QSaveFile file(sortCachePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[LOOT] Unable to write sort cache" << sortCachePath;
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    file.commit();
+}
+
+LootManager::SourceStamp LootManager::stampFor(const QString &path, const SourceStamp &previous)
+{
+    SourceStamp stamp;
+    stamp.path = path;
+    if (path.isEmpty())
+        return stamp;
+
+    QFileInfo info(path);
+    if (!info.exists())
+        return stamp;
+
+    stamp.size = info.size();
+    stamp.modified = info.lastModified();
+    if (previous.path == path && previous.size == stamp.size && previous.modified == stamp.modified) {
+        stamp.digest = previous.digest;
+        return stamp;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return stamp;
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(&file);
+    stamp.digest = hash.result();
+    return stamp;
 }
 
 bool LootManager::loadMasterlist(const QString &masterlistPath, const QString &preludePath)
 {
+    TRACE_SPAN("loot", "LootManager::loadMasterlist");
+
     if (!handle)
         return false;
 
+    SourceStamp masterlist = stampFor(masterlistPath, masterlistStamp);
+    SourceStamp prelude = stampFor(preludePath, preludeStamp);
+    if (!masterlist.digest.isEmpty()
+        && masterlist.sameContent(masterlistStamp)
+        && prelude.sameContent(preludeStamp)) {
+        // Refresh the cheap size/mtime fields so a touched-but-identical file
+        // is not re-hashed on the next call.
+        masterlistStamp = masterlist;
+        preludeStamp = prelude;
+        qDebug() << "[LOOT] Masterlist unchanged, skipping reload.";
+        return true;
+    }
+
     QByteArray masterlistUtf8 = masterlistPath.toUtf8();
     QByteArray preludeUtf8 = preludePath.toUtf8();
     const char *preludePtr = preludeUtf8.isEmpty() ? nullptr : preludeUtf8.constData();
     int rc = loot_load_masterlist(handle, masterlistUtf8.constData(), preludePtr);
+    ++generation;
     if (rc != 0) {
         qWarning() << "[LOOT] Failed to load masterlist" << masterlistPath << "rc=" << rc;
+        masterlistStamp = SourceStamp();
+        preludeStamp = SourceStamp();
+        return false;
     }
-    return rc == 0;
+
+    masterlistStamp = masterlist;
+    preludeStamp = prelude;
+    return true;
 }
 
 bool LootManager::loadUserlist(const QString &userlistPath)
 {
+    TRACE_SPAN("loot", "LootManager::loadUserlist");
+
     if (!handle)
         return false;
 
+    SourceStamp userlist = stampFor(userlistPath, userlistStamp);
+    if (!userlist.digest.isEmpty() && userlist.sameContent(userlistStamp)) {
+        userlistStamp = userlist;
+        qDebug() << "[LOOT] Userlist unchanged, skipping reload.";
+        return true;
+    }
+
     QByteArray utf8 = userlistPath.toUtf8();
     int rc = loot_load_userlist(handle, utf8.constData());
+    ++generation;
     if (rc != 0) {
         qWarning() << "[LOOT] Unable to load userlist" << userlistPath << "rc=" << rc;
+        userlistStamp = SourceStamp();
+        return false;
     }
-    return rc == 0;
+
+    userlistStamp = userlist;
+    return true;
+}
+
+void LootManager::unloadUserlist()
+{
+    if (userlistStamp.isEmpty())
+        return;
+
+    clearUserMetadata();
 }
 
 bool LootManager::clearUserMetadata()
 {
+    TRACE_SPAN("loot", "LootManager::clearUserMetadata");
+
     if (!handle)
         return false;
 
+    userlistStamp = SourceStamp();
+    ++generation;
     int rc = loot_clear_user_metadata(handle);
     if (rc != 0) {
         qWarning() << "[LOOT] Failed clearing user metadata rc=" << rc;
@@ -78,6 +431,9 @@ bool LootManager::clearUserMetadata()
 
 QJsonObject LootManager::pluginDetails(const QString &pluginName)
 {
+    Trace::Span span("loot", "LootManager::pluginDetails");
+    span.setDetail(pluginName);
+
     if (!handle)
         return QJsonObject();
 
@@ -99,6 +455,8 @@ QJsonObject LootManager::pluginDetails(const QString &pluginName)
 
 QJsonArray LootManager::generalMessages()
 {
+    TRACE_SPAN("loot", "LootManager::generalMessages");
+
     if (!handle)
         return QJsonArray();
 
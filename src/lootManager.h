@@ -2,8 +2,13 @@
 #define LOOTMANAGER_H
 
 #include <QString>
+#include <QByteArray>
+#include <QDateTime>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QStringList>
+#include <QHash>
+#include <QList>
 #include "../loot-shim/include/loot_shim.h"
 
 class LootManager {
@@ -11,16 +16,78 @@ public:
     LootManager(const QString &dataPath, const QString &installPath, LootGameType gameType);
     ~LootManager();
 
-    bool sortPlugins();
+    // Sorts plugins the caller has already scanned, in their current order,
+    // without the shim walking the data directory again.
+    bool sortPlugins(const QStringList &pluginPaths);
+    // Plugin filenames in the order produced by the last successful sort.
+    QStringList sortedPlugins() const { return lastSortedPlugins; }
+    // Per-phase timings, node and edge counts and reachability query counts
+    // from the last sort that actually ran. Empty if the last sort came from
+    // the sort cache or failed.
+    QJsonObject sortStatistics() const { return lastSortStatistics; }
+    // Formats sortStatistics() as lines for the LOOT report.
+    QStringList sortStatisticsReport() const;
+
+    // Sort results are cached by the plugin list (names, sizes, mtimes) and
+    // the loaded masterlist, prelude and userlist content, and persisted to
+    // this file so unchanged re-sorts are instant across sessions.
+    void setSortCachePath(const QString &path);
+    bool lastSortFromCache() const { return lastSortCached; }
+    int sortCacheHits() const { return cacheHits; }
+    int sortCacheMisses() const { return cacheMisses; }
+    // Plugin CRCs (used by checksum conditions in the masterlist) are
+    // persisted to this file, and can be calculated ahead of time on
+    // libloot's thread pool so that metadata lookups don't wait on hashing.
+    void setCrcCachePath(const QString &path);
+    void prewarmCrcCache(const QStringList &pluginPaths);
     bool isValid() const { return handle != nullptr; }
+    // Both loaders skip the YAML parse when the file content matches what was
+    // last loaded into the handle, and return true if the metadata is usable.
     bool loadMasterlist(const QString &masterlistPath, const QString &preludePath = QString());
     bool loadUserlist(const QString &userlistPath);
+    void unloadUserlist();
     bool clearUserMetadata();
+    // Bumped whenever the loaded masterlist, prelude or userlist changes, so
+    // callers can tell whether metadata they fetched earlier is still current.
+    quint64 metadataGeneration() const { return generation; }
     QJsonObject pluginDetails(const QString &pluginName);
     QJsonArray generalMessages();
 
 private:
+    // Identifies the exact content of a metadata file that was loaded. The
+    // size/mtime pair is checked first so unchanged files are never re-read.
+    struct SourceStamp {
+        QString path;
+        qint64 size = -1;
+        QDateTime modified;
+        QByteArray digest;
+
+        bool isEmpty() const { return path.isEmpty(); }
+        bool sameContent(const SourceStamp &other) const {
+            return path == other.path && digest == other.digest;
+        }
+    };
+
+    static SourceStamp stampFor(const QString &path, const SourceStamp &previous);
+    QByteArray sortCacheKey(const QStringList &pluginPaths) const;
+    void loadSortCache();
+    void saveSortCache() const;
+
     LootGameHandle *handle = nullptr;
+    SourceStamp masterlistStamp;
+    SourceStamp preludeStamp;
+    SourceStamp userlistStamp;
+    quint64 generation = 0;
+
+    static constexpr int MaxSortCacheEntries = 32;
+    QString sortCachePath;
+    QHash<QByteArray, QStringList> sortCache;
+    QList<QByteArray> sortCacheRecency; // most recently used first
+    QStringList lastSortedPlugins;
+    QJsonObject lastSortStatistics;
+    bool lastSortCached = false;
+    int cacheHits = 0;
+    int cacheMisses = 0;
 };
 
 #endif
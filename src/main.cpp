@@ -1,6 +1,8 @@
 #include <QApplication>
 #include "firstrunwizard.h"
 #include "mainWindow.h"
+#include "log.h"
+#include "trace.h"
 
 #include <QFile>
 #include <QDir>
@@ -14,6 +16,12 @@ int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
 
+    // NORDIC_LOG_LEVEL=trace|debug|info|warning|error, debug by default.
+    Log::Level logLevel;
+    if (Log::parseLevel(qEnvironmentVariable("NORDIC_LOG_LEVEL"), &logLevel))
+        Log::setLevel(logLevel);
+    Log::start();
+
     QString gamePath, workspacePath;
 
     if(!hasConfig()) {
@@ -34,7 +42,15 @@ int main(int argc, char *argv[])
         }
     }
 
+    // NORDIC_TRACE=/path/to/trace.json records a Chrome trace of this run.
+    const QString tracePath = qEnvironmentVariable("NORDIC_TRACE");
+    if (!tracePath.isEmpty())
+        Trace::start(tracePath);
+
     MainWindow w;
     w.show();
-    return app.exec();
+    const int result = app.exec();
+    Trace::stop();
+    Log::stop();
+    return result;
 }
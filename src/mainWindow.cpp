@@ -5,18 +5,25 @@
 #include "detectLootType.h"
 #include "lootManager.h"
 #include "modManager.h"
+#include "trace.h"
+#include "stallWatchdog.h"
+#include "diagnosticsPanel.h"
+#include "log.h"
 
 #include <QtWidgets/QApplication>
 #include <QtWidgets/QLabel>
 #include <QtWidgets/QTabWidget>
 #include <QtWidgets/QListWidget>
+#include <QtWidgets/QListView>
 #include <QtWidgets/QPushButton>
 #include <QtWidgets/QVBoxLayout>
 #include <QtWidgets/QHBoxLayout>      // <-- REQUIRED
 #include <QtWidgets/QStackedWidget>   // <-- REQUIRED
 #include <QtWidgets/QFileDialog>
 #include <QtWidgets/QTextBrowser>
-#include <QtWidgets/QTableWidget>
+#include <QtWidgets/QTableView>
+#include <QtWidgets/QStatusBar>
+#include <QtWidgets/QProgressBar>
 #include <QtWidgets/QHeaderView>
 #include <QIcon>
 #include <QSize>
@@ -32,6 +39,7 @@
 #include <QFileInfo>
 #include <QEasingCurve>
 #include <QSignalBlocker>
+#include <QItemSelectionModel>
 #include <QTextStream>
 #include <QProcess>
 #include <QProcessEnvironment>
@@ -51,6 +59,8 @@
 #include <memory>
 #include <algorithm>
 #include <functional>
+#include <numeric>
+#include <utility>
 
 #include <QtCore/QSettings>
 #include <QtCore/QDir>
@@ -76,14 +86,25 @@ MainWindow::MainWindow(QWidget *parent)
       ui(new Ui::MainWindow),
       activeGame(LootGameType_SkyrimSE)
 {
+    startupClock.start();
     loadWorkspaceConfig();
+    markStartupStage("Workspace config");
 
     ui->setupUi(this);
     setupStyle();
     setupDataViews();
-
-    if (ui->pluginListWidget) {
-        if (QWidget *pluginsContainer = ui->pluginListWidget->parentWidget()) {
+    setupJobStatus();
+
+    pluginModel = new PluginListModel(this);
+    modPluginProxy = new PluginListProxyModel(PluginListModel::LabelRole, this);
+    modPluginProxy->setSourceModel(pluginModel);
+    lootPluginProxy = new PluginListProxyModel(PluginListModel::FilenameRole, this);
+    lootPluginProxy->setSourceModel(pluginModel);
+
+    if (ui->pluginListView) {
+        ui->pluginListView->setModel(modPluginProxy);
+        ui->pluginListView->setUniformItemSizes(true);
+        if (QWidget *pluginsContainer = ui->pluginListView->parentWidget()) {
             if (auto layout = qobject_cast<QVBoxLayout*>(pluginsContainer->layout())) {
                 QHBoxLayout *toolLayout = new QHBoxLayout();
                 QLabel *toolLabel = new QLabel("Run with:", pluginsContainer);
@@ -147,9 +168,22 @@ MainWindow::MainWindow(QWidget *parent)
     QWidget *iniTab = new QWidget();
     QVBoxLayout *iniLayout = new QVBoxLayout(iniTab);
     iniEditor = new IniEditorWidget(this);
+    iniEditor->setJobScheduler(jobs);
     iniLayout->addWidget(iniEditor);
     ui->tabWidget->addTab(iniTab, "INI Editor");
 
+    QSettings settings("Kartavian", "NordicMod");
+    stallWatchdog = new StallWatchdog(this);
+    stallWatchdog->setThresholdMs(
+        settings.value("stallThresholdMs", StallWatchdog::DefaultThresholdMs).toInt());
+    stallWatchdog->setLogFile(workspacePath + "/logs/stalls.log");
+    diagnosticsPanel = new DiagnosticsPanel(stallWatchdog, this);
+    connect(diagnosticsPanel, &DiagnosticsPanel::thresholdChanged, this, [](int ms) {
+        QSettings settings("Kartavian", "NordicMod");
+        settings.setValue("stallThresholdMs", ms);
+    });
+    ui->tabWidget->addTab(diagnosticsPanel, "Diagnostics");
+
     leftStack->addWidget(modLeft); // index 0
     rightStack->addWidget(modRight); // index 0
 
@@ -167,10 +201,14 @@ MainWindow::MainWindow(QWidget *parent)
     connect(sortPluginsButton, &QPushButton::clicked,
             this, &MainWindow::onSortPluginsClicked);
 
-    lootPluginList = new QListWidget();
+    lootPluginList = new QListView();
+    lootPluginList->setModel(lootPluginProxy);
+    lootPluginList->setUniformItemSizes(true);
     lootPluginList->setSelectionMode(QAbstractItemView::SingleSelection);
-    connect(lootPluginList, &QListWidget::currentRowChanged,
-            this, &MainWindow::displayLootMetadata);
+    connect(lootPluginList->selectionModel(), &QItemSelectionModel::currentRowChanged,
+            this, [this](const QModelIndex &current) {
+                displayLootMetadata(lootPluginProxy->sourceRow(current));
+            });
 
     lootPluginName = new QLabel("Select a plugin to view metadata.");
     lootPluginType = new QLabel("Type: —");
@@ -242,9 +280,13 @@ MainWindow::MainWindow(QWidget *parent)
     QWidget *warningsTab = new QWidget();
     QVBoxLayout *warningsLayout = new QVBoxLayout(warningsTab);
     warningsLayout->setContentsMargins(0,0,0,0);
-    lootWarningsTable = new QTableWidget(0, 3);
-    lootWarningsTable->setHorizontalHeaderLabels({"Plugin", "Type", "Details"});
+    warningsModel = new WarningsTableModel(this);
+    lootWarningsTable = new QTableView();
+    lootWarningsTable->setModel(warningsModel);
     lootWarningsTable->horizontalHeader()->setStretchLastSection(true);
+    // Size the columns from a sample of rows instead of measuring every cell.
+    lootWarningsTable->horizontalHeader()->setResizeContentsPrecision(64);
+    lootWarningsTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
     lootWarningsTable->verticalHeader()->setVisible(false);
     lootWarningsTable->setSelectionBehavior(QAbstractItemView::SelectRows);
     lootWarningsTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
@@ -342,16 +384,7 @@ MainWindow::MainWindow(QWidget *parent)
     contentLayout->setStretch(1, 1);
     contentLayout->setStretch(2, 1);
 
-    qDebug() << "[INIT] Recreating LOOT manager";
-    recreateLootManager();
-    qDebug() << "[INIT] LOOT manager step done";
-
-    initializeModManager();
-    refreshModsList();
-    rescanVirtualPlugins();
-    updateIniEditorSources();
-    refreshMasterlistInfoLabels();
-    reloadLootMetadata();
+    markStartupStage("Widgets");
 
     /* ─────────────────────────────────────────────────────────────
        DEFAULT MODE: MOD MODE (index = 0)
@@ -359,15 +392,131 @@ MainWindow::MainWindow(QWidget *parent)
     leftStack->setCurrentIndex(0);
     rightStack->setCurrentIndex(0);
 
+    // The window first shows what the workspace snapshot saved on exit.
+    // Loading the mod registry, deployment checks, the plugin scan, the LOOT
+    // handle and metadata run in the background and replace what changed,
+    // and the rest waits until the event loop is running.
+    connect(jobs, &JobScheduler::jobFinished, this,
+            [this](const QString &description, qint64 elapsedMs, bool cancelled) {
+                if (startupInProgress)
+                    qDebug() << "[STARTUP]" << description << "took" << elapsedMs << "ms"
+                             << (cancelled ? "(cancelled)" : "");
+            });
+    restoreWorkspaceSnapshot();
+    markStartupStage("Workspace snapshot");
+    startBackgroundStages();
+    QTimer::singleShot(0, this, &MainWindow::runDeferredStartup);
+
     qDebug() << "[DEBUG] MainWindow initialized with MOD MODE active.";
 }
 
+void MainWindow::markStartupStage(const QString &stage)
+{
+    if (!startupInProgress)
+        return;
+
+    const qint64 now = startupClock.elapsed();
+    qDebug() << "[STARTUP]" << stage << "took" << now - startupStageMs << "ms, at" << now << "ms";
+    startupStageMs = now;
+}
+
+void MainWindow::runDeferredStartup()
+{
+    // The event loop is running now, so waiting for it no longer counts as a
+    // stall.
+    stallWatchdog->start();
+    const qint64 shownMs = startupClock.elapsed();
+    markStartupStage("Window shown");
+    if (shownMs > StartupShownBudgetMs)
+        qWarning() << "[STARTUP] Window took" << shownMs << "ms to show, over the"
+                   << StartupShownBudgetMs << "ms budget";
+
+    updateIniEditorSources();
+    markStartupStage("INI sources");
+    refreshMasterlistInfoLabels();
+    markStartupStage("Masterlist info");
+
+    deferredStartupDone = true;
+    if (jobs->isIdle())
+        finishStartup();
+}
+
+void MainWindow::finishStartup()
+{
+    if (!startupInProgress || !deferredStartupDone)
+        return;
+
+    startupInProgress = false;
+    const qint64 readyMs = startupClock.elapsed();
+    qDebug() << "[STARTUP] Ready after" << readyMs << "ms";
+    if (readyMs > StartupReadyBudgetMs)
+        qWarning() << "[STARTUP] Startup took" << readyMs << "ms, over the"
+                   << StartupReadyBudgetMs << "ms budget";
+}
+
+void MainWindow::startBackgroundStages()
+{
+    // Running jobs hold on to the managers being replaced.
+    jobs->cancelAndWait();
+    // The mod changes were made to the current folder's mods.
+    applyModChangesNow();
+
+    const JobScheduler::JobId deployment = initializeModManager();
+    recreateLootManager();
+    rescanVirtualPlugins({deployment});
+}
+
 
 MainWindow::~MainWindow()
 {
+    // Shutdown blocks the GUI thread on purpose.
+    stallWatchdog->stop();
+    // Running jobs use the managers and models owned here.
+    if (jobs)
+        jobs->cancelAndWait();
+    // Don't lose checkbox changes made just before closing.
+    applyModChangesNow();
+    saveWorkspaceSnapshot();
     delete ui;
 }
 
+void MainWindow::setupJobStatus()
+{
+    jobs = new JobScheduler(this);
+
+    modChangeTimer = new QTimer(this);
+    modChangeTimer->setSingleShot(true);
+    modChangeTimer->setInterval(ModChangeDebounceMs);
+    connect(modChangeTimer, &QTimer::timeout, this, &MainWindow::applyPendingModChanges);
+
+    jobStatusLabel = new QLabel(this);
+    jobProgressBar = new QProgressBar(this);
+    jobProgressBar->setMaximumWidth(160);
+    jobProgressBar->setTextVisible(false);
+    jobProgressBar->hide();
+    statusBar()->addPermanentWidget(jobStatusLabel);
+    statusBar()->addPermanentWidget(jobProgressBar);
+
+    connect(jobs, &JobScheduler::activityChanged, this,
+            [this](const QString &description, int completed, int total, int percent) {
+                if (total == 0) {
+                    jobStatusLabel->clear();
+                    jobProgressBar->hide();
+                    finishStartup();
+                    return;
+                }
+
+                jobStatusLabel->setText(QString("%1 (%2/%3)").arg(description).arg(completed + 1).arg(total));
+                if (percent < 0) {
+                    jobProgressBar->setRange(0, 0);
+                } else {
+                    jobProgressBar->setRange(0, 100);
+                    jobProgressBar->setValue(percent);
+                }
+                jobProgressBar->show();
+            });
+}
+
 
 /* ─────────────────────────────────────────────────────────────
    STYLE SETUP
@@ -393,7 +542,7 @@ void MainWindow::setupStyle()
             background-color: #E5B0FF;
         }
 
-        QListWidget {
+        QListWidget, QListView {
             background-color: #3B0B3B;
             color: white;
             border: 1px solid #6A0DAD;
@@ -522,6 +671,7 @@ void MainWindow::saveDataPath(const QString &path) {
 
 void MainWindow::refreshDataRoots()
 {
+    UI_OPERATION("MainWindow::refreshDataRoots");
     if (!dataModel)
         return;
 
@@ -538,32 +688,86 @@ void MainWindow::refreshDataRoots()
 
 void MainWindow::recreateLootManager()
 {
+    // Callers cancel and wait for running jobs first, as they may be using
+    // the current manager.
     lootManager.reset();
+    lootMetadataGeneration = 0;
+    if (sortPluginsButton)
+        sortPluginsButton->setEnabled(false);
 
-    if (dataPath.isEmpty() || installPath.isEmpty()) {
-        if (sortPluginsButton)
-            sortPluginsButton->setEnabled(false);
+    if (dataPath.isEmpty() || installPath.isEmpty())
         return;
-    }
 
-    qDebug() << "[LOOT] Creating manager for data" << dataPath << "install" << installPath << "game" << activeGame;
-    lootManager = std::make_unique<LootManager>(dataPath, installPath, activeGame);
-    qDebug() << "[LOOT] Manager create attempt finished";
-    bool ready = lootManager && lootManager->isValid();
-    if (!ready)
-        lootManager.reset();
+    struct HandleLoad {
+        QString cacheDir;
+        QStringList pluginPaths;
+        std::unique_ptr<LootManager> manager;
+    };
+    auto load = std::make_shared<HandleLoad>();
+    if (!lootDataRoot.isEmpty() && !lootGameSlug().isEmpty())
+        load->cacheDir = lootDataRoot + "/cache/" + lootGameSlug();
+
+    // Creating the handle reads the game's settings, so it runs in the
+    // background. Jobs that use lootManager wait for it.
+    const QString data = dataPath;
+    const QString install = installPath;
+    const LootGameType game = activeGame;
+    JobScheduler::Job job;
+    job.key = QStringLiteral("loot-handle");
+    job.description = QStringLiteral("Creating LOOT handle");
+    job.resource = QStringLiteral("loot");
+    job.started = [this, load]() { load->pluginPaths = lootPluginPaths(); };
+    job.run = [load, data, install, game](const JobContext &) {
+        qDebug() << "[LOOT] Creating manager for data" << data << "install" << install << "game" << game;
+        auto manager = std::make_unique<LootManager>(data, install, game);
+        qDebug() << "[LOOT] Manager create attempt finished";
+        if (!manager->isValid())
+            return;
 
-    if (sortPluginsButton)
-        sortPluginsButton->setEnabled(ready);
+        if (!load->cacheDir.isEmpty()) {
+            manager->setSortCachePath(load->cacheDir + "/sort-cache.json");
+            // The handle is new, so without the persisted CRCs every plugin
+            // would be hashed again the first time a condition checks it.
+            manager->setCrcCachePath(load->cacheDir + "/plugin-crcs.bin");
+            manager->prewarmCrcCache(load->pluginPaths);
+        }
+        load->manager = std::move(manager);
+    };
+    job.finished = [this, load]() {
+        lootManager = std::move(load->manager);
+        if (sortPluginsButton)
+            sortPluginsButton->setEnabled(lootManager != nullptr);
+        if (!lootManager && !lootPluginDetailsCache.isEmpty()) {
+            // Nothing can revalidate metadata restored from the snapshot.
+            lootPluginDetailsCache.clear();
+            lootGeneralMessages = QJsonArray();
+            rebuildWarningsTable();
+        }
+    };
+    jobs->schedule(std::move(job));
+}
+
+QStringList MainWindow::lootPluginPaths() const
+{
+    QDir dataDir(dataPath);
+    QStringList pluginPaths;
+    const std::vector<PluginInfo> &plugins = pluginModel->plugins();
+    pluginPaths.reserve(static_cast<qsizetype>(plugins.size()));
+    for (const auto &plugin : plugins)
+        pluginPaths.append(dataDir.filePath(QString::fromStdString(plugin.filename)));
+    return pluginPaths;
 }
 
 void MainWindow::displayLootMetadata(int index)
 {
+    UI_OPERATION("MainWindow::displayLootMetadata");
+
     if (!lootPluginName || !lootPluginType || !lootMasterList) {
         return;
     }
 
-    if (index < 0 || index >= static_cast<int>(cachedPlugins.size())) {
+    const std::vector<PluginInfo> &plugins = pluginModel->plugins();
+    if (index < 0 || index >= static_cast<int>(plugins.size())) {
         lootPluginName->setText("Select a plugin to view metadata.");
         lootPluginType->setText("Type: —");
         lootMasterList->clear();
@@ -572,7 +776,7 @@ void MainWindow::displayLootMetadata(int index)
         return;
     }
 
-    const PluginInfo &plugin = cachedPlugins.at(index);
+    const PluginInfo &plugin = plugins.at(index);
     QString displayName = QString::fromStdString(!plugin.name.empty() ? plugin.name : plugin.filename);
     lootPluginName->setText(displayName);
     lootPluginType->setText(QString("Type: %1").arg(QString::fromStdString(plugin.type)));
@@ -598,49 +802,158 @@ void MainWindow::appendLootReport(const QString &line)
     lootReportOutput->appendPlainText(line);
 }
 
-void MainWindow::reloadLootMetadata()
+JobScheduler::JobId MainWindow::reloadLootMetadata(const QList<JobScheduler::JobId> &after,
+                                                   MetadataScope scope)
 {
-    if (!lootManager)
-        return;
+    const JobScheduler::JobId handle = jobs->find(QStringLiteral("loot-handle"));
+    if (!lootManager && !handle)
+        return 0;
+
+    // Requests merge into one pending job, so the widest scope asked for
+    // since the last reload started is the one it uses.
+    if (scope == MetadataScope::AllPlugins)
+        metadataRefreshAll = true;
+
+    struct MetadataLoad {
+        LootManager *manager = nullptr;
+        QString masterlistPath;
+        QString preludePath;
+        QString userlistPath;
+        QStringList pluginNames;
+        QStringList pluginPaths;
+        // When partial, only onlyPlugins are fetched and the other details
+        // are carried over from the cache.
+        bool partial = false;
+        QSet<QString> onlyPlugins;
+        quint64 knownGeneration = 0;
+        bool masterlistLoaded = false;
+        QHash<QString, QJsonObject> details;
+        QJsonArray generalMessages;
+    };
+    auto load = std::make_shared<MetadataLoad>();
+
+    JobScheduler::Job job;
+    job.key = QStringLiteral("loot-metadata");
+    job.description = QStringLiteral("Loading LOOT metadata");
+    job.resource = QStringLiteral("loot");
+    job.dependsOn = after;
+    // Wait for a pending rescan so the plugin list below is up to date.
+    if (JobScheduler::JobId rescan = jobs->find(QStringLiteral("rescan")))
+        job.dependsOn.append(rescan);
+    if (handle)
+        job.dependsOn.append(handle);
+
+    job.started = [this, load]() {
+        ensureLootDataFolders();
+        load->manager = lootManager.get();
+        load->masterlistPath = masterlistFilePath();
+        load->preludePath = masterlistPreludePath();
+        load->userlistPath = userlistPathForActiveGame();
+        for (const PluginInfo &plugin : pluginModel->plugins())
+            load->pluginNames.append(QString::fromStdString(plugin.filename));
+        load->pluginPaths = lootPluginPaths();
+        load->knownGeneration = lootMetadataGeneration;
+        load->partial = !metadataRefreshAll && !lootPluginDetailsCache.isEmpty();
+        if (load->partial)
+            load->onlyPlugins = metadataRefreshScope;
+        metadataRefreshScope.clear();
+        metadataRefreshAll = false;
+    };
 
-    ensureLootDataFolders();
-    lootPluginDetailsCache.clear();
-    lootGeneralMessages = QJsonArray();
-
-    QString masterlistPath = masterlistFilePath();
-    QString preludePath = masterlistPreludePath();
-    bool masterlistLoaded = false;
-    if (!masterlistPath.isEmpty() && QFileInfo::exists(masterlistPath)) {
-        masterlistLoaded = lootManager->loadMasterlist(masterlistPath, preludePath);
-    }
+    job.run = [load](const JobContext &context) {
+        LootManager *manager = load->manager;
+        if (!manager)
+            return;
 
-    QString userlistPath = userlistPathForActiveGame();
-    if (!userlistPath.isEmpty() && QFileInfo::exists(userlistPath))
-        lootManager->loadUserlist(userlistPath);
+        // Hash new or changed plugins in the background, ready for the
+        // checksum conditions evaluated below.
+        manager->prewarmCrcCache(load->pluginPaths);
 
-    if (!masterlistLoaded) {
-        rebuildWarningsTable();
-        if (lootPluginDetailsView)
-            lootPluginDetailsView->setHtml("<p>Download a masterlist to view LOOT metadata.</p>");
-        return;
-    }
+        if (!load->masterlistPath.isEmpty() && QFileInfo::exists(load->masterlistPath))
+            load->masterlistLoaded = manager->loadMasterlist(load->masterlistPath, load->preludePath);
 
-    for (const PluginInfo &plugin : cachedPlugins) {
-        QString pluginName = QString::fromStdString(plugin.filename);
-        QJsonObject detail = lootManager->pluginDetails(pluginName);
-        if (!detail.isEmpty())
-            lootPluginDetailsCache.insert(normalizedPluginKey(pluginName), detail);
-    }
+        if (!load->userlistPath.isEmpty() && QFileInfo::exists(load->userlistPath))
+            manager->loadUserlist(load->userlistPath);
+        else
+            manager->unloadUserlist();
 
-    lootGeneralMessages = lootManager->generalMessages();
-    rebuildWarningsTable();
+        if (!load->masterlistLoaded)
+            return;
+
+        // Details fetched for other plugins are only reusable if the
+        // metadata they came from is still what's loaded.
+        if (manager->metadataGeneration() != load->knownGeneration)
+            load->partial = false;
+
+        QStringList pluginNames = load->pluginNames;
+        if (load->partial) {
+            pluginNames.removeIf([&](const QString &pluginName) {
+                return !load->onlyPlugins.contains(pluginName.toLower());
+            });
+        }
+
+        const int count = static_cast<int>(pluginNames.size());
+        int reportedPercent = -1;
+        for (int i = 0; i < count; ++i) {
+            if (context.isCancelled())
+                return;
+            const QString &pluginName = pluginNames.at(i);
+            QJsonObject detail = manager->pluginDetails(pluginName);
+            if (!detail.isEmpty())
+                load->details.insert(pluginName.toLower(), detail);
+
+            const int percent = (i + 1) * 100 / count;
+            if (percent != reportedPercent) {
+                context.setProgress(percent);
+                reportedPercent = percent;
+            }
+        }
+
+        load->generalMessages = manager->generalMessages();
+    };
+
+    job.finished = [this, load]() {
+        if (!load->manager || load->manager != lootManager.get())
+            return;
+
+        const QHash<QString, QJsonObject> previousDetails = std::exchange(lootPluginDetailsCache, {});
+        const QJsonArray previousGeneralMessages = std::exchange(lootGeneralMessages, QJsonArray());
 
-    if (lootPluginList && lootPluginList->currentRow() >= 0)
-        displayLootMetadata(lootPluginList->currentRow());
+        if (!load->masterlistLoaded) {
+            rebuildWarningsTable();
+            if (lootPluginDetailsView)
+                lootPluginDetailsView->setHtml("<p>Download a masterlist to view LOOT metadata.</p>");
+            return;
+        }
+
+        lootMetadataGeneration = load->manager->metadataGeneration();
+        if (load->partial) {
+            // Keep the details of plugins that are still installed and were
+            // not refetched.
+            for (const QString &pluginName : std::as_const(load->pluginNames)) {
+                const QString key = pluginName.toLower();
+                if (load->onlyPlugins.contains(key) || load->details.contains(key))
+                    continue;
+                auto previous = previousDetails.constFind(key);
+                if (previous != previousDetails.constEnd())
+                    load->details.insert(key, *previous);
+            }
+        }
+        lootPluginDetailsCache = std::move(load->details);
+        lootGeneralMessages = load->generalMessages;
+        refreshWarningsTable(previousDetails, previousGeneralMessages);
+
+        if (currentLootPluginRow() >= 0)
+            displayLootMetadata(currentLootPluginRow());
+    };
+
+    return jobs->schedule(std::move(job));
 }
 
 void MainWindow::refreshMasterlistInfoLabels()
 {
+    UI_OPERATION("MainWindow::refreshMasterlistInfoLabels");
+
     if (!masterlistVersionLabel || !masterlistUpdatedLabel)
         return;
 
@@ -747,29 +1060,56 @@ void MainWindow::ensureLootDataFolders() const
     QDir().mkpath(lootDataRoot + "/userlists/" + slug);
 }
 
-bool MainWindow::runGitCommand(const QStringList &args, const QString &workingDir, const QString &description)
+JobScheduler::JobId MainWindow::scheduleGitCommand(const QStringList &args, const QString &workingDir,
+                                                   const QString &description,
+                                                   std::function<void()> onSuccess)
 {
-    QProcess git;
-    git.setProgram(QStringLiteral("git"));
-    git.setArguments(args);
-    git.setWorkingDirectory(workingDir);
-    git.start();
-    if (!git.waitForFinished(-1)) {
-        appendLootReport(QString("Git %1 did not finish: %2").arg(description, git.errorString()));
-        return false;
-    }
+    auto report = std::make_shared<QStringList>();
+    auto ok = std::make_shared<bool>(false);
+
+    JobScheduler::Job job;
+    job.key = QStringLiteral("masterlist-git");
+    job.description = description;
+    // LOOT jobs read the masterlist files that git rewrites.
+    job.resource = QStringLiteral("loot");
+    job.priority = JobScheduler::Priority::Interactive;
+    job.run = [args, workingDir, description, report, ok](const JobContext &context) {
+        QProcess git;
+        git.setProgram(QStringLiteral("git"));
+        git.setArguments(args);
+        git.setWorkingDirectory(workingDir);
+        git.start();
+        while (!git.waitForFinished(250)) {
+            if (git.state() == QProcess::NotRunning) {
+                report->append(QString("Git %1 did not finish: %2").arg(description, git.errorString()));
+                return;
+            }
+            if (context.isCancelled()) {
+                git.kill();
+                git.waitForFinished();
+                return;
+            }
+        }
 
-    const QString stdoutText = QString::fromUtf8(git.readAllStandardOutput()).trimmed();
-    const QString stderrText = QString::fromUtf8(git.readAllStandardError()).trimmed();
-    if (!stdoutText.isEmpty())
-        appendLootReport(stdoutText);
-    if (!stderrText.isEmpty())
-        appendLootReport(stderrText);
+        const QString stdoutText = QString::fromUtf8(git.readAllStandardOutput()).trimmed();
+        const QString stderrText = QString::fromUtf8(git.readAllStandardError()).trimmed();
+        if (!stdoutText.isEmpty())
+            report->append(stdoutText);
+        if (!stderrText.isEmpty())
+            report->append(stderrText);
 
-    bool ok = git.exitStatus() == QProcess::NormalExit && git.exitCode() == 0;
-    appendLootReport(ok ? QString("%1 succeeded.").arg(description)
-                        : QString("%1 failed (exit %2).").arg(description).arg(git.exitCode()));
-    return ok;
+        *ok = git.exitStatus() == QProcess::NormalExit && git.exitCode() == 0;
+        report->append(*ok ? QString("%1 succeeded.").arg(description)
+                           : QString("%1 failed (exit %2).").arg(description).arg(git.exitCode()));
+    };
+    job.finished = [this, report, ok, onSuccess]() {
+        for (const QString &line : *report)
+            appendLootReport(line);
+        if (*ok && onSuccess)
+            onSuccess();
+    };
+
+    return jobs->schedule(std::move(job));
 }
 
 QString MainWindow::runGitForOutput(const QStringList &args, const QString &workingDir) const
@@ -794,95 +1134,56 @@ QString MainWindow::normalizedPluginKey(const QString &name) const
 
 void MainWindow::rebuildWarningsTable()
 {
-    if (!lootWarningsTable)
-        return;
+    UI_OPERATION("MainWindow::rebuildWarningsTable");
 
-    struct WarningEntry {
-        QString plugin;
-        QString type;
-        QString message;
-    };
+    if (!warningsModel)
+        return;
 
-    QVector<WarningEntry> entries;
     QSet<QString> knownPlugins;
-    for (const PluginInfo &plugin : cachedPlugins) {
-        knownPlugins.insert(normalizedPluginKey(QString::fromStdString(plugin.filename)));
-    }
-
-    auto appendEntry = [&](const QString &plugin, const QString &type, const QString &message) {
-        if (message.isEmpty())
-            return;
-        entries.push_back({plugin, type, message});
-    };
-
-    for (const PluginInfo &plugin : cachedPlugins) {
+    std::vector<std::pair<QString, QJsonObject>> details;
+    details.reserve(pluginModel->plugins().size());
+    for (const PluginInfo &plugin : pluginModel->plugins()) {
         QString pluginName = QString::fromStdString(plugin.filename);
         QString key = normalizedPluginKey(pluginName);
+        knownPlugins.insert(key);
         QJsonObject detail = lootPluginDetailsCache.value(key);
-        if (detail.isEmpty())
-            continue;
+        if (!detail.isEmpty())
+            details.emplace_back(pluginName, detail);
+    }
 
-        for (const QJsonValue &value : detail.value("messages").toArray()) {
-            QJsonObject obj = value.toObject();
-            appendEntry(pluginName,
-                        obj.value("level").toString("info"),
-                        obj.value("text").toString());
-        }
+    warningsModel->setWarnings(knownPlugins, details, lootGeneralMessages);
+    lootWarningsTable->resizeColumnsToContents();
+}
 
-        if (detail.value("has_user_metadata").toBool())
-            appendEntry(pluginName, "User Override", QStringLiteral("User rules are applied to this plugin."));
+void MainWindow::refreshWarningsTable(const QHash<QString, QJsonObject> &previousDetails,
+                                      const QJsonArray &previousGeneralMessages)
+{
+    UI_OPERATION("MainWindow::refreshWarningsTable");
 
-        for (const QJsonValue &value : detail.value("dirty").toArray()) {
-            QJsonObject obj = value.toObject();
-            QString summary = QStringLiteral("Utility %1 | CRC %2 | ITM %3 | UDR %4 | NAV %5")
-                                  .arg(obj.value("utility").toString())
-                                  .arg(obj.value("crc").toString())
-                                  .arg(obj.value("itm").toInt())
-                                  .arg(obj.value("deleted_references").toInt())
-                                  .arg(obj.value("deleted_navmeshes").toInt());
-            QString detailText = obj.value("detail").toString();
-            if (!detailText.isEmpty())
-                summary += QStringLiteral(" | %1").arg(detailText);
-            appendEntry(pluginName, "Dirty", summary);
-        }
+    if (!warningsModel)
+        return;
 
-        QJsonArray requirements = detail.value("requirements").toArray();
-        for (const QJsonValue &value : requirements) {
-            QJsonObject obj = value.toObject();
-            QString required = obj.value("name").toString();
-            if (required.isEmpty())
-                continue;
-            if (!knownPlugins.contains(required.toLower())) {
-                appendEntry(pluginName,
-                            "Missing Master",
-                            QStringLiteral("Requires %1, which is not present.").arg(required));
-            }
-        }
+    // Missing masters depend on the whole plugin list, so a different list
+    // needs every row rebuilt. Otherwise only plugins whose metadata changed
+    // (e.g. after a userlist edit) have their rows replaced.
+    QSet<QString> knownPlugins;
+    for (const PluginInfo &plugin : pluginModel->plugins())
+        knownPlugins.insert(normalizedPluginKey(QString::fromStdString(plugin.filename)));
+    if (knownPlugins != warningsModel->knownPlugins()) {
+        rebuildWarningsTable();
+        return;
     }
 
-    for (const QJsonValue &value : lootGeneralMessages) {
-        QJsonObject obj = value.toObject();
-        appendEntry("General", obj.value("level").toString("info"), obj.value("text").toString());
+    for (const PluginInfo &plugin : pluginModel->plugins()) {
+        QString pluginName = QString::fromStdString(plugin.filename);
+        QString key = normalizedPluginKey(pluginName);
+        QJsonObject detail = lootPluginDetailsCache.value(key);
+        if (detail != previousDetails.value(key))
+            warningsModel->setPluginWarnings(pluginName, detail);
     }
 
-    std::sort(entries.begin(), entries.end(), [](const WarningEntry &lhs, const WarningEntry &rhs) {
-        int compare = lhs.plugin.compare(rhs.plugin, Qt::CaseInsensitive);
-        if (compare == 0)
-            return lhs.type < rhs.type;
-        return compare < 0;
-    });
-
-    lootWarningsTable->setSortingEnabled(false);
-    lootWarningsTable->setRowCount(entries.size());
-    for (int row = 0; row < entries.size(); ++row) {
-        lootWarningsTable->setItem(row, 0, new QTableWidgetItem(entries[row].plugin));
-        lootWarningsTable->setItem(row, 1, new QTableWidgetItem(entries[row].type));
-        QTableWidgetItem *detailItem = new QTableWidgetItem(entries[row].message);
-        detailItem->setToolTip(entries[row].message);
-        lootWarningsTable->setItem(row, 2, detailItem);
-    }
-    lootWarningsTable->resizeColumnsToContents();
-    lootWarningsTable->setSortingEnabled(true);
+    if (lootGeneralMessages != previousGeneralMessages)
+        warningsModel->setGeneralMessages(lootGeneralMessages);
 }
 
 QString MainWindow::buildPluginMetadataHtml(const PluginInfo &plugin) const
@@ -999,6 +1300,7 @@ QString MainWindow::buildPluginMetadataHtml(const PluginInfo &plugin) const
 
 void MainWindow::onDownloadMasterlistClicked()
 {
+    UI_OPERATION("MainWindow::onDownloadMasterlistClicked");
     ensureLootDataFolders();
     QString repoUrl = masterlistRepoUrl();
     if (repoUrl.isEmpty()) {
@@ -1024,14 +1326,15 @@ void MainWindow::onDownloadMasterlistClicked()
     QDir().mkpath(parent.absolutePath());
     QString localName = info.fileName();
     QStringList args = {"clone", repoUrl, localName};
-    if (runGitCommand(args, parent.absolutePath(), "Download masterlist")) {
+    scheduleGitCommand(args, parent.absolutePath(), "Download masterlist", [this]() {
         refreshMasterlistInfoLabels();
         reloadLootMetadata();
-    }
+    });
 }
 
 void MainWindow::onUpdateMasterlistClicked()
 {
+    UI_OPERATION("MainWindow::onUpdateMasterlistClicked");
     ensureLootDataFolders();
     QString repoDir = masterlistDirectory();
     QDir dir(repoDir);
@@ -1041,14 +1344,15 @@ void MainWindow::onUpdateMasterlistClicked()
         return;
     }
 
-    if (runGitCommand({"pull", "--ff-only"}, repoDir, "Update masterlist")) {
+    scheduleGitCommand({"pull", "--ff-only"}, repoDir, "Update masterlist", [this]() {
         refreshMasterlistInfoLabels();
         reloadLootMetadata();
-    }
+    });
 }
 
 void MainWindow::onEditUserRulesClicked()
 {
+    UI_OPERATION("MainWindow::onEditUserRulesClicked");
     QString path = userlistPathForActiveGame();
     if (path.isEmpty())
         return;
@@ -1069,6 +1373,7 @@ void MainWindow::onEditUserRulesClicked()
 
 void MainWindow::onResetUserlistClicked()
 {
+    UI_OPERATION("MainWindow::onResetUserlistClicked");
     QString path = userlistPathForActiveGame();
     if (path.isEmpty())
         return;
@@ -1078,106 +1383,177 @@ void MainWindow::onResetUserlistClicked()
         return;
     }
 
-    if (lootManager)
-        lootManager->clearUserMetadata();
-
     appendLootReport("Userlist reset.");
-    reloadLootMetadata();
+    if (!lootManager)
+        return;
+
+    LootManager *manager = lootManager.get();
+    JobScheduler::Job job;
+    job.key = QStringLiteral("clear-user-metadata");
+    job.description = QStringLiteral("Clearing user metadata");
+    job.resource = QStringLiteral("loot");
+    job.run = [manager](const JobContext &) { manager->clearUserMetadata(); };
+    reloadLootMetadata({jobs->schedule(std::move(job))});
 }
 
 /* ─────────────────────────────────────────────────────────────
    POPULATE PLUGIN LIST
 ───────────────────────────────────────────────────────────── */
-void MainWindow::populatePluginList(const std::vector<PluginInfo>& plugins)
+void MainWindow::populatePluginList(std::vector<PluginInfo> plugins)
 {
-    qDebug() << "[UI] populatePluginList start. size=" << plugins.size();
-    if (!ui->pluginListWidget) {
-        qDebug() << "[ERROR] pluginListWidget not found in UI.";
-        return;
-    }
+    UI_OPERATION("MainWindow::populatePluginList");
 
-    cachedPlugins = plugins;
+    LOG_DEBUG("ui", "Populating plugin list", {{"plugins", plugins.size()}});
 
-    ui->pluginListWidget->clear();
-    bool lootListAvailable = lootPluginList != nullptr;
-    if (lootListAvailable)
-        lootPluginList->clear();
+    // Show plugins in the last sorted order, with any LOOT hasn't seen yet
+    // after them in scan order.
+    if (!lastSortOrder.isEmpty()) {
+        QHash<QString, int> rank;
+        rank.reserve(lastSortOrder.size());
+        for (int i = 0; i < lastSortOrder.size(); ++i)
+            rank.insert(normalizedPluginKey(lastSortOrder.at(i)), i);
 
-    auto addListItem = [](QListWidget *list, const PluginInfo &plugin) {
-        QString base = QString::fromStdString(plugin.filename);
-        QListWidgetItem *item = new QListWidgetItem(base);
+        std::vector<int> ranks(plugins.size());
+        for (size_t i = 0; i < plugins.size(); ++i)
+            ranks[i] = rank.value(normalizedPluginKey(QString::fromStdString(plugins[i].filename)),
+                                  static_cast<int>(rank.size()));
+        std::vector<size_t> order(plugins.size());
+        std::iota(order.begin(), order.end(), size_t{0});
+        std::stable_sort(order.begin(), order.end(),
+                         [&ranks](size_t lhs, size_t rhs) { return ranks[lhs] < ranks[rhs]; });
 
-        if (plugin.type == "ESM")
-            item->setForeground(Qt::lightGray);
-        else if (plugin.type == "ESP")
-            item->setForeground(Qt::green);
-        else if (plugin.type == "ESL")
-            item->setForeground(Qt::cyan);
+        std::vector<PluginInfo> sorted;
+        sorted.reserve(plugins.size());
+        for (size_t index : order)
+            sorted.push_back(std::move(plugins[index]));
+        plugins = std::move(sorted);
+    }
 
-        list->addItem(item);
-    };
+    // Unchanged rows keep their items, so selection and scroll position
+    // survive a rescan.
+    pluginModel->setPlugins(std::move(plugins));
 
-    for (const auto &plugin : cachedPlugins) {
-        qDebug() << "[UI] adding plugin" << QString::fromStdString(plugin.filename);
-        QString label = QString::fromStdString(plugin.filename + " [" + plugin.type + "]");
-        QListWidgetItem *item = new QListWidgetItem(label);
+    if (lootPluginList) {
+        if (!lootPluginList->currentIndex().isValid() && lootPluginProxy->rowCount() > 0)
+            lootPluginList->setCurrentIndex(lootPluginProxy->index(0, 0));
+        displayLootMetadata(currentLootPluginRow());
+    }
 
-        if (plugin.type == "ESM")
-            item->setForeground(Qt::lightGray);
-        else if (plugin.type == "ESP")
-            item->setForeground(Qt::green);
-        else if (plugin.type == "ESL")
-            item->setForeground(Qt::cyan);
+    LOG_DEBUG("ui", "Populated plugin list", {{"rows", pluginModel->rowCount()}});
+}
 
-        ui->pluginListWidget->addItem(item);
+int MainWindow::currentLootPluginRow() const
+{
+    if (!lootPluginList || !lootPluginProxy)
+        return -1;
+    return lootPluginProxy->sourceRow(lootPluginList->currentIndex());
+}
 
-        if (lootListAvailable)
-            addListItem(lootPluginList, plugin);
+void MainWindow::applyPluginOrder(const QStringList &sortedNames)
+{
+    UI_OPERATION("MainWindow::applyPluginOrder");
+
+    // Work out where each cached plugin ends up. Anything LOOT didn't return
+    // keeps its relative order after the sorted plugins.
+    const std::vector<PluginInfo> &plugins = pluginModel->plugins();
+    QHash<QString, int> cachedIndex;
+    cachedIndex.reserve(static_cast<qsizetype>(plugins.size()));
+    for (int i = 0; i < static_cast<int>(plugins.size()); ++i)
+        cachedIndex.insert(normalizedPluginKey(QString::fromStdString(plugins[i].filename)), i);
+
+    std::vector<int> order;
+    order.reserve(plugins.size());
+    std::vector<bool> placed(plugins.size(), false);
+    for (const QString &name : sortedNames) {
+        auto it = cachedIndex.constFind(normalizedPluginKey(name));
+        if (it == cachedIndex.constEnd() || placed[*it])
+            continue;
+        order.push_back(*it);
+        placed[*it] = true;
     }
-
-    if (lootListAvailable) {
-        if (!cachedPlugins.empty()) {
-            lootPluginList->setCurrentRow(0);
-            displayLootMetadata(0);
-        } else {
-            lootPluginList->clearSelection();
-            displayLootMetadata(-1);
-        }
+    for (int i = 0; i < static_cast<int>(plugins.size()); ++i) {
+        if (!placed[i])
+            order.push_back(i);
     }
 
-    reloadLootMetadata();
-    qDebug() << "[DEBUG] Populated plugin list with" << plugins.size() << "items.";
+    // Moving the rows keeps both views' selections on the same plugins, and
+    // LOOT metadata that was already looked up doesn't need to be queried
+    // again.
+    pluginModel->reorder(order);
+    displayLootMetadata(currentLootPluginRow());
+    lastSortOrder = sortedNames;
 }
 
-void MainWindow::initializeModManager()
+JobScheduler::JobId MainWindow::initializeModManager()
 {
+    // Callers cancel and wait for running jobs first, as they may be using
+    // the current manager.
+    pendingModStates.clear();
+    queuedModStates.clear();
+    modChangeTimer->stop();
+
     if (workspacePath.isEmpty() || virtualDataPath.isEmpty())
-        return;
+        return 0;
+
+    // Keep showing the current list until the new manager has loaded.
+    if (modManager && modsLoaded)
+        restoredMods = modManager->mods();
+    modsLoaded = false;
 
     modManager = std::make_unique<ModManager>(workspacePath, installPath, virtualDataPath, this);
     modManager->setDownloadsRoot(downloadsPath);
 
-    QString error;
-    if (!modManager->initialize(&error) && !error.isEmpty()) {
-        qWarning() << "[ModManager] Initialization issue:" << error;
-    }
+    // Mod jobs emit this from a pool thread. Their finished() calls refresh
+    // the list once the registry is safe to read.
+    connect(modManager.get(), &ModManager::modsChanged, this, [this]() {
+        if (!jobs->isResourceBusy(QStringLiteral("mods")))
+            refreshModsList();
+    });
+    refreshModsList();
 
-    connect(modManager.get(), &ModManager::modsChanged,
-            this, &MainWindow::refreshModsList);
+    // Reading the registry, copying base plugins and redeploying enabled mods
+    // run in the background. Until then the list shows restoredMods.
+    ModManager *manager = modManager.get();
+    auto loaded = std::make_shared<bool>(false);
+    JobScheduler::Job deployment;
+    deployment.key = QStringLiteral("mod-deployment");
+    deployment.description = QStringLiteral("Verifying mod deployment");
+    deployment.resource = QStringLiteral("mods");
+    deployment.run = [manager, loaded](const JobContext &) {
+        QString error;
+        *loaded = manager->load(&error);
+        if (*loaded)
+            manager->verifyDeployment(&error);
+        if (!error.isEmpty())
+            qWarning() << "[ModManager] Initialization issue:" << error;
+    };
+    deployment.finished = [this, loaded]() {
+        modsLoaded = *loaded;
+        if (modsLoaded)
+            restoredMods.clear();
+        refreshModsList();
+    };
+    return jobs->schedule(std::move(deployment));
 }
 
 void MainWindow::refreshModsList()
 {
+    UI_OPERATION("MainWindow::refreshModsList");
+
     if (!ui->modsList || !modManager)
         return;
 
     QSignalBlocker blocker(ui->modsList);
     ui->modsList->clear();
 
-    for (const ModRecord &record : modManager->mods()) {
+    for (const ModRecord &record : displayedMods()) {
         QListWidgetItem *item = new QListWidgetItem(record.name, ui->modsList);
         item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
-        item->setCheckState(record.enabled ? Qt::Checked : Qt::Unchecked);
+        // Changes still waiting to be applied keep their checkbox state.
+        auto pending = std::find_if(pendingModStates.cbegin(), pendingModStates.cend(),
+                                    [&](const auto &state) { return state.first == record.id; });
+        const bool enabled = pending != pendingModStates.cend() ? pending->second : record.enabled;
+        item->setCheckState(enabled ? Qt::Checked : Qt::Unchecked);
         item->setData(Qt::UserRole, record.id);
         if (record.type == ModType::ToolMod)
             item->setText(record.name + " (Tool)");
@@ -1190,8 +1566,90 @@ void MainWindow::refreshModsList()
     updateToolLaunchers();
 }
 
+const QVector<ModRecord> &MainWindow::displayedMods() const
+{
+    // A background job may still be filling in the manager's registry.
+    return modsLoaded ? modManager->mods() : restoredMods;
+}
+
+void MainWindow::waitForModDeployment(JobScheduler::Job &job) const
+{
+    // Mod changes need the registry the deployment job loads.
+    if (JobScheduler::JobId deployment = jobs->find(QStringLiteral("mod-deployment")))
+        job.dependsOn.append(deployment);
+}
+
+void MainWindow::applyModChangesNow()
+{
+    // Callers cancel and wait for running jobs first, so the applied flags
+    // are final.
+    if (modChangeTimer)
+        modChangeTimer->stop();
+    const QMap<quint64, QueuedModBatch> queued = std::exchange(queuedModStates, {});
+    const ModManager::ModStates pending = std::exchange(pendingModStates, {});
+    if (!modManager || (queued.isEmpty() && pending.isEmpty()))
+        return;
+
+    if (!modsLoaded)
+        modsLoaded = modManager->load();
+    if (!modsLoaded)
+        return;
+
+    // Oldest first, so a mod toggled again in a later batch ends up in its
+    // last state.
+    for (const QueuedModBatch &batch : queued) {
+        if (!*batch.applied)
+            modManager->setModsEnabled(batch.states);
+    }
+    if (!pending.isEmpty())
+        modManager->setModsEnabled(pending);
+}
+
+QString MainWindow::workspaceSnapshotPath() const
+{
+    if (workspacePath.isEmpty())
+        return QString();
+    return workspacePath + "/workspace-snapshot.json";
+}
+
+void MainWindow::restoreWorkspaceSnapshot()
+{
+    UI_OPERATION("MainWindow::restoreWorkspaceSnapshot");
+
+    WorkspaceSnapshot snapshot;
+    if (!WorkspaceSnapshot::load(workspaceSnapshotPath(), &snapshot))
+        return;
+
+    restoredMods = std::move(snapshot.mods);
+    if (snapshot.dataPath.isEmpty() || snapshot.dataPath != dataPath)
+        return;
+
+    lastSortOrder = std::move(snapshot.sortOrder);
+    lootPluginDetailsCache = std::move(snapshot.pluginDetails);
+    lootGeneralMessages = snapshot.generalMessages;
+    populatePluginList(std::move(snapshot.plugins));
+    rebuildWarningsTable();
+    qDebug() << "[Snapshot] Restored" << pluginModel->rowCount() << "plugins and"
+             << restoredMods.size() << "mods";
+}
+
+void MainWindow::saveWorkspaceSnapshot() const
+{
+    UI_OPERATION("MainWindow::saveWorkspaceSnapshot");
+
+    WorkspaceSnapshot snapshot;
+    snapshot.dataPath = dataPath;
+    snapshot.plugins = pluginModel->plugins();
+    snapshot.mods = displayedMods();
+    snapshot.pluginDetails = lootPluginDetailsCache;
+    snapshot.generalMessages = lootGeneralMessages;
+    snapshot.sortOrder = lastSortOrder;
+    snapshot.save(workspaceSnapshotPath());
+}
+
 void MainWindow::updateToolLaunchers()
 {
+    UI_OPERATION("MainWindow::updateToolLaunchers");
     if (!runToolCombo)
         return;
 
@@ -1209,7 +1667,7 @@ void MainWindow::updateToolLaunchers()
     toolEntries.push_back(base);
 
     if (modManager) {
-        for (const ModRecord &record : modManager->mods()) {
+        for (const ModRecord &record : displayedMods()) {
             if (record.type != ModType::ToolMod)
                 continue;
             if (record.launcherPath.isEmpty())
@@ -1261,6 +1719,8 @@ void MainWindow::updateToolLaunchers()
 
 void MainWindow::updateIniEditorSources()
 {
+    UI_OPERATION("MainWindow::updateIniEditorSources");
+
     if (!iniEditor)
         return;
 
@@ -1277,55 +1737,148 @@ void MainWindow::updateIniEditorSources()
     iniEditor->setIniRoots(roots);
 }
 
-void MainWindow::rescanVirtualPlugins()
+JobScheduler::JobId MainWindow::scheduleModOperation(const QString &key, const QString &description,
+                                                     std::function<bool(QString *)> operation)
+{
+    auto error = std::make_shared<QString>();
+    auto ok = std::make_shared<bool>(false);
+
+    JobScheduler::Job job;
+    job.key = key;
+    job.description = description;
+    job.resource = QStringLiteral("mods");
+    job.priority = JobScheduler::Priority::Interactive;
+    waitForModDeployment(job);
+    job.run = [operation, error, ok](const JobContext &) { *ok = operation(error.get()); };
+    job.finished = [this, description, error, ok]() {
+        if (!*ok)
+            qWarning() << "[ModManager]" << description << "failed:" << *error;
+        refreshModsList();
+    };
+    return jobs->schedule(std::move(job));
+}
+
+JobScheduler::JobId MainWindow::rescanVirtualPlugins(const QList<JobScheduler::JobId> &after,
+                                                     MetadataScope scope)
 {
     if (dataPath.isEmpty())
-        return;
+        return 0;
+
+    auto scanned = std::make_shared<std::vector<PluginInfo>>();
+    const std::string path = dataPath.toStdString();
+
+    // Scanning reads the virtual Data folder that mod jobs write to.
+    JobScheduler::Job scan;
+    scan.key = QStringLiteral("rescan");
+    scan.description = QStringLiteral("Scanning plugins");
+    scan.resource = QStringLiteral("mods");
+    scan.dependsOn = after;
+    scan.run = [scanned, path](const JobContext &) {
+        PluginManager pluginManager;
+        pluginManager.scan(path);
+        *scanned = pluginManager.getPlugins();
+    };
+    scan.finished = [this, scanned]() { populatePluginList(std::move(*scanned)); };
 
-    qDebug() << "[INIT] Scanning plugins in" << dataPath;
-    PluginManager pluginManager;
-    pluginManager.scan(dataPath.toStdString());
-    populatePluginList(pluginManager.getPlugins());
-    qDebug() << "[INIT] Plugin scan complete";
+    const JobScheduler::JobId scanId = jobs->schedule(std::move(scan));
+    reloadLootMetadata({scanId}, scope);
+    return scanId;
 }
 
 void MainWindow::onInstallArchivesRequested(const QStringList &archives)
 {
-    if (!modManager)
+    UI_OPERATION("MainWindow::onInstallArchivesRequested");
+    if (!modManager || archives.isEmpty())
         return;
 
-    for (const QString &name : archives) {
-        QString archivePath = downloadsPath + "/" + name;
-        ModRecord record;
-        QString error;
-        if (!modManager->installArchive(archivePath, &record, &error)) {
-            qWarning() << "[ModManager] Install failed for" << name << ":" << error;
-            continue;
+    // Keep the user's actions in order.
+    applyPendingModChanges();
+
+    ModManager *manager = modManager.get();
+    QStringList archivePaths;
+    for (const QString &name : archives)
+        archivePaths.append(downloadsPath + "/" + name);
+
+    JobScheduler::Job install;
+    install.description = QString("Installing %1 archive(s)").arg(archivePaths.size());
+    install.resource = QStringLiteral("mods");
+    install.priority = JobScheduler::Priority::Interactive;
+    waitForModDeployment(install);
+    install.run = [manager, archivePaths](const JobContext &context) {
+        for (int i = 0; i < archivePaths.size(); ++i) {
+            if (context.isCancelled())
+                return;
+            ModRecord record;
+            QString error;
+            if (!manager->installArchive(archivePaths.at(i), &record, &error))
+                qWarning() << "[ModManager] Install failed for" << archivePaths.at(i) << ":" << error;
+            context.setProgress((i + 1) * 100 / static_cast<int>(archivePaths.size()));
         }
-    }
+    };
+    install.finished = [this]() { refreshModsList(); };
 
-    refreshModsList();
-    rescanVirtualPlugins();
+    rescanVirtualPlugins({jobs->schedule(std::move(install))});
 }
 
 void MainWindow::onModItemChanged(QListWidgetItem *item)
 {
+    UI_OPERATION("MainWindow::onModItemChanged");
     if (!modManager || !item)
         return;
 
-    QString modId = item->data(Qt::UserRole).toString();
-    bool enabled = item->checkState() == Qt::Checked;
-    QString error;
-    if (!modManager->setModEnabled(modId, enabled, &error)) {
-        qWarning() << "[ModManager] Failed to toggle mod:" << error;
+    // Collect the changes made in quick succession and apply them together,
+    // with one registry save, rescan and metadata refresh.
+    const QString modId = item->data(Qt::UserRole).toString();
+    pendingModStates.erase(std::remove_if(pendingModStates.begin(), pendingModStates.end(),
+                                          [&](const auto &state) { return state.first == modId; }),
+                           pendingModStates.end());
+    pendingModStates.append({modId, item->checkState() == Qt::Checked});
+    modChangeTimer->start();
+}
+
+void MainWindow::applyPendingModChanges()
+{
+    UI_OPERATION("MainWindow::applyPendingModChanges");
+    modChangeTimer->stop();
+    if (!modManager || pendingModStates.isEmpty())
         return;
-    }
 
-    rescanVirtualPlugins();
+    const ModManager::ModStates states = std::exchange(pendingModStates, {});
+    const quint64 batch = nextModBatch++;
+    auto applied = std::make_shared<bool>(false);
+    queuedModStates.insert(batch, {states, applied});
+    ModManager *manager = modManager.get();
+    auto affectedPlugins = std::make_shared<QStringList>();
+    auto error = std::make_shared<QString>();
+    auto ok = std::make_shared<bool>(false);
+
+    // No key: every batch is applied, in the order it was made.
+    JobScheduler::Job job;
+    job.description = QString("Updating %1 mod(s)").arg(states.size());
+    job.resource = QStringLiteral("mods");
+    job.priority = JobScheduler::Priority::Interactive;
+    waitForModDeployment(job);
+    job.run = [manager, states, applied, affectedPlugins, error, ok](const JobContext &) {
+        *applied = true;
+        *ok = manager->setModsEnabled(states, affectedPlugins.get(), error.get());
+    };
+    job.finished = [this, batch, affectedPlugins, error, ok]() {
+        queuedModStates.remove(batch);
+        if (!*ok)
+            qWarning() << "[ModManager] Updating mods failed:" << *error;
+        // Only the plugins these mods added or removed need their LOOT
+        // metadata fetched again.
+        for (const QString &plugin : std::as_const(*affectedPlugins))
+            metadataRefreshScope.insert(normalizedPluginKey(plugin));
+        refreshModsList();
+    };
+
+    rescanVirtualPlugins({jobs->schedule(std::move(job))}, MetadataScope::ChangedPlugins);
 }
 
 void MainWindow::onRemoveModClicked()
 {
+    UI_OPERATION("MainWindow::onRemoveModClicked");
     if (!modManager || !ui->modsList)
         return;
 
@@ -1337,18 +1890,18 @@ void MainWindow::onRemoveModClicked()
     if (modId.isEmpty())
         return;
 
-    QString error;
-    if (!modManager->removeMod(modId, &error)) {
-        qWarning() << "[ModManager] Unable to remove mod:" << error;
-        return;
-    }
+    applyPendingModChanges();
 
-    refreshModsList();
-    rescanVirtualPlugins();
+    ModManager *manager = modManager.get();
+    JobScheduler::JobId removal = scheduleModOperation(
+        "mod-remove:" + modId, QString("Removing %1").arg(current->text()),
+        [manager, modId](QString *error) { return manager->removeMod(modId, error); });
+    rescanVirtualPlugins({removal});
 }
 
 void MainWindow::onRunToolChanged(int index)
 {
+    UI_OPERATION("MainWindow::onRunToolChanged");
     if (!runToolCombo || index < 0 || index >= static_cast<int>(toolEntries.size()))
         return;
 
@@ -1359,6 +1912,7 @@ void MainWindow::onRunToolChanged(int index)
 
 void MainWindow::onRunButtonClicked()
 {
+    UI_OPERATION("MainWindow::onRunButtonClicked");
     if (toolEntries.empty()) {
         appendLootReport("No launch targets available.");
         return;
@@ -1413,6 +1967,7 @@ void MainWindow::onRunButtonClicked()
    CHANGE SKYRIM FOLDER BUTTON HANDLER
    ───────────────────────────────────────────────────────────── */
 void MainWindow::onChangeFolderClicked() {
+    UI_OPERATION("MainWindow::onChangeFolderClicked");
     QString dir = QFileDialog::getExistingDirectory(this, "Select Skyrim Installation Folder");
     if (dir.isEmpty())
         return;
@@ -1421,40 +1976,83 @@ void MainWindow::onChangeFolderClicked() {
     if (chosen.dirName().compare("Data", Qt::CaseInsensitive) == 0)
         chosen.cdUp();
 
+    // The last sort was of the old folder's plugins.
+    if (chosen.absolutePath() != gameInstallPath)
+        lastSortOrder.clear();
+
     gameInstallPath = chosen.absolutePath();
     installPath = gameInstallPath;
     saveConfigPaths();
 
-    initializeModManager();
-    refreshModsList();
-
     activeGame = determineGameType(gameInstallPath);
     updateModeTabIcons();
-    recreateLootManager();
-    rescanVirtualPlugins();
+    startBackgroundStages();
     updateIniEditorSources();
     refreshMasterlistInfoLabels();
-    reloadLootMetadata();
 }
 
 void MainWindow::onSortPluginsClicked()
 {
+    UI_OPERATION("MainWindow::onSortPluginsClicked");
     if (!lootManager) {
         appendLootReport("LOOT manager unavailable. Choose a valid data folder first.");
         return;
     }
 
+    // Sort the plugins the mod list shows, including changes not applied yet.
+    applyPendingModChanges();
+
     appendLootReport(QString("Starting LOOT sort for %1").arg(installPath));
-    bool ok = lootManager->sortPlugins();
-    if (ok) {
+
+    struct SortRun {
+        LootManager *manager = nullptr;
+        QStringList pluginPaths;
+        bool ok = false;
+    };
+    auto sort = std::make_shared<SortRun>();
+
+    JobScheduler::Job job;
+    job.key = QStringLiteral("sort");
+    job.description = QStringLiteral("Sorting plugins");
+    job.resource = QStringLiteral("loot");
+    job.priority = JobScheduler::Priority::Interactive;
+    for (const QString &key : {QStringLiteral("rescan"), QStringLiteral("loot-metadata")}) {
+        if (JobScheduler::JobId pending = jobs->find(key))
+            job.dependsOn.append(pending);
+    }
+    job.started = [this, sort]() {
+        sort->manager = lootManager.get();
+        // The catalog already holds every plugin in the data folder, so hand
+        // those paths straight to LOOT instead of letting it scan the
+        // directory again.
+        sort->pluginPaths = lootPluginPaths();
+    };
+    job.run = [sort](const JobContext &) {
+        if (sort->manager)
+            sort->ok = sort->manager->sortPlugins(sort->pluginPaths);
+    };
+    job.finished = [this, sort]() {
+        LootManager *manager = sort->manager;
+        if (!manager || manager != lootManager.get())
+            return;
+
+        if (!sort->ok) {
+            appendLootReport("LOOT sort failed. Check logs above for details.");
+            return;
+        }
+
+        appendLootReport(QString("Sort cache %1 (%2 hits, %3 misses since LOOT was loaded).")
+                             .arg(manager->lastSortFromCache() ? "hit" : "miss")
+                             .arg(manager->sortCacheHits())
+                             .arg(manager->sortCacheMisses()));
+        for (const QString &line : manager->sortStatisticsReport())
+            appendLootReport(line);
         appendLootReport("LOOT sort completed. Refreshing plugin lists...");
-        PluginManager pluginManager;
-        pluginManager.scan(dataPath.toStdString());
-        populatePluginList(pluginManager.getPlugins());
+        applyPluginOrder(manager->sortedPlugins());
         appendLootReport("Plugin lists updated.");
-    } else {
-        appendLootReport("LOOT sort failed. Check logs above for details.");
-    }
+    };
+
+    jobs->schedule(std::move(job));
 }
 
 LootGameType MainWindow::determineGameType(const QString &dataDir)
@@ -1,4 +1,6 @@
 #include "modManager.h"
+#include "log.h"
+#include "trace.h"
 
 #include <QDir>
 #include <QDirIterator>
@@ -10,6 +12,7 @@
 #include <QProcess>
 #include <QStandardPaths>
 #include <QDebug>
+#include <algorithm>
 
 namespace {
 QString readFileBaseName(const QString &path) {
@@ -36,14 +39,25 @@ void ModManager::setDownloadsRoot(const QString &path)
     downloadsPath = path;
 }
 
-bool ModManager::initialize(QString *errorMessage)
+bool ModManager::load(QString *errorMessage)
 {
+    TRACE_SPAN("mods", "ModManager::load");
+
     ensureDirectories();
 
-    if (!copyBasePlugins(errorMessage))
+    if (!loadRegistry()) {
+        if (errorMessage)
+            *errorMessage = QStringLiteral("Failed to read mod registry: %1").arg(registryPath);
         return false;
+    }
+    return true;
+}
 
-    if (!loadRegistry())
+bool ModManager::verifyDeployment(QString *errorMessage)
+{
+    TRACE_SPAN("mods", "ModManager::verifyDeployment");
+
+    if (!copyBasePlugins(errorMessage))
         return false;
 
     // Ensure enabled mods have their plugins in the virtual data folder
@@ -68,6 +82,8 @@ void ModManager::ensureDirectories() const
 
 bool ModManager::copyBasePlugins(QString *errorMessage)
 {
+    TRACE_SPAN("mods", "ModManager::copyBasePlugins");
+
     if (gameInstall.isEmpty())
         return true;
 
@@ -149,6 +165,8 @@ bool ModManager::loadRegistry()
 
 bool ModManager::saveRegistry() const
 {
+    TRACE_SPAN("mods", "ModManager::saveRegistry");
+
     QJsonArray arr;
     for (const ModRecord &record : installedMods) {
         QJsonObject obj;
@@ -190,6 +208,9 @@ bool ModManager::extractArchive(const QString &archivePath,
                                 const QString &destination,
                                 QString *errorMessage) const
 {
+    Trace::Span span("mods", "ModManager::extractArchive");
+    span.setDetail(archivePath);
+
     QDir destDir(destination);
     if (destDir.exists())
         destDir.removeRecursively();
@@ -253,6 +274,9 @@ bool ModManager::installArchive(const QString &archivePath,
                                 ModRecord *outRecord,
                                 QString *errorMessage)
 {
+    Trace::Span span("mods", "ModManager::installArchive");
+    span.setDetail(archivePath);
+
     QFileInfo archiveInfo(archivePath);
     if (!archiveInfo.exists()) {
         if (errorMessage)
@@ -317,6 +341,9 @@ bool ModManager::installArchive(const QString &archivePath,
 
 bool ModManager::copyPluginsToVirtual(const ModRecord &record, QString *errorMessage)
 {
+    Trace::Span span("mods", "ModManager::copyPluginsToVirtual");
+    span.setDetail(record.name);
+
     for (const QString &plugin : record.pluginFiles) {
         QString src = record.dataPath + "/" + plugin;
         QString dest = virtualData + "/" + plugin;
@@ -333,6 +360,9 @@ bool ModManager::copyPluginsToVirtual(const ModRecord &record, QString *errorMes
 
 bool ModManager::removePluginsFromVirtual(const ModRecord &record, QString *errorMessage)
 {
+    Trace::Span span("mods", "ModManager::removePluginsFromVirtual");
+    span.setDetail(record.name);
+
     for (const QString &plugin : record.pluginFiles) {
         QString dest = virtualData + "/" + plugin;
         if (QFile::exists(dest) && !QFile::remove(dest)) {
@@ -346,37 +376,81 @@ bool ModManager::removePluginsFromVirtual(const ModRecord &record, QString *erro
 
 bool ModManager::setModEnabled(const QString &modId, bool enabled, QString *errorMessage)
 {
-    for (ModRecord &record : installedMods) {
-        if (record.id != modId)
-            continue;
-
-        if (record.enabled == enabled)
-            return true;
-
-        record.enabled = enabled;
-        bool ok = enabled ? copyPluginsToVirtual(record, errorMessage)
-                          : removePluginsFromVirtual(record, errorMessage);
+    return setModsEnabled({{modId, enabled}}, nullptr, errorMessage);
+}
 
-        if (ok && record.type == ModType::ToolMod) {
-            if (enabled)
-                deployToolAssets(record, nullptr);
-            else
-                cleanupToolAssets(record);
+bool ModManager::setModsEnabled(const ModStates &states,
+                                QStringList *affectedPlugins,
+                                QString *errorMessage)
+{
+    TRACE_SPAN("mods", "ModManager::setModsEnabled");
+
+    bool allOk = true;
+    bool changed = false;
+    bool anySucceeded = false;
+    auto fail = [&](const QString &message) {
+        if (allOk && errorMessage)
+            *errorMessage = message;
+        allOk = false;
+    };
+
+    auto apply = [&](const QString &modId, bool enabled) {
+        auto record = std::find_if(installedMods.begin(), installedMods.end(),
+                                   [&](const ModRecord &mod) { return mod.id == modId; });
+        if (record == installedMods.end()) {
+            fail(QStringLiteral("Unknown mod id: %1").arg(modId));
+            return;
         }
+        if (record->enabled == enabled)
+            return;
 
-        saveRegistry();
-        if (ok)
-            emit modsChanged();
-        return ok;
+        QString error;
+        changed = true;
+        if (applyModEnabled(*record, enabled, &error))
+            anySucceeded = true;
+        else
+            fail(error);
+        if (affectedPlugins)
+            affectedPlugins->append(record->pluginFiles);
+    };
+
+    for (const auto &state : states) {
+        if (!state.second)
+            apply(state.first, false);
+    }
+    for (const auto &state : states) {
+        if (state.second)
+            apply(state.first, true);
     }
 
-    if (errorMessage)
-        *errorMessage = QStringLiteral("Unknown mod id: %1").arg(modId);
-    return false;
+    if (!changed)
+        return allOk;
+
+    saveRegistry();
+    if (anySucceeded)
+        emit modsChanged();
+    return allOk;
+}
+
+bool ModManager::applyModEnabled(ModRecord &record, bool enabled, QString *errorMessage)
+{
+    record.enabled = enabled;
+    bool ok = enabled ? copyPluginsToVirtual(record, errorMessage)
+                      : removePluginsFromVirtual(record, errorMessage);
+
+    if (ok && record.type == ModType::ToolMod) {
+        if (enabled)
+            deployToolAssets(record, nullptr);
+        else
+            cleanupToolAssets(record);
+    }
+    return ok;
 }
 
 bool ModManager::removeMod(const QString &modId, QString *errorMessage)
 {
+    TRACE_SPAN("mods", "ModManager::removeMod");
+
     for (int i = 0; i < installedMods.size(); ++i) {
         const ModRecord &record = installedMods.at(i);
         if (record.id != modId)
@@ -405,14 +479,17 @@ bool ModManager::removeMod(const QString &modId, QString *errorMessage)
 
 bool ModManager::deployToolAssets(ModRecord &record, QString *errorMessage)
 {
+    Trace::Span span("mods", "ModManager::deployToolAssets");
+    span.setDetail(record.name);
+
     if (record.type != ModType::ToolMod)
         return true;
 
     QString toolsRoot = workspace + "/Tools/" + record.id;
     QDir().mkpath(toolsRoot);
 
-    qDebug() << "[ModManager] Deploying tool assets for" << record.name
-             << "from" << record.modPath << "to" << toolsRoot;
+    LOG_DEBUG("mods", "Deploying tool assets",
+              {{"mod", record.name}, {"from", record.modPath}, {"to", toolsRoot}});
 
     bool copiedAny = false;
     QDir root(record.modPath);
@@ -431,6 +508,7 @@ bool ModManager::deployToolAssets(ModRecord &record, QString *errorMessage)
         QDir().mkpath(QFileInfo(dest).absolutePath());
         QFile::remove(dest);
         if (QFile::copy(src, dest)) {
+            LOG_TRACE("mods", "Copied tool asset", {{"file", file}});
             copiedAny = true;
             if (suffix == "exe" && file.contains("loader", Qt::CaseInsensitive)) {
                 loaderSource = dest;
@@ -442,7 +520,8 @@ bool ModManager::deployToolAssets(ModRecord &record, QString *errorMessage)
     if (!copiedAny && errorMessage)
         *errorMessage = QStringLiteral("No SKSE files were copied.");
 
-    qDebug() << "[ModManager] Deployment complete. Launcher path:" << record.launcherPath;
+    LOG_DEBUG("mods", "Deployed tool assets",
+              {{"mod", record.name}, {"copied", copiedAny}, {"launcher", record.launcherPath}});
     return copiedAny;
 }
 
@@ -1,7 +1,9 @@
 #ifndef MODMANAGER_H
 #define MODMANAGER_H
 
+#include <QHash>
 #include <QObject>
+#include <QPair>
 #include <QString>
 #include <QStringList>
 #include <QVector>
@@ -33,7 +35,11 @@ public:
                         const QString &virtualDataPath,
                         QObject *parent = nullptr);
 
-    bool initialize(QString *errorMessage = nullptr);
+    // Reads the mod registry. Quick enough to call before the window shows.
+    bool load(QString *errorMessage = nullptr);
+    // Copies the base game plugins and redeploys every enabled mod to the
+    // virtual Data folder. This copies files, so run it off the GUI thread.
+    bool verifyDeployment(QString *errorMessage = nullptr);
 
     const QVector<ModRecord>& mods() const { return installedMods; }
 
@@ -41,7 +47,20 @@ public:
                         ModRecord *outRecord,
                         QString *errorMessage);
 
+    // Enable states by mod id, in the order they were chosen.
+    using ModStates = QVector<QPair<QString, bool>>;
+
     bool setModEnabled(const QString &modId, bool enabled, QString *errorMessage = nullptr);
+    // Applies several enable/disable changes as one batch: the registry is
+    // saved once and modsChanged() emitted once if any change succeeded.
+    // Disables go first, because mods sharing a plugin filename share its
+    // copy in VirtualData, and removing one mod's copy after copying the
+    // other's would lose it. Every change is attempted even if one fails;
+    // errorMessage gets the first failure. affectedPlugins receives the
+    // plugin files of the mods that changed.
+    bool setModsEnabled(const ModStates &states,
+                        QStringList *affectedPlugins = nullptr,
+                        QString *errorMessage = nullptr);
     bool removeMod(const QString &modId, QString *errorMessage = nullptr);
 
     QString downloadsRoot() const { return downloadsPath; }
@@ -79,6 +98,7 @@ private:
     bool removePluginsFromVirtual(const ModRecord &record, QString *errorMessage);
     bool deployToolAssets(ModRecord &record, QString *errorMessage);
     void cleanupToolAssets(const ModRecord &record);
+    bool applyModEnabled(ModRecord &record, bool enabled, QString *errorMessage);
 };
 
 #endif // MODMANAGER_H
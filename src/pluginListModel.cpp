@@ -0,0 +1,160 @@
+#include "pluginListModel.h"
+#include <QBrush>
+#include <algorithm>
+#include <iterator>
+
+namespace {
+bool samePlugin(const PluginInfo &a, const PluginInfo &b)
+{
+    return a.filename == b.filename;
+}
+
+bool sameContent(const PluginInfo &a, const PluginInfo &b)
+{
+    return a.filename == b.filename && a.name == b.name
+        && a.type == b.type && a.masters == b.masters;
+}
+}
+
+PluginListModel::PluginListModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int PluginListModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return static_cast<int>(catalog.size());
+}
+
+QVariant PluginListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= rowCount())
+        return QVariant();
+
+    const PluginInfo &plugin = catalog[static_cast<size_t>(index.row())];
+    switch (role) {
+    case Qt::DisplayRole:
+    case FilenameRole:
+        return QString::fromStdString(plugin.filename);
+    case TypeRole:
+        return QString::fromStdString(plugin.type);
+    case LabelRole:
+        return QString::fromStdString(plugin.filename + " [" + plugin.type + "]");
+    case Qt::ForegroundRole:
+        if (plugin.type == "ESM")
+            return QBrush(Qt::lightGray);
+        if (plugin.type == "ESP")
+            return QBrush(Qt::green);
+        if (plugin.type == "ESL")
+            return QBrush(Qt::cyan);
+        return QVariant();
+    default:
+        return QVariant();
+    }
+}
+
+void PluginListModel::setPlugins(std::vector<PluginInfo> plugins)
+{
+    const size_t oldCount = catalog.size();
+    const size_t newCount = plugins.size();
+
+    // Rows that are the same plugin in both lists, from the front and back.
+    size_t head = 0;
+    while (head < oldCount && head < newCount && samePlugin(catalog[head], plugins[head]))
+        ++head;
+    size_t tail = 0;
+    while (tail < oldCount - head && tail < newCount - head
+           && samePlugin(catalog[oldCount - 1 - tail], plugins[newCount - 1 - tail]))
+        ++tail;
+
+    // Work out which kept rows changed before the catalog is replaced.
+    std::vector<int> changedRows;
+    for (size_t i = 0; i < head; ++i) {
+        if (!sameContent(catalog[i], plugins[i]))
+            changedRows.push_back(static_cast<int>(i));
+    }
+    for (size_t i = 0; i < tail; ++i) {
+        if (!sameContent(catalog[oldCount - 1 - i], plugins[newCount - 1 - i]))
+            changedRows.push_back(static_cast<int>(newCount - 1 - i));
+    }
+
+    const int first = static_cast<int>(head);
+    const size_t removed = oldCount - head - tail;
+    const size_t inserted = newCount - head - tail;
+
+    if (removed > 0) {
+        beginRemoveRows(QModelIndex(), first, first + static_cast<int>(removed) - 1);
+        catalog.erase(catalog.begin() + static_cast<std::ptrdiff_t>(head),
+                      catalog.begin() + static_cast<std::ptrdiff_t>(head + removed));
+        endRemoveRows();
+    }
+
+    if (inserted > 0) {
+        beginInsertRows(QModelIndex(), first, first + static_cast<int>(inserted) - 1);
+        catalog.insert(catalog.begin() + static_cast<std::ptrdiff_t>(head),
+                       std::make_move_iterator(plugins.begin() + static_cast<std::ptrdiff_t>(head)),
+                       std::make_move_iterator(plugins.begin() + static_cast<std::ptrdiff_t>(head + inserted)));
+        endInsertRows();
+    }
+
+    // The kept rows now line up, so take over their new content and notify
+    // each contiguous run of changed rows at once.
+    std::sort(changedRows.begin(), changedRows.end());
+    for (int row : changedRows)
+        catalog[static_cast<size_t>(row)] = std::move(plugins[static_cast<size_t>(row)]);
+
+    for (size_t i = 0; i < changedRows.size();) {
+        size_t j = i;
+        while (j + 1 < changedRows.size() && changedRows[j + 1] == changedRows[j] + 1)
+            ++j;
+        emit dataChanged(index(changedRows[i]), index(changedRows[j]));
+        i = j + 1;
+    }
+}
+
+void PluginListModel::reorder(const std::vector<int> &order)
+{
+    if (order.size() != catalog.size())
+        return;
+
+    emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+
+    std::vector<int> newRowOf(order.size());
+    std::vector<PluginInfo> reordered;
+    reordered.reserve(catalog.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        reordered.push_back(std::move(catalog[static_cast<size_t>(order[i])]));
+        newRowOf[static_cast<size_t>(order[i])] = static_cast<int>(i);
+    }
+    catalog = std::move(reordered);
+
+    // Keep selections and current items attached to the same plugins.
+    const QModelIndexList oldIndexes = persistentIndexList();
+    QModelIndexList newIndexes;
+    newIndexes.reserve(oldIndexes.size());
+    for (const QModelIndex &old : oldIndexes)
+        newIndexes.append(index(newRowOf[static_cast<size_t>(old.row())], old.column()));
+    changePersistentIndexList(oldIndexes, newIndexes);
+
+    emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+PluginListProxyModel::PluginListProxyModel(int displayRole, QObject *parent)
+    : QSortFilterProxyModel(parent),
+      displaySourceRole(displayRole)
+{
+}
+
+QVariant PluginListProxyModel::data(const QModelIndex &index, int role) const
+{
+    return QSortFilterProxyModel::data(index, role == Qt::DisplayRole ? displaySourceRole : role);
+}
+
+int PluginListProxyModel::sourceRow(const QModelIndex &index) const
+{
+    if (!index.isValid())
+        return -1;
+    return mapToSource(index).row();
+}
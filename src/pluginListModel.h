@@ -0,0 +1,61 @@
+#ifndef PLUGINLISTMODEL_H
+#define PLUGINLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QSortFilterProxyModel>
+#include <vector>
+#include "pluginManager.h"
+
+// The scanned plugin catalog, in load order. Both plugin panes view it through
+// their own PluginListProxyModel, so there is one copy of the plugin data and
+// refreshes only notify the rows that actually changed.
+class PluginListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        FilenameRole = Qt::UserRole + 1,
+        TypeRole,
+        // "<filename> [<type>]", as shown in the mod pane.
+        LabelRole
+    };
+
+    explicit PluginListModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    const std::vector<PluginInfo> &plugins() const { return catalog; }
+
+    // Replaces the catalog. Rows shared with the current catalog at the start
+    // and end are kept, and only the rows in between are removed, inserted or
+    // marked as changed, so views keep their selection and scroll position.
+    void setPlugins(std::vector<PluginInfo> plugins);
+
+    // Moves the plugins so that new row i holds the plugin that was at
+    // order[i]. order must be a permutation of the current rows.
+    void reorder(const std::vector<int> &order);
+
+private:
+    std::vector<PluginInfo> catalog;
+};
+
+// Shows the shared plugin catalog with a pane-specific display text.
+class PluginListProxyModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+
+public:
+    explicit PluginListProxyModel(int displayRole, QObject *parent = nullptr);
+
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    // Row in PluginListModel for the given proxy row, or -1.
+    int sourceRow(const QModelIndex &index) const;
+
+private:
+    int displaySourceRole;
+};
+
+#endif // PLUGINLISTMODEL_H
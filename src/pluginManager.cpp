@@ -1,4 +1,6 @@
 #include "../ui/pluginManager.h"
+#include "log.h"
+#include "trace.h"
 #include <iostream>
 #include <fstream>
 #include <cstring>
@@ -48,11 +50,12 @@ bool PluginManager::readTES4Header(const fs::path& filepath, PluginInfo& out) {
 }
 
 void PluginManager::scan(const std::string& dataDir) {
-    std::cout << "[PluginManager] scan start: " << dataDir << std::endl;
+    TRACE_SPAN("scan", "PluginManager::scan");
+    LOG_DEBUG("scan", "Plugin scan started", {{"dir", dataDir}});
     plugins.clear();
 
     if (!fs::exists(dataDir) || !fs::is_directory(dataDir)) {
-        std::cerr << "Error: directory not found: " << dataDir << std::endl;
+        LOG_ERROR("scan", "Data directory not found", {{"dir", dataDir}});
         return;
     }
 
@@ -61,15 +64,18 @@ void PluginManager::scan(const std::string& dataDir) {
         auto ext = entry.path().extension().string();
         for (auto& c : ext) c = tolower(c);
         if (ext == ".esm" || ext == ".esp" || ext == ".esl") {
-            std::cout << "[PluginManager] Reading " << entry.path() << std::endl;
+            LOG_TRACE("scan", "Reading plugin", {{"file", entry.path().filename().string()}});
             PluginInfo info;
+            Trace::Span span("scan", "PluginManager::readTES4Header");
+            if (span.isActive())
+                span.setDetail(QString::fromStdString(entry.path().filename().string()));
             if (readTES4Header(entry.path(), info)) {
                 info.syncName();
                 plugins.push_back(info);
             }
         }
     }
-    std::cout << "[PluginManager] scan complete. Total: " << plugins.size() << std::endl;
+    LOG_DEBUG("scan", "Plugin scan finished", {{"dir", dataDir}, {"plugins", plugins.size()}});
 }
 
 void PluginManager::printSummary() const {
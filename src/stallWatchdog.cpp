@@ -0,0 +1,171 @@
+#include "stallWatchdog.h"
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+#include <algorithm>
+
+namespace {
+std::atomic<const char *> currentOperation{nullptr};
+
+// Thresholds below this mostly catch ordinary repaints.
+constexpr int MinThresholdMs = 10;
+
+const QString Unattributed = QStringLiteral("(unattributed)");
+}
+
+StallScope::StallScope(const char *operation)
+    : previous(currentOperation.exchange(operation, std::memory_order_acq_rel))
+{
+}
+
+StallScope::~StallScope()
+{
+    currentOperation.store(previous, std::memory_order_release);
+}
+
+const char *StallScope::current()
+{
+    return currentOperation.load(std::memory_order_acquire);
+}
+
+StallWatchdog::StallWatchdog(QObject *parent)
+    : QObject(parent)
+{
+}
+
+StallWatchdog::~StallWatchdog()
+{
+    stop();
+}
+
+void StallWatchdog::start()
+{
+    if (thread)
+        return;
+
+    running.store(true, std::memory_order_relaxed);
+    thread = QThread::create([this]() { monitor(); });
+    thread->setObjectName("StallWatchdog");
+    thread->start(QThread::HighPriority);
+    qDebug() << "[Stall] Watching the GUI thread, threshold" << thresholdMs() << "ms";
+}
+
+void StallWatchdog::stop()
+{
+    if (!thread)
+        return;
+
+    running.store(false, std::memory_order_relaxed);
+    thread->wait();
+    delete thread;
+    thread = nullptr;
+}
+
+void StallWatchdog::setThresholdMs(int ms)
+{
+    threshold.store(std::max(ms, MinThresholdMs), std::memory_order_relaxed);
+}
+
+void StallWatchdog::clear()
+{
+    recent.clear();
+    stats.clear();
+    emit cleared();
+}
+
+int StallWatchdog::bucketFor(qint64 durationMs)
+{
+    const auto it = std::upper_bound(BucketLimitsMs.begin(), BucketLimitsMs.end(), durationMs);
+    return static_cast<int>(it - BucketLimitsMs.begin());
+}
+
+void StallWatchdog::monitor()
+{
+    QElapsedTimer clock;
+    clock.start();
+    quint64 sequence = 0;
+
+    while (running.load(std::memory_order_relaxed)) {
+        const quint64 ping = ++sequence;
+        const qint64 sent = clock.elapsed();
+        QMetaObject::invokeMethod(this, [this, ping]() {
+            answered.store(ping, std::memory_order_release);
+        }, Qt::QueuedConnection);
+
+        // Blame the scope open when the threshold ran out, or failing that
+        // the first one opened after it.
+        const char *operation = nullptr;
+        bool stalled = false;
+        while (running.load(std::memory_order_relaxed)
+               && answered.load(std::memory_order_acquire) != ping) {
+            QThread::msleep(static_cast<unsigned long>(std::max(1, thresholdMs() / 10)));
+            if (clock.elapsed() - sent < thresholdMs())
+                continue;
+            stalled = true;
+            if (!operation)
+                operation = StallScope::current();
+        }
+        if (!running.load(std::memory_order_relaxed))
+            break;
+
+        if (stalled) {
+            const qint64 durationMs = clock.elapsed() - sent;
+            const QString name = operation ? QString::fromLatin1(operation) : Unattributed;
+            QMetaObject::invokeMethod(this, [this, name, durationMs]() {
+                record(name, durationMs);
+            }, Qt::QueuedConnection);
+        }
+
+        QThread::msleep(static_cast<unsigned long>(thresholdMs()));
+    }
+}
+
+void StallWatchdog::record(const QString &operation, qint64 durationMs)
+{
+    qWarning().noquote() << QString("[Stall] GUI thread blocked for %1 ms in %2")
+                                .arg(durationMs).arg(operation);
+
+    Stall stall{operation, durationMs, QDateTime::currentDateTime()};
+    appendToLog(stall);
+    recent.append(stall);
+    if (recent.size() > MaxRecentStalls)
+        recent.removeFirst();
+
+    OperationStats &entry = stats[operation];
+    ++entry.count;
+    entry.totalMs += durationMs;
+    entry.maxMs = std::max(entry.maxMs, durationMs);
+    ++entry.buckets[static_cast<size_t>(bucketFor(durationMs))];
+
+    emit stallRecorded(operation, durationMs);
+}
+
+void StallWatchdog::appendToLog(const Stall &stall)
+{
+    if (logPath.isEmpty())
+        return;
+
+    const QFileInfo info(logPath);
+    if (!info.exists()) {
+        QDir().mkpath(info.absolutePath());
+    } else if (info.size() >= MaxLogBytes) {
+        const QString backup = logPath + ".1";
+        QFile::remove(backup);
+        QFile::rename(logPath, backup);
+    }
+
+    QFile file(logPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        qWarning() << "[Stall] Unable to write" << logPath;
+        logPath.clear();
+        return;
+    }
+    const QString line = QString("%1\t%2 ms\t%3\n")
+                             .arg(stall.when.toString(Qt::ISODateWithMs))
+                             .arg(stall.durationMs)
+                             .arg(stall.operation);
+    file.write(line.toUtf8());
+}
@@ -0,0 +1,117 @@
+#ifndef STALLWATCHDOG_H
+#define STALLWATCHDOG_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <array>
+#include <atomic>
+#include "trace.h"
+
+class QThread;
+
+// Notices when the GUI thread stops processing events and says what it was
+// doing at the time.
+//
+// A watchdog thread posts a ping to the event loop and waits for it to be
+// handled. If that takes longer than the threshold, the stall is blamed on
+// the innermost StallScope open on the GUI thread when the threshold ran out,
+// and recorded once the loop answers. Stalls are logged with qWarning, kept
+// for the diagnostics tab and appended to a log file that rolls over to a
+// single ".1" backup.
+class StallWatchdog : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Upper bounds (ms) of the histogram buckets. The last bucket has none.
+    static constexpr std::array<qint64, 4> BucketLimitsMs{100, 250, 1000, 5000};
+    static constexpr int BucketCount = static_cast<int>(BucketLimitsMs.size()) + 1;
+    static constexpr int DefaultThresholdMs = 50;
+
+    struct Stall {
+        QString operation;
+        qint64 durationMs = 0;
+        QDateTime when;
+    };
+
+    struct OperationStats {
+        int count = 0;
+        qint64 totalMs = 0;
+        qint64 maxMs = 0;
+        std::array<int, BucketCount> buckets{};
+    };
+
+    // Must be created on the GUI thread.
+    explicit StallWatchdog(QObject *parent = nullptr);
+    ~StallWatchdog() override;
+
+    // Start once the event loop is running, or the wait for it counts as a
+    // stall.
+    void start();
+    void stop();
+
+    int thresholdMs() const { return threshold.load(std::memory_order_relaxed); }
+    void setThresholdMs(int ms);
+
+    // Empty to stop writing the log.
+    void setLogFile(const QString &path) { logPath = path; }
+    QString logFile() const { return logPath; }
+
+    // Oldest first, at most MaxRecentStalls.
+    const QVector<Stall> &recentStalls() const { return recent; }
+    const QHash<QString, OperationStats> &operationStats() const { return stats; }
+    void clear();
+
+    static int bucketFor(qint64 durationMs);
+
+signals:
+    void stallRecorded(const QString &operation, qint64 durationMs);
+    void cleared();
+
+private:
+    static constexpr int MaxRecentStalls = 200;
+    static constexpr qint64 MaxLogBytes = 512 * 1024;
+
+    void monitor();
+    void record(const QString &operation, qint64 durationMs);
+    void appendToLog(const Stall &stall);
+
+    QThread *thread = nullptr;
+    std::atomic<bool> running{false};
+    std::atomic<int> threshold{DefaultThresholdMs};
+    // Sequence number of the last ping the GUI thread answered.
+    std::atomic<quint64> answered{0};
+
+    // GUI thread only.
+    QString logPath;
+    QVector<Stall> recent;
+    QHash<QString, OperationStats> stats;
+};
+
+// Names what the GUI thread is doing for stall reports. Scopes nest, and the
+// innermost one is blamed. Use only on the GUI thread, with a string literal.
+class StallScope
+{
+public:
+    explicit StallScope(const char *operation);
+    ~StallScope();
+
+    StallScope(const StallScope &) = delete;
+    StallScope &operator=(const StallScope &) = delete;
+
+    // The innermost open scope's name, or nullptr. Safe from any thread.
+    static const char *current();
+
+private:
+    const char *previous;
+};
+
+// STALL_SCOPE("onSortPluginsClicked");
+#define STALL_SCOPE(operation) StallScope TRACE_CONCAT(stallScope, __LINE__)(operation)
+// GUI-thread work that should show up in both traces and stall reports.
+#define UI_OPERATION(name) TRACE_SPAN("ui", name); STALL_SCOPE(name)
+
+#endif // STALLWATCHDOG_H
@@ -0,0 +1,161 @@
+#include "trace.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <vector>
+
+namespace Trace {
+
+namespace internal {
+std::atomic<bool> enabled{false};
+}
+
+namespace {
+// Keeps a forgotten trace from using up all memory. Roughly 100 MB.
+constexpr size_t MaxEvents = 1000000;
+
+struct Event {
+    char phase;  // 'X' complete span, 'i' instant
+    const char *category;
+    const char *literalName;
+    QString name;
+    QString detail;
+    qint64 timestamp;  // microseconds since start()
+    qint64 duration;
+    quint32 thread;
+};
+
+QMutex eventMutex;
+std::vector<Event> events;
+size_t droppedEvents = 0;
+QElapsedTimer clock;
+QString outputFile;
+quint32 mainThread = 0;
+
+std::atomic<quint32> nextThreadId{1};
+
+// Small stable ids read better in the trace viewer than native thread ids.
+quint32 currentThreadId()
+{
+    thread_local const quint32 id = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+qint64 nowMicros()
+{
+    return clock.nsecsElapsed() / 1000;
+}
+
+void record(Event event)
+{
+    QMutexLocker locker(&eventMutex);
+    if (events.size() >= MaxEvents) {
+        ++droppedEvents;
+        return;
+    }
+    events.push_back(std::move(event));
+}
+}
+
+void start(const QString &outputPath)
+{
+    QMutexLocker locker(&eventMutex);
+    events.clear();
+    events.reserve(4096);
+    droppedEvents = 0;
+    outputFile = outputPath;
+    mainThread = currentThreadId();
+    clock.start();
+    internal::enabled.store(true, std::memory_order_release);
+    qDebug() << "[Trace] Recording to" << outputPath;
+}
+
+void stop()
+{
+    if (!isEnabled())
+        return;
+    internal::enabled.store(false, std::memory_order_release);
+
+    std::vector<Event> recorded;
+    size_t dropped = 0;
+    {
+        QMutexLocker locker(&eventMutex);
+        recorded.swap(events);
+        dropped = droppedEvents;
+    }
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray traceEvents;
+
+    QJsonObject threadName;
+    threadName.insert("ph", "M");
+    threadName.insert("name", "thread_name");
+    threadName.insert("pid", pid);
+    threadName.insert("tid", static_cast<qint64>(mainThread));
+    threadName.insert("args", QJsonObject{{"name", "GUI"}});
+    traceEvents.append(threadName);
+
+    for (const Event &event : recorded) {
+        QJsonObject obj;
+        obj.insert("ph", QString(QChar(event.phase)));
+        obj.insert("cat", event.category);
+        obj.insert("name", event.literalName ? QString::fromLatin1(event.literalName) : event.name);
+        obj.insert("ts", event.timestamp);
+        obj.insert("pid", pid);
+        obj.insert("tid", static_cast<qint64>(event.thread));
+        if (event.phase == 'X')
+            obj.insert("dur", event.duration);
+        else
+            obj.insert("s", "t");
+        if (!event.detail.isEmpty())
+            obj.insert("args", QJsonObject{{"detail", event.detail}});
+        traceEvents.append(obj);
+    }
+
+    QJsonObject root;
+    root.insert("traceEvents", traceEvents);
+    root.insert("displayTimeUnit", "ms");
+
+    QDir().mkpath(QFileInfo(outputFile).absolutePath());
+    QSaveFile file(outputFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[Trace] Unable to write" << outputFile;
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (file.commit())
+        qDebug() << "[Trace] Wrote" << recorded.size() << "events to" << outputFile;
+    if (dropped > 0)
+        qWarning() << "[Trace] Dropped" << dropped << "events over the" << MaxEvents << "limit";
+}
+
+void instant(const char *category, const QString &name, const QString &detail)
+{
+    if (!isEnabled())
+        return;
+    record({'i', category, nullptr, name, detail, nowMicros(), 0, currentThreadId()});
+}
+
+void Span::begin()
+{
+    startMicros = nowMicros();
+}
+
+void Span::end()
+{
+    // Tracing may have stopped while the span was open.
+    if (!isEnabled())
+        return;
+    const qint64 now = nowMicros();
+    record({'X', category, literalName, dynamicName, detail, startMicros, now - startMicros, currentThreadId()});
+}
+
+}
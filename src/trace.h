@@ -0,0 +1,82 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <QString>
+#include <atomic>
+
+// Scoped timing spans written as Chrome Trace Event JSON, which Perfetto
+// (ui.perfetto.dev) and chrome://tracing can open.
+//
+// Tracing is off unless start() is called, which main() does when the
+// NORDIC_TRACE environment variable names an output file. While it's off a
+// span costs one atomic load and records nothing.
+namespace Trace {
+
+namespace internal {
+extern std::atomic<bool> enabled;
+}
+
+inline bool isEnabled() { return internal::enabled.load(std::memory_order_acquire); }
+
+// Starts collecting events, which stop() writes to outputPath.
+void start(const QString &outputPath);
+void stop();
+
+// A point-in-time event, e.g. a log message.
+void instant(const char *category, const QString &name, const QString &detail = QString());
+
+// Times the enclosing scope. TRACE_SPAN covers the usual case; declare a Span
+// directly to attach a detail to it.
+class Span
+{
+public:
+    Span(const char *category, const char *name)
+        : category(category), literalName(name)
+    {
+        if (isEnabled())
+            begin();
+    }
+    Span(const char *category, const QString &name)
+        : category(category)
+    {
+        if (isEnabled()) {
+            dynamicName = name;
+            begin();
+        }
+    }
+    ~Span()
+    {
+        if (startMicros >= 0)
+            end();
+    }
+
+    Span(const Span &) = delete;
+    Span &operator=(const Span &) = delete;
+
+    bool isActive() const { return startMicros >= 0; }
+    // Shown in the event's args. Does nothing while tracing is off.
+    void setDetail(const QString &text)
+    {
+        if (isActive())
+            detail = text;
+    }
+
+private:
+    void begin();
+    void end();
+
+    const char *category;
+    const char *literalName = nullptr;
+    QString dynamicName;
+    QString detail;
+    qint64 startMicros = -1;
+};
+
+}
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+// TRACE_SPAN("loot", "LootManager::sortPlugins");
+#define TRACE_SPAN(category, name) Trace::Span TRACE_CONCAT(traceSpan, __LINE__)(category, name)
+
+#endif // TRACE_H
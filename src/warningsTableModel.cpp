@@ -0,0 +1,326 @@
+#include "warningsTableModel.h"
+#include <QJsonValue>
+#include <algorithm>
+
+void WarningsTableModel::Columns::clear()
+{
+    plugin.clear();
+    type.clear();
+    kind.clear();
+    text.clear();
+    dirty.clear();
+}
+
+WarningsTableModel::WarningsTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+int WarningsTableModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return static_cast<int>(viewOrder.size());
+}
+
+int WarningsTableModel::columnCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return ColumnCount;
+}
+
+QVariant WarningsTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= rowCount())
+        return QVariant();
+    if (role != Qt::DisplayRole && role != Qt::ToolTipRole)
+        return QVariant();
+    if (role == Qt::ToolTipRole && index.column() != DetailsColumn)
+        return QVariant();
+
+    const size_t row = static_cast<size_t>(viewOrder[static_cast<size_t>(index.row())]);
+    switch (index.column()) {
+    case PluginColumn:
+        return pluginNames.at(rows.plugin[row]);
+    case TypeColumn:
+        return typeNames.at(rows.type[row]);
+    case DetailsColumn:
+        return detailText(row);
+    default:
+        return QVariant();
+    }
+}
+
+QVariant WarningsTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        return QAbstractTableModel::headerData(section, orientation, role);
+
+    switch (section) {
+    case PluginColumn:
+        return QStringLiteral("Plugin");
+    case TypeColumn:
+        return QStringLiteral("Type");
+    case DetailsColumn:
+        return QStringLiteral("Details");
+    default:
+        return QVariant();
+    }
+}
+
+void WarningsTableModel::sort(int column, Qt::SortOrder order)
+{
+    if (column < 0 || column >= ColumnCount)
+        return;
+
+    sortColumn = column;
+    sortOrder = order;
+
+    emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+
+    const QModelIndexList oldIndexes = persistentIndexList();
+    std::vector<int> storedRows;
+    storedRows.reserve(static_cast<size_t>(oldIndexes.size()));
+    for (const QModelIndex &old : oldIndexes)
+        storedRows.push_back(viewOrder[static_cast<size_t>(old.row())]);
+
+    std::stable_sort(viewOrder.begin(), viewOrder.end(), [this](int lhs, int rhs) {
+        return lessThan(static_cast<size_t>(lhs), static_cast<size_t>(rhs));
+    });
+
+    std::vector<int> viewRowOf(rows.size());
+    for (size_t i = 0; i < viewOrder.size(); ++i)
+        viewRowOf[static_cast<size_t>(viewOrder[i])] = static_cast<int>(i);
+
+    QModelIndexList newIndexes;
+    newIndexes.reserve(oldIndexes.size());
+    for (int i = 0; i < oldIndexes.size(); ++i)
+        newIndexes.append(index(viewRowOf[static_cast<size_t>(storedRows[static_cast<size_t>(i)])],
+                                oldIndexes.at(i).column()));
+    changePersistentIndexList(oldIndexes, newIndexes);
+
+    emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+void WarningsTableModel::setWarnings(const QSet<QString> &knownPlugins,
+                                     const std::vector<std::pair<QString, QJsonObject>> &details,
+                                     const QJsonArray &generalMessages)
+{
+    beginResetModel();
+
+    rows.clear();
+    viewOrder.clear();
+    pluginNames.clear();
+    pluginIds.clear();
+    typeNames.clear();
+    installedPlugins = knownPlugins;
+
+    for (const auto &[pluginName, detail] : details)
+        appendPluginRows(pluginId(pluginName), detail);
+    appendGeneralRows(pluginId(QString()), generalMessages);
+
+    viewOrder.resize(rows.size());
+    for (size_t i = 0; i < viewOrder.size(); ++i)
+        viewOrder[i] = static_cast<int>(i);
+    std::stable_sort(viewOrder.begin(), viewOrder.end(), [this](int lhs, int rhs) {
+        return lessThan(static_cast<size_t>(lhs), static_cast<size_t>(rhs));
+    });
+
+    endResetModel();
+}
+
+void WarningsTableModel::setPluginWarnings(const QString &pluginName, const QJsonObject &detail)
+{
+    const int plugin = pluginId(pluginName);
+    replaceRows(plugin, [this, plugin, &detail]() { appendPluginRows(plugin, detail); });
+}
+
+void WarningsTableModel::setGeneralMessages(const QJsonArray &messages)
+{
+    const int plugin = pluginId(QString());
+    replaceRows(plugin, [this, plugin, &messages]() { appendGeneralRows(plugin, messages); });
+}
+
+int WarningsTableModel::pluginId(const QString &pluginName)
+{
+    const QString key = pluginName.toLower();
+    auto it = pluginIds.constFind(key);
+    if (it != pluginIds.constEnd())
+        return *it;
+
+    // General messages are filed under an empty plugin name.
+    const int id = static_cast<int>(pluginNames.size());
+    pluginNames.append(pluginName.isEmpty() ? QStringLiteral("General") : pluginName);
+    pluginIds.insert(key, id);
+    return id;
+}
+
+quint16 WarningsTableModel::typeId(const QString &type)
+{
+    qsizetype id = typeNames.indexOf(type);
+    if (id < 0) {
+        id = typeNames.size();
+        typeNames.append(type);
+    }
+    return static_cast<quint16>(id);
+}
+
+void WarningsTableModel::appendPluginRows(int plugin, const QJsonObject &detail)
+{
+    if (detail.isEmpty())
+        return;
+
+    for (const QJsonValue &value : detail.value("messages").toArray()) {
+        QJsonObject obj = value.toObject();
+        append(plugin, obj.value("level").toString("info"), Kind::Message,
+               obj.value("text").toString());
+    }
+
+    if (detail.value("has_user_metadata").toBool())
+        append(plugin, QStringLiteral("User Override"), Kind::UserOverride, QString());
+
+    for (const QJsonValue &value : detail.value("dirty").toArray())
+        append(plugin, QStringLiteral("Dirty"), Kind::Dirty, QString(), value.toObject());
+
+    for (const QJsonValue &value : detail.value("requirements").toArray()) {
+        QString required = value.toObject().value("name").toString();
+        if (required.isEmpty() || installedPlugins.contains(required.toLower()))
+            continue;
+        append(plugin, QStringLiteral("Missing Master"), Kind::MissingMaster, required);
+    }
+}
+
+void WarningsTableModel::appendGeneralRows(int plugin, const QJsonArray &messages)
+{
+    for (const QJsonValue &value : messages) {
+        QJsonObject obj = value.toObject();
+        append(plugin, obj.value("level").toString("info"), Kind::Message,
+               obj.value("text").toString());
+    }
+}
+
+void WarningsTableModel::append(int plugin, const QString &type, Kind kind,
+                                const QString &text, const QJsonObject &dirty)
+{
+    if (kind == Kind::Message && text.isEmpty())
+        return;
+
+    rows.plugin.push_back(plugin);
+    rows.type.push_back(typeId(type));
+    rows.kind.push_back(kind);
+    rows.text.push_back(text);
+    rows.dirty.push_back(dirty);
+}
+
+void WarningsTableModel::replaceRows(int plugin, const std::function<void()> &appendRows)
+{
+    // Drop the plugin's table rows, one contiguous run at a time.
+    for (int end = rowCount() - 1; end >= 0;) {
+        if (rows.plugin[static_cast<size_t>(viewOrder[static_cast<size_t>(end)])] != plugin) {
+            --end;
+            continue;
+        }
+        int start = end;
+        while (start > 0
+               && rows.plugin[static_cast<size_t>(viewOrder[static_cast<size_t>(start - 1)])] == plugin)
+            --start;
+
+        beginRemoveRows(QModelIndex(), start, end);
+        viewOrder.erase(viewOrder.begin() + start, viewOrder.begin() + end + 1);
+        endRemoveRows();
+        end = start - 1;
+    }
+
+    // Compact the stored rows that are no longer shown.
+    std::vector<int> newIndex(rows.size(), -1);
+    Columns kept;
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (rows.plugin[i] == plugin)
+            continue;
+        newIndex[i] = static_cast<int>(kept.size());
+        kept.plugin.push_back(rows.plugin[i]);
+        kept.type.push_back(rows.type[i]);
+        kept.kind.push_back(rows.kind[i]);
+        kept.text.push_back(std::move(rows.text[i]));
+        kept.dirty.push_back(std::move(rows.dirty[i]));
+    }
+    rows = std::move(kept);
+    for (int &row : viewOrder)
+        row = newIndex[static_cast<size_t>(row)];
+
+    // Insert each new row where the current sort order puts it.
+    const size_t firstNew = rows.size();
+    appendRows();
+    for (size_t i = firstNew; i < rows.size(); ++i) {
+        auto position = std::upper_bound(viewOrder.begin(), viewOrder.end(), static_cast<int>(i),
+                                         [this](int lhs, int rhs) {
+                                             return lessThan(static_cast<size_t>(lhs),
+                                                             static_cast<size_t>(rhs));
+                                         });
+        const int viewRow = static_cast<int>(std::distance(viewOrder.begin(), position));
+        beginInsertRows(QModelIndex(), viewRow, viewRow);
+        viewOrder.insert(position, static_cast<int>(i));
+        endInsertRows();
+    }
+}
+
+QString WarningsTableModel::detailText(size_t row) const
+{
+    switch (rows.kind[row]) {
+    case Kind::Message:
+        return rows.text[row];
+    case Kind::UserOverride:
+        return QStringLiteral("User rules are applied to this plugin.");
+    case Kind::MissingMaster:
+        return QStringLiteral("Requires %1, which is not present.").arg(rows.text[row]);
+    case Kind::Dirty: {
+        const QJsonObject &obj = rows.dirty[row];
+        QString summary = QStringLiteral("Utility %1 | CRC %2 | ITM %3 | UDR %4 | NAV %5")
+                              .arg(obj.value("utility").toString())
+                              .arg(obj.value("crc").toString())
+                              .arg(obj.value("itm").toInt())
+                              .arg(obj.value("deleted_references").toInt())
+                              .arg(obj.value("deleted_navmeshes").toInt());
+        QString detail = obj.value("detail").toString();
+        if (!detail.isEmpty())
+            summary += QStringLiteral(" | %1").arg(detail);
+        return summary;
+    }
+    }
+    return QString();
+}
+
+bool WarningsTableModel::lessThan(size_t lhs, size_t rhs) const
+{
+    if (sortOrder == Qt::DescendingOrder)
+        std::swap(lhs, rhs);
+
+    auto comparePlugins = [this](size_t a, size_t b) {
+        return pluginNames.at(rows.plugin[a]).compare(pluginNames.at(rows.plugin[b]), Qt::CaseInsensitive);
+    };
+    auto compareTypes = [this](size_t a, size_t b) {
+        return typeNames.at(rows.type[a]).compare(typeNames.at(rows.type[b]));
+    };
+
+    int compare = 0;
+    switch (sortColumn) {
+    case TypeColumn:
+        compare = compareTypes(lhs, rhs);
+        if (compare == 0)
+            compare = comparePlugins(lhs, rhs);
+        break;
+    case DetailsColumn:
+        // Only this column needs the display text, and only while sorting.
+        compare = detailText(lhs).compare(detailText(rhs), Qt::CaseInsensitive);
+        if (compare == 0)
+            compare = comparePlugins(lhs, rhs);
+        break;
+    default:
+        compare = comparePlugins(lhs, rhs);
+        if (compare == 0)
+            compare = compareTypes(lhs, rhs);
+        break;
+    }
+    return compare < 0;
+}
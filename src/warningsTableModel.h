@@ -0,0 +1,85 @@
+#ifndef WARNINGSTABLEMODEL_H
+#define WARNINGSTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSet>
+#include <QStringList>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// LOOT messages, dirty plugin info and missing masters, one row each.
+//
+// Rows are stored column by column and their display text is only built when
+// a view asks for it. Sorting reorders a vector of row indices, and the rows
+// for one plugin can be replaced without touching the rest of the table.
+class WarningsTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column { PluginColumn, TypeColumn, DetailsColumn, ColumnCount };
+
+    explicit WarningsTableModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    // Lower-cased filenames of the installed plugins, used to find missing
+    // masters. Rows that were already added are not re-checked.
+    const QSet<QString> &knownPlugins() const { return installedPlugins; }
+
+    // Replaces every row. details pairs each plugin filename with the JSON
+    // object from LootManager::pluginDetails().
+    void setWarnings(const QSet<QString> &knownPlugins,
+                     const std::vector<std::pair<QString, QJsonObject>> &details,
+                     const QJsonArray &generalMessages);
+
+    // Replaces only the rows for the given plugin, or for general messages.
+    void setPluginWarnings(const QString &pluginName, const QJsonObject &detail);
+    void setGeneralMessages(const QJsonArray &messages);
+
+private:
+    enum class Kind : quint8 { Message, UserOverride, Dirty, MissingMaster };
+
+    // Each column holds one value per stored row. Rows are stored in the
+    // order they were added, viewOrder maps table rows onto them.
+    struct Columns {
+        std::vector<int> plugin;         // index into pluginNames
+        std::vector<quint16> type;       // index into typeNames
+        std::vector<Kind> kind;
+        std::vector<QString> text;       // message text or missing master name
+        std::vector<QJsonObject> dirty;  // cleaning data for Kind::Dirty rows
+
+        size_t size() const { return plugin.size(); }
+        void clear();
+    };
+
+    int pluginId(const QString &pluginName);
+    quint16 typeId(const QString &type);
+    void appendPluginRows(int plugin, const QJsonObject &detail);
+    void appendGeneralRows(int plugin, const QJsonArray &messages);
+    void append(int plugin, const QString &type, Kind kind,
+                const QString &text, const QJsonObject &dirty = QJsonObject());
+    void replaceRows(int plugin, const std::function<void()> &appendRows);
+    QString detailText(size_t row) const;
+    bool lessThan(size_t lhs, size_t rhs) const;
+
+    Columns rows;
+    std::vector<int> viewOrder;
+    QStringList pluginNames;
+    QHash<QString, int> pluginIds;  // keyed by lower-cased filename
+    QStringList typeNames;
+    QSet<QString> installedPlugins;
+    int sortColumn = PluginColumn;
+    Qt::SortOrder sortOrder = Qt::AscendingOrder;
+};
+
+#endif // WARNINGSTABLEMODEL_H
@@ -0,0 +1,150 @@
+#include "workspaceSnapshot.h"
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonValue>
+#include <QSaveFile>
+#include <utility>
+
+namespace {
+constexpr int SnapshotVersion = 1;
+
+QJsonObject pluginToJson(const PluginInfo &plugin)
+{
+    QJsonObject obj;
+    obj.insert("file", QString::fromStdString(plugin.filename));
+    // Usually the same as the filename, see PluginInfo::syncName().
+    if (plugin.name != plugin.filename)
+        obj.insert("name", QString::fromStdString(plugin.name));
+    obj.insert("type", QString::fromStdString(plugin.type));
+    if (!plugin.masters.empty()) {
+        QJsonArray masters;
+        for (const std::string &master : plugin.masters)
+            masters.append(QString::fromStdString(master));
+        obj.insert("masters", masters);
+    }
+    return obj;
+}
+
+PluginInfo pluginFromJson(const QJsonObject &obj)
+{
+    PluginInfo plugin;
+    plugin.filename = obj.value("file").toString().toStdString();
+    plugin.name = obj.value("name").toString().toStdString();
+    plugin.type = obj.value("type").toString().toStdString();
+    for (const QJsonValue &master : obj.value("masters").toArray())
+        plugin.masters.push_back(master.toString().toStdString());
+    plugin.syncName();
+    return plugin;
+}
+
+QJsonObject modToJson(const ModRecord &record)
+{
+    QJsonObject obj;
+    obj.insert("id", record.id);
+    obj.insert("name", record.name);
+    obj.insert("enabled", record.enabled);
+    if (record.type == ModType::ToolMod) {
+        obj.insert("tool", true);
+        obj.insert("launcherPath", record.launcherPath);
+        obj.insert("launcherArgs", record.launcherArgs);
+    }
+    return obj;
+}
+
+ModRecord modFromJson(const QJsonObject &obj)
+{
+    ModRecord record;
+    record.id = obj.value("id").toString();
+    record.name = obj.value("name").toString();
+    record.enabled = obj.value("enabled").toBool(true);
+    if (obj.value("tool").toBool()) {
+        record.type = ModType::ToolMod;
+        record.launcherPath = obj.value("launcherPath").toString();
+        record.launcherArgs = obj.value("launcherArgs").toString();
+    }
+    return record;
+}
+}
+
+bool WorkspaceSnapshot::load(const QString &path, WorkspaceSnapshot *out)
+{
+    if (!out || path.isEmpty())
+        return false;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+        qWarning() << "[Snapshot] Ignoring unreadable workspace snapshot" << path;
+        return false;
+    }
+
+    const QJsonObject root = doc.object();
+    if (root.value("version").toInt() != SnapshotVersion)
+        return false;
+
+    WorkspaceSnapshot snapshot;
+    snapshot.dataPath = root.value("dataPath").toString();
+
+    const QJsonArray plugins = root.value("plugins").toArray();
+    snapshot.plugins.reserve(static_cast<size_t>(plugins.size()));
+    for (const QJsonValue &value : plugins)
+        snapshot.plugins.push_back(pluginFromJson(value.toObject()));
+
+    for (const QJsonValue &value : root.value("mods").toArray())
+        snapshot.mods.append(modFromJson(value.toObject()));
+
+    const QJsonObject details = root.value("details").toObject();
+    snapshot.pluginDetails.reserve(details.size());
+    for (auto it = details.constBegin(); it != details.constEnd(); ++it)
+        snapshot.pluginDetails.insert(it.key(), it.value().toObject());
+
+    snapshot.generalMessages = root.value("generalMessages").toArray();
+    for (const QJsonValue &value : root.value("sortOrder").toArray())
+        snapshot.sortOrder.append(value.toString());
+
+    *out = std::move(snapshot);
+    return true;
+}
+
+bool WorkspaceSnapshot::save(const QString &path) const
+{
+    if (path.isEmpty())
+        return false;
+
+    QJsonArray pluginArray;
+    for (const PluginInfo &plugin : plugins)
+        pluginArray.append(pluginToJson(plugin));
+
+    QJsonArray modArray;
+    for (const ModRecord &record : mods)
+        modArray.append(modToJson(record));
+
+    QJsonObject detailObject;
+    for (auto it = pluginDetails.constBegin(); it != pluginDetails.constEnd(); ++it)
+        detailObject.insert(it.key(), it.value());
+
+    QJsonObject root;
+    root.insert("version", SnapshotVersion);
+    root.insert("dataPath", dataPath);
+    root.insert("plugins", pluginArray);
+    root.insert("mods", modArray);
+    root.insert("details", detailObject);
+    root.insert("generalMessages", generalMessages);
+    root.insert("sortOrder", QJsonArray::fromStringList(sortOrder));
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[Snapshot] Unable to write workspace snapshot" << path;
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return file.commit();
+}
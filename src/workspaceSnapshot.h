@@ -0,0 +1,36 @@
+#ifndef WORKSPACESNAPSHOT_H
+#define WORKSPACESNAPSHOT_H
+
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <vector>
+#include "modManager.h"
+#include "pluginManager.h"
+
+// What the main window showed when it was last closed. The next start shows
+// this straight away, then replaces whatever the background rescan and LOOT
+// reload find to be different.
+struct WorkspaceSnapshot {
+    // The plugin and LOOT parts only apply to this data folder.
+    QString dataPath;
+    // In the order they were shown.
+    std::vector<PluginInfo> plugins;
+    // Only the fields the mod list and tool launchers use.
+    QVector<ModRecord> mods;
+    // LOOT details keyed by lower-cased plugin filename, which the warnings
+    // table rows are built from.
+    QHash<QString, QJsonObject> pluginDetails;
+    QJsonArray generalMessages;
+    // Plugin filenames from the last LOOT sort.
+    QStringList sortOrder;
+
+    // Returns false if there is no snapshot or it can't be used.
+    static bool load(const QString &path, WorkspaceSnapshot *out);
+    bool save(const QString &path) const;
+};
+
+#endif // WORKSPACESNAPSHOT_H
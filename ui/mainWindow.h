@@ -4,6 +4,7 @@
 #include <QtWidgets/QMainWindow>
 #include <QStackedWidget>
 #include <QListWidget>
+#include <QListView>
 #include <QTabWidget>
 #include <QPushButton>
 #include <QTreeView>
@@ -11,9 +12,11 @@
 #include <QPlainTextEdit>
 #include <QTextBrowser>
 #include <QLabel>
-#include <QTableWidget>
+#include <QTableView>
 #include <QVariantAnimation>
 #include <QTimer>
+#include <QElapsedTimer>
+#include <QProgressBar>
 #include <QPixmap>
 #include "iniEditorWidget.h"
 #include <QComboBox>
@@ -21,10 +24,17 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QHash>
+#include <QMap>
+#include <QSet>
 #include <array>
+#include <functional>
 #include <memory>
 #include <vector>
 #include "pluginManager.h"
+#include "pluginListModel.h"
+#include "warningsTableModel.h"
+#include "jobScheduler.h"
+#include "workspaceSnapshot.h"
 #include "../loot-shim/include/loot_shim.h"
 #include "modManager.h"
 
@@ -33,6 +43,8 @@ namespace Ui { class MainWindow; }
 QT_END_NAMESPACE
 
 class LootManager;
+class StallWatchdog;
+class DiagnosticsPanel;
 
 class MainWindow : public QMainWindow
 {
@@ -47,6 +59,7 @@ private slots:
     void onSortPluginsClicked();   // Trigger LOOT sort routine (placeholder)
     void onInstallArchivesRequested(const QStringList &archives);
     void onModItemChanged(QListWidgetItem *item);
+    void applyPendingModChanges();
     void onRemoveModClicked();
     void onRunToolChanged(int index);
     void onRunButtonClicked();
@@ -68,6 +81,22 @@ private:
 
     enum class ToolEntryType { Game, Tool };
 
+    // Which plugins a LOOT metadata reload fetches details for.
+    enum class MetadataScope {
+        AllPlugins,
+        // Only those in metadataRefreshScope, unless the masterlist or
+        // userlist changed since the last reload.
+        ChangedPlugins
+    };
+
+    // How long mod checkbox changes are collected before being applied.
+    static constexpr int ModChangeDebounceMs = 200;
+
+    // Startup time budget: the window should be up within the first and
+    // every background startup stage done within the second.
+    static constexpr qint64 StartupShownBudgetMs = 500;
+    static constexpr qint64 StartupReadyBudgetMs = 5000;
+
     struct ToolEntry {
         QString id;
         QString label;
@@ -84,7 +113,7 @@ private:
     QStackedWidget* rightStack;
 
     // LOOT mode UI pieces
-    QListWidget* lootPluginList;
+    QListView* lootPluginList = nullptr;
     QTabWidget* lootTaskTabs = nullptr;
     QPushButton* sortPluginsButton = nullptr;
     QPushButton* removeModButton = nullptr;
@@ -99,9 +128,47 @@ private:
     QPushButton* updateMasterlistButton = nullptr;
     QPushButton* editUserRulesButton = nullptr;
     QPushButton* resetUserlistButton = nullptr;
-    QTableWidget* lootWarningsTable = nullptr;
+    QTableView* lootWarningsTable = nullptr;
+    WarningsTableModel* warningsModel = nullptr;
     QComboBox* runToolCombo = nullptr;
     IniEditorWidget* iniEditor = nullptr;
+    // Reports GUI-thread stalls to the Diagnostics tab.
+    StallWatchdog* stallWatchdog = nullptr;
+    DiagnosticsPanel* diagnosticsPanel = nullptr;
+    QLabel* jobStatusLabel = nullptr;
+    QProgressBar* jobProgressBar = nullptr;
+
+    // Slow operations run here. Jobs that use modManager hold the "mods"
+    // resource and jobs that use lootManager hold the "loot" resource.
+    JobScheduler* jobs = nullptr;
+
+    // Mod enable states waiting for modChangeTimer to apply them in one job,
+    // holding each mod's last change in the order the changes were made.
+    ModManager::ModStates pendingModStates;
+    QTimer* modChangeTimer = nullptr;
+    // Batches handed to mod jobs, by batch number, until the job finishes.
+    // A cancelled job may never have applied its batch, so
+    // applyModChangesNow() applies the ones whose applied flag is unset.
+    struct QueuedModBatch {
+        ModManager::ModStates states;
+        std::shared_ptr<bool> applied;
+    };
+    QMap<quint64, QueuedModBatch> queuedModStates;
+    quint64 nextModBatch = 1;
+    // Lower-cased plugin names a pending ChangedPlugins reload will refetch,
+    // and whether a pending reload needs every plugin.
+    QSet<QString> metadataRefreshScope;
+    bool metadataRefreshAll = false;
+    // LootManager::metadataGeneration() when lootPluginDetailsCache was filled.
+    quint64 lootMetadataGeneration = 0;
+
+    // Measures startup from the start of the constructor. startupStageMs is
+    // when the last startup stage on the GUI thread ended. Startup is over
+    // once the deferred stages have run and the scheduler is idle.
+    QElapsedTimer startupClock;
+    qint64 startupStageMs = 0;
+    bool startupInProgress = true;
+    bool deferredStartupDone = false;
 
     QString dataPath;
     QString installPath;
@@ -109,7 +176,10 @@ private:
     QFileSystemModel* dataModel = nullptr;
     QTreeView* modDataView = nullptr;
     QTreeView* lootDataView = nullptr;
-    std::vector<PluginInfo> cachedPlugins;
+    // Scanned plugins in load order, shared by the mod and LOOT plugin lists.
+    PluginListModel* pluginModel = nullptr;
+    PluginListProxyModel* modPluginProxy = nullptr;
+    PluginListProxyModel* lootPluginProxy = nullptr;
     std::unique_ptr<LootManager> lootManager;
     std::array<TabIconState, 2> modeIconStates;
     std::unique_ptr<ModManager> modManager;
@@ -117,6 +187,13 @@ private:
     QString selectedToolId;
     QHash<QString, QJsonObject> lootPluginDetailsCache;
     QJsonArray lootGeneralMessages;
+    // Plugin filenames from the last LOOT sort. Rescanned plugins are shown
+    // in this order.
+    QStringList lastSortOrder;
+    // The mod list from the workspace snapshot, shown until modManager has
+    // read its registry in the background (modsLoaded).
+    QVector<ModRecord> restoredMods;
+    bool modsLoaded = false;
 
     QString workspacePath;
     QString downloadsPath;
@@ -129,9 +206,22 @@ private:
     void saveDataPath(const QString &path);
     void saveConfigPaths() const;
     bool loadWorkspaceConfig();
-    void initializeModManager();
+    JobScheduler::JobId initializeModManager();
+    void startBackgroundStages();
+    void runDeferredStartup();
+    void markStartupStage(const QString &stage);
+    void finishStartup();
     void refreshModsList();
-    void rescanVirtualPlugins();
+    const QVector<ModRecord> &displayedMods() const;
+    void waitForModDeployment(JobScheduler::Job &job) const;
+    void applyModChangesNow();
+    QString workspaceSnapshotPath() const;
+    void restoreWorkspaceSnapshot();
+    void saveWorkspaceSnapshot() const;
+    JobScheduler::JobId scheduleModOperation(const QString &key, const QString &description,
+                                             std::function<bool(QString *)> operation);
+    JobScheduler::JobId rescanVirtualPlugins(const QList<JobScheduler::JobId> &after = {},
+                                             MetadataScope scope = MetadataScope::AllPlugins);
     void updateToolLaunchers();
     void updateIniEditorSources();
     QString defaultGameExecutable() const;
@@ -144,15 +234,20 @@ private:
                                const QString &steamRoot,
                                const QString &compatPath);
     void setupStyle();
-    void populatePluginList(const std::vector<PluginInfo> &plugins);
+    void populatePluginList(std::vector<PluginInfo> plugins);
+    int currentLootPluginRow() const;
+    void applyPluginOrder(const QStringList &sortedNames);
     void setupDataViews();
     void refreshDataRoots();
     LootGameType determineGameType(const QString &dataDir);
     void updateModeTabIcons();
     void recreateLootManager();
+    QStringList lootPluginPaths() const;
     void displayLootMetadata(int index);
     void appendLootReport(const QString &line);
-    void reloadLootMetadata();
+    JobScheduler::JobId reloadLootMetadata(const QList<JobScheduler::JobId> &after = {},
+                                           MetadataScope scope = MetadataScope::AllPlugins);
+    void setupJobStatus();
     void refreshMasterlistInfoLabels();
     QString masterlistRepoUrl() const;
     QString masterlistDirectory() const;
@@ -161,10 +256,14 @@ private:
     QString userlistPathForActiveGame() const;
     QString lootGameSlug() const;
     void ensureLootDataFolders() const;
-    bool runGitCommand(const QStringList &args, const QString &workingDir, const QString &description);
+    JobScheduler::JobId scheduleGitCommand(const QStringList &args, const QString &workingDir,
+                                           const QString &description,
+                                           std::function<void()> onSuccess);
     QString runGitForOutput(const QStringList &args, const QString &workingDir) const;
     QString normalizedPluginKey(const QString &name) const;
     void rebuildWarningsTable();
+    void refreshWarningsTable(const QHash<QString, QJsonObject> &previousDetails,
+                              const QJsonArray &previousGeneralMessages);
     QString buildPluginMetadataHtml(const PluginInfo &plugin) const;
     IconAnimationType animationTypeForPath(const QString &path) const;
     QString currentGlowColor() const;